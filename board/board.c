@@ -68,3 +68,17 @@ void phy_reset(void)
 	rt_thread_delay(RT_TICK_PER_SECOND / 10);
 #endif
 }
+
+#ifdef BSP_USING_CCM_HEAP
+static struct rt_memheap _ccm_heap;
+
+static int rt_hw_ccm_heap_init(void)
+{
+    /* the CCM RAM is not accessible by DMA */
+    rt_memheap_init(&_ccm_heap, "ccm", STM32_CCM_BEGIN, STM32_CCM_SIZE * 1024);
+    rt_memheap_set_class(&_ccm_heap, RT_MEMHEAP_CLASS_FAST);
+
+    return 0;
+}
+INIT_BOARD_EXPORT(rt_hw_ccm_heap_init);
+#endif
@@ -40,6 +40,9 @@ extern int __bss_end;
 
 #define HEAP_END        STM32_SRAM_END
 
+#define STM32_CCM_BEGIN           ((void *)0x10000000)
+#define STM32_CCM_SIZE            64
+
 void SystemClock_Config(void);
 
 #ifdef __cplusplus
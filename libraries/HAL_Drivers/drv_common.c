@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-7      SummerGift   first version
+ * 2026-10-17     RT-Thread    fix the reload of SysTick in tickless sleep
+ * 2026-10-17     RT-Thread    move the tickless sleep to drv_tickless.c
  */
 
 #include "drv_common.h"
@@ -27,12 +29,25 @@ FINSH_FUNCTION_EXPORT_ALIAS(reboot, __cmd_reboot, Reboot System);
 /* SysTick configuration */
 void rt_hw_systick_init(void)
 {
+#ifdef RT_USING_TICKLESS
+    rt_uint32_t systick_cycles_per_tick;
+
+    /* use HCLK/8 to let the 24 bits SysTick cover more sleeping ticks */
+#if defined (SOC_SERIES_STM32H7)
+    systick_cycles_per_tick = HAL_RCCEx_GetD1SysClockFreq() / 8 / RT_TICK_PER_SECOND;
+#else
+    systick_cycles_per_tick = HAL_RCC_GetHCLKFreq() / 8 / RT_TICK_PER_SECOND;
+#endif
+    HAL_SYSTICK_Config(systick_cycles_per_tick);
+    HAL_SYSTICK_CLKSourceConfig(SYSTICK_CLKSOURCE_HCLK_DIV8);
+#else
 #if defined (SOC_SERIES_STM32H7)
     HAL_SYSTICK_Config((HAL_RCCEx_GetD1SysClockFreq()) / RT_TICK_PER_SECOND);
 #else
     HAL_SYSTICK_Config(HAL_RCC_GetHCLKFreq() / RT_TICK_PER_SECOND);
 #endif
     HAL_SYSTICK_CLKSourceConfig(SYSTICK_CLKSOURCE_HCLK);
+#endif
     HAL_NVIC_SetPriority(SysTick_IRQn, 0, 0);
 }
 
@@ -101,7 +116,11 @@ void rt_hw_us_delay(rt_uint32_t us)
     rt_uint32_t start, now, delta, reload, us_tick;
     start = SysTick->VAL;
     reload = SysTick->LOAD;
+#ifdef RT_USING_TICKLESS
+    us_tick = SystemCoreClock / 8 / 1000000UL;
+#else
     us_tick = SystemCoreClock / 1000000UL;
+#endif
     do {
         now = SysTick->VAL;
         delta = start > now ? start - now : reload + start - now;
@@ -227,7 +227,8 @@ static rt_err_t timer_start(rt_hwtimer_t *timer, rt_uint32_t t, rt_hwtimer_mode_
 
     tim = (TIM_HandleTypeDef *)timer->parent.user_data;
 
-    /* set tim cnt */
+    /* set tim cnt, and count from 0 as the timer may be stopped in counting */
+    __HAL_TIM_SET_COUNTER(tim, 0);
     __HAL_TIM_SET_AUTORELOAD(tim, t);
 
     if (opmode == HWTIMER_MODE_ONESHOT)
@@ -235,6 +236,10 @@ static rt_err_t timer_start(rt_hwtimer_t *timer, rt_uint32_t t, rt_hwtimer_mode_
         /* set timer to single mode */
         tim->Instance->CR1 |= TIM_OPMODE_SINGLE;
     }
+    else
+    {
+        tim->Instance->CR1 &= ~TIM_OPMODE_SINGLE;
+    }
 
     /* start timer */
     if (HAL_TIM_Base_Start_IT(tim) != HAL_OK)
@@ -8,6 +8,7 @@
  * 2018-11-5      SummerGift   first version
  * 2018-12-11     greedyhao    Porting for stm32f7xx
  * 2019-01-03     zylx         modify DMA initialization and spixfer function
+ * 2026-10-17     RT-Thread    add xfer_start for asynchronous message queue
  */
 
 #include "board.h"
@@ -357,6 +358,121 @@ static rt_uint32_t spixfer(struct rt_spi_device *device, struct rt_spi_message *
     return message->length;
 }
 
+#ifdef RT_USING_SPI_ASYNC
+static rt_err_t spi_xfer_start(struct rt_spi_device *device, struct rt_spi_message *message)
+{
+    HAL_StatusTypeDef state;
+
+    RT_ASSERT(device != RT_NULL);
+    RT_ASSERT(device->bus != RT_NULL);
+    RT_ASSERT(device->bus->parent.user_data != RT_NULL);
+    RT_ASSERT(message != RT_NULL);
+
+    struct stm32_spi *spi_drv =  rt_container_of(device->bus, struct stm32_spi, spi_bus);
+    SPI_HandleTypeDef *spi_handle = &spi_drv->handle;
+    struct stm32_hw_spi_cs *cs = device->parent.user_data;
+
+    /* the message without DMA is transferred by spixfer */
+    if (message->length == 0 || message->length > 65535)
+    {
+        return -RT_ENOSYS;
+    }
+    if (message->send_buf && message->recv_buf)
+    {
+        if ((spi_drv->spi_dma_flag & (SPI_USING_TX_DMA_FLAG | SPI_USING_RX_DMA_FLAG)) !=
+                (SPI_USING_TX_DMA_FLAG | SPI_USING_RX_DMA_FLAG))
+            return -RT_ENOSYS;
+    }
+    else if (message->send_buf)
+    {
+        if (!(spi_drv->spi_dma_flag & SPI_USING_TX_DMA_FLAG))
+            return -RT_ENOSYS;
+    }
+    else if (!(spi_drv->spi_dma_flag & SPI_USING_RX_DMA_FLAG))
+    {
+        return -RT_ENOSYS;
+    }
+
+    if (message->cs_take)
+    {
+        HAL_GPIO_WritePin(cs->GPIOx, cs->GPIO_Pin, GPIO_PIN_RESET);
+    }
+
+    /* it's done in the completion callback of HAL */
+    spi_drv->async_message = message;
+    spi_drv->async_cs = cs;
+
+    if (message->send_buf && message->recv_buf)
+    {
+        state = HAL_SPI_TransmitReceive_DMA(spi_handle, (uint8_t *)message->send_buf, (uint8_t *)message->recv_buf, message->length);
+    }
+    else if (message->send_buf)
+    {
+        state = HAL_SPI_Transmit_DMA(spi_handle, (uint8_t *)message->send_buf, message->length);
+    }
+    else
+    {
+        memset((uint8_t *)message->recv_buf, 0xff, message->length);
+        state = HAL_SPI_Receive_DMA(spi_handle, (uint8_t *)message->recv_buf, message->length);
+    }
+
+    if (state != HAL_OK)
+    {
+        LOG_I("spi transfer error : %d", state);
+        spi_drv->async_message = RT_NULL;
+        spi_handle->State = HAL_SPI_STATE_READY;
+        if (message->cs_take)
+        {
+            HAL_GPIO_WritePin(cs->GPIOx, cs->GPIO_Pin, GPIO_PIN_SET);
+        }
+
+        return -RT_EIO;
+    }
+
+    return RT_EOK;
+}
+
+static void spi_xfer_done(SPI_HandleTypeDef *hspi, rt_err_t result)
+{
+    struct stm32_spi *spi_drv =  rt_container_of(hspi, struct stm32_spi, handle);
+    struct rt_spi_message *message = spi_drv->async_message;
+
+    /* the transfer is started by spixfer */
+    if (message == RT_NULL)
+    {
+        return;
+    }
+    spi_drv->async_message = RT_NULL;
+
+    if (message->cs_release || result != RT_EOK)
+    {
+        HAL_GPIO_WritePin(spi_drv->async_cs->GPIOx, spi_drv->async_cs->GPIO_Pin, GPIO_PIN_SET);
+    }
+
+    rt_spi_bus_xfer_done(&spi_drv->spi_bus, result);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_xfer_done(hspi, RT_EOK);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_xfer_done(hspi, RT_EOK);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_xfer_done(hspi, RT_EOK);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_xfer_done(hspi, -RT_EIO);
+}
+#endif /* RT_USING_SPI_ASYNC */
+
 static rt_err_t spi_configure(struct rt_spi_device *device,
                               struct rt_spi_configuration *configuration)
 {
@@ -373,6 +489,9 @@ static const struct rt_spi_ops stm_spi_ops =
 {
     .configure = spi_configure,
     .xfer = spixfer,
+#ifdef RT_USING_SPI_ASYNC
+    .xfer_start = spi_xfer_start,
+#endif
 };
 
 static int rt_hw_spi_bus_init(void)
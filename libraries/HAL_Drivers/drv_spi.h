@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-5      SummerGift   first version
+ * 2026-10-17     RT-Thread    add the message of asynchronous transfer
  */
 
 #ifndef __DRV_SPI_H_
@@ -57,6 +58,11 @@ struct stm32_spi
     
     rt_uint8_t spi_dma_flag;
     struct rt_spi_bus spi_bus;
+
+#ifdef RT_USING_SPI_ASYNC
+    struct rt_spi_message *async_message;       /* the message started by xfer_start */
+    struct stm32_hw_spi_cs *async_cs;
+#endif
 };
 
 #endif /*__DRV_SPI_H_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <board.h>
+#include <rthw.h>
+
+#ifdef RT_USING_TICKLESS
+
+/**
+ * This function will stop the periodic SysTick and sleep for timeout_tick
+ * ticks at most. It's invoked by idle thread with interrupt disabled.
+ *
+ * It only accesses the SysTick and SCB registers of CMSIS, the SysTick runs
+ * with the period of one OS tick (LOAD + 1 counts) out of sleeping.
+ *
+ * @param timeout_tick the ticks to the next timer timeout
+ *
+ * @return the complete ticks passed in sleeping, not including the one which
+ *         will be counted by the pending SysTick interrupt.
+ */
+rt_tick_t rt_hw_tickless_sleep(rt_tick_t timeout_tick)
+{
+    rt_uint32_t ctrl, reload, remain, max_tick, cycles_per_tick;
+    rt_tick_t complete_tick;
+
+    cycles_per_tick = SysTick->LOAD + 1;
+    max_tick = SysTick_LOAD_RELOAD_Msk / cycles_per_tick;
+    if (timeout_tick > max_tick)
+        timeout_tick = max_tick;
+
+    /* stop SysTick, the counts in current tick will be included in reload */
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    reload = SysTick->VAL;
+    /* the VAL is 0 after the tick interrupt until the LOAD is taken */
+    if (reload == 0)
+        reload = cycles_per_tick;
+    reload += cycles_per_tick * (timeout_tick - 1);
+
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /* a tick is pending, go on with the periodic tick */
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        return 0;
+    }
+
+    /* the period of SysTick is LOAD + 1 */
+    SysTick->LOAD = reload - 1;
+    SysTick->VAL  = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    /* wait for the SysTick or any other interrupt */
+    __DSB();
+    __WFI();
+    __ISB();
+
+    /* the COUNTFLAG is cleared by reading, so read the CTRL only once */
+    ctrl = SysTick->CTRL;
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+    /* if it's woken up by SysTick, the pending interrupt will count the last tick */
+    complete_tick = rt_hw_tickless_compensate(cycles_per_tick, timeout_tick, reload, SysTick->VAL,
+                                              (ctrl & SysTick_CTRL_COUNTFLAG_Msk) ? RT_TRUE : RT_FALSE, &remain);
+
+    /* finish the current tick, then restore the periodic tick */
+    SysTick->LOAD = remain - 1;
+    SysTick->VAL  = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    /* SysTick runs on HCLK/8, the LOAD is taken on the next count after VAL is cleared */
+    while (SysTick->VAL == 0);
+    SysTick->LOAD = cycles_per_tick - 1;
+
+    return complete_tick;
+}
+
+#endif /* RT_USING_TICKLESS */
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-10-30     SummerGift   first version
+ * 2026-10-17     RT-Thread    add rx frame mode
  */
 
 #include "board.h"
@@ -141,6 +142,49 @@ static rt_err_t stm32_configure(struct rt_serial_device *serial, struct serial_c
     return RT_EOK;
 }
 
+#ifdef RT_SERIAL_USING_FRAME
+/*
+ * The frame is delimited by the receiver timeout of the gap bits if UART
+ * supports it, otherwise by the idle line.
+ */
+static void stm32_frame_config(struct stm32_uart *uart, rt_uint32_t gap_bits)
+{
+#if defined(USART_CR2_RTOEN) && defined(IS_UART_RECEIVER_TIMEOUT_INSTANCE)
+    CLEAR_BIT(uart->handle.Instance->CR1, USART_CR1_RTOIE);
+    CLEAR_BIT(uart->handle.Instance->CR2, USART_CR2_RTOEN);
+#endif
+    uart->frame_gap = 0;
+
+    if (gap_bits == 0)
+    {
+        /* the idle line is used by DMA rx */
+        if (!(uart->serial.parent.open_flag & RT_DEVICE_FLAG_DMA_RX))
+        {
+            __HAL_UART_DISABLE_IT(&(uart->handle), UART_IT_IDLE);
+        }
+        return;
+    }
+
+#if defined(USART_CR2_RTOEN) && defined(IS_UART_RECEIVER_TIMEOUT_INSTANCE)
+    if (IS_UART_RECEIVER_TIMEOUT_INSTANCE(uart->handle.Instance) && gap_bits <= USART_RTOR_RTO)
+    {
+        MODIFY_REG(uart->handle.Instance->RTOR, USART_RTOR_RTO, gap_bits);
+        SET_BIT(uart->handle.Instance->CR2, USART_CR2_RTOEN);
+        SET_BIT(uart->handle.Instance->CR1, USART_CR1_RTOIE);
+        if (!(uart->serial.parent.open_flag & RT_DEVICE_FLAG_DMA_RX))
+        {
+            __HAL_UART_DISABLE_IT(&(uart->handle), UART_IT_IDLE);
+        }
+        uart->frame_gap = gap_bits;
+        return;
+    }
+#endif
+
+    __HAL_UART_CLEAR_IDLEFLAG(&uart->handle);
+    __HAL_UART_ENABLE_IT(&(uart->handle), UART_IT_IDLE);
+}
+#endif /* RT_SERIAL_USING_FRAME */
+
 static rt_err_t stm32_control(struct rt_serial_device *serial, int cmd, void *arg)
 {
     struct stm32_uart *uart;
@@ -173,6 +217,11 @@ static rt_err_t stm32_control(struct rt_serial_device *serial, int cmd, void *ar
     case RT_DEVICE_CTRL_CONFIG:
         stm32_dma_config(serial, ctrl_arg);
         break;
+#endif
+#ifdef RT_SERIAL_USING_FRAME
+    case RT_SERIAL_CTRL_SET_FRAME_GAP:
+        stm32_frame_config(uart, (rt_uint32_t)(rt_ubase_t)arg);
+        break;
 #endif
     }
     return RT_EOK;
@@ -251,6 +300,27 @@ static const struct rt_uart_ops stm32_uart_ops =
     .dma_transmit = stm32_dma_transmit
 };
 
+#ifdef RT_SERIAL_USING_DMA
+/* update the data received by DMA since last update */
+static void uart_dma_rx_update(struct rt_serial_device *serial)
+{
+    struct stm32_uart *uart = (struct stm32_uart *) serial->parent.user_data;
+    rt_size_t recv_total_index, recv_len;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    recv_total_index = serial->config.bufsz - __HAL_DMA_GET_COUNTER(&(uart->dma_rx.handle));
+    recv_len = recv_total_index - uart->dma_rx.last_index;
+    uart->dma_rx.last_index = recv_total_index;
+    rt_hw_interrupt_enable(level);
+
+    if (recv_len)
+    {
+        rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_DMADONE | (recv_len << 8));
+    }
+}
+#endif
+
 /**
  * Uart common interrupt process. This need add to uart ISR.
  *
@@ -259,10 +329,6 @@ static const struct rt_uart_ops stm32_uart_ops =
 static void uart_isr(struct rt_serial_device *serial)
 {
     struct stm32_uart *uart;
-#ifdef RT_SERIAL_USING_DMA
-    rt_size_t recv_total_index, recv_len;
-    rt_base_t level;
-#endif
 
     RT_ASSERT(serial != RT_NULL);
 
@@ -276,21 +342,43 @@ static void uart_isr(struct rt_serial_device *serial)
         rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IND);
     }
 #ifdef RT_SERIAL_USING_DMA
-    else if ((uart->uart_dma_flag) && (__HAL_UART_GET_FLAG(&(uart->handle), UART_FLAG_IDLE) != RESET)
+    else if ((uart->uart_dma_flag) && (serial->parent.open_flag & RT_DEVICE_FLAG_DMA_RX)
+             && (__HAL_UART_GET_FLAG(&(uart->handle), UART_FLAG_IDLE) != RESET)
              && (__HAL_UART_GET_IT_SOURCE(&(uart->handle), UART_IT_IDLE) != RESET))
     {
-        level = rt_hw_interrupt_disable();
-        recv_total_index = serial->config.bufsz - __HAL_DMA_GET_COUNTER(&(uart->dma_rx.handle));
-        recv_len = recv_total_index - uart->dma_rx.last_index;
-        uart->dma_rx.last_index = recv_total_index;
-        rt_hw_interrupt_enable(level);
-
-        if (recv_len)
+        uart_dma_rx_update(serial);
+        __HAL_UART_CLEAR_IDLEFLAG(&uart->handle);
+#ifdef RT_SERIAL_USING_FRAME
+        if (uart->frame_gap == 0)
         {
-            rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_DMADONE | (recv_len << 8));
+            rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IDLE);
         }
+#endif
+    }
+#endif
+#ifdef RT_SERIAL_USING_FRAME
+    else if ((__HAL_UART_GET_FLAG(&(uart->handle), UART_FLAG_IDLE) != RESET)
+             && (__HAL_UART_GET_IT_SOURCE(&(uart->handle), UART_IT_IDLE) != RESET))
+    {
+        /* the idle line in interrupt rx mode */
         __HAL_UART_CLEAR_IDLEFLAG(&uart->handle);
+        rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IDLE);
+    }
+#if defined(USART_CR2_RTOEN) && defined(IS_UART_RECEIVER_TIMEOUT_INSTANCE)
+    else if ((uart->frame_gap) && (READ_BIT(uart->handle.Instance->ISR, USART_ISR_RTOF) != RESET))
+    {
+        WRITE_REG(uart->handle.Instance->ICR, USART_ICR_RTOCF);
+#ifdef RT_SERIAL_USING_DMA
+        if (serial->parent.open_flag & RT_DEVICE_FLAG_DMA_RX)
+        {
+            uart_dma_rx_update(serial);
+        }
+#endif
+        rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_TIMEOUT);
     }
+#endif
+#endif /* RT_SERIAL_USING_FRAME */
+#ifdef RT_SERIAL_USING_DMA
     else if (__HAL_UART_GET_FLAG(&(uart->handle), UART_FLAG_TC) != RESET)
     {
         if ((serial->parent.open_flag & RT_DEVICE_FLAG_DMA_TX) != 0)
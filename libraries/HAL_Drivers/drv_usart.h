@@ -62,6 +62,9 @@ struct stm32_uart
     } dma_tx;
 #endif
     rt_uint16_t uart_dma_flag;
+#ifdef RT_SERIAL_USING_FRAME
+    rt_uint32_t frame_gap;      /* the bits of receiver timeout, 0 for the idle line */
+#endif
     struct rt_serial_device serial;
 };
 
@@ -72,6 +72,14 @@ typedef struct _modbus_rtu {
 #endif
     /* To handle many slaves on the same link */
     int confirmation_to_ignore;
+#ifdef RT_SERIAL_USING_FRAME
+    /* The frame read whole from the device in frame mode, the message is
+       parsed from it step by step */
+    rt_device_t frame_dev;
+    uint8_t frame[MODBUS_RTU_MAX_ADU_LENGTH];
+    int frame_length;
+    int frame_pos;
+#endif
 } modbus_rtu_t;
 
 #endif /* MODBUS_RTU_PRIVATE_H */
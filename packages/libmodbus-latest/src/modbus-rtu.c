@@ -16,6 +16,9 @@
 #include <dfs_posix.h>
 #include <sys/time.h>
 #include <dfs_select.h>
+#if defined(RT_USING_HRTIMER) || defined(RT_SERIAL_USING_FRAME)
+#include <rtdevice.h>
+#endif
 
 #include "modbus-private.h"
 
@@ -266,6 +269,13 @@ static ssize_t _modbus_rtu_send(modbus_t *ctx, const uint8_t *req, int req_lengt
     DWORD n_bytes = 0;
     return (WriteFile(ctx_rtu->w_ser.fd, req, req_length, &n_bytes, NULL)) ? (ssize_t)n_bytes : -1;
 #else
+#ifdef RT_SERIAL_USING_FRAME
+    {
+        /* The response is in the frames received after the request */
+        modbus_rtu_t *frame_rtu = ctx->backend_data;
+        frame_rtu->frame_pos = frame_rtu->frame_length;
+    }
+#endif
 #if HAVE_DECL_TIOCM_RTS
     modbus_rtu_t *ctx_rtu = ctx->backend_data;
     if (ctx_rtu->rts != MODBUS_RTU_RTS_NONE) {
@@ -276,8 +286,15 @@ static ssize_t _modbus_rtu_send(modbus_t *ctx, const uint8_t *req, int req_lengt
         }
 
         ctx_rtu->set_rts(ctx, ctx_rtu->rts == MODBUS_RTU_RTS_UP);
-        rt_int32_t nms = (ctx_rtu->rts_delay/1000) ? (ctx_rtu->rts_delay/1000) : 1;
-        rt_thread_mdelay(nms);
+#ifdef RT_USING_HRTIMER
+        /* the RTS turnaround in microsecond, or in millisecond without the
+         * hardware timer */
+        if (rt_hrtimer_sleep(ctx_rtu->rts_delay) != RT_EOK)
+#endif
+        {
+            rt_int32_t nms = (ctx_rtu->rts_delay/1000) ? (ctx_rtu->rts_delay/1000) : 1;
+            rt_thread_mdelay(nms);
+        }
 
         size = write(ctx->s, req, req_length);
 
@@ -298,6 +315,11 @@ static int _modbus_rtu_receive(modbus_t *ctx, uint8_t *req)
     int rc;
     modbus_rtu_t *ctx_rtu = ctx->backend_data;
 
+#ifdef RT_SERIAL_USING_FRAME
+    /* The message starts at a new frame */
+    ctx_rtu->frame_pos = ctx_rtu->frame_length;
+#endif
+
     if (ctx_rtu->confirmation_to_ignore) {
         _modbus_receive_msg(ctx, req, MSG_CONFIRMATION);
         /* Ignore errors and reset the flag */
@@ -321,6 +343,32 @@ static ssize_t _modbus_rtu_recv(modbus_t *ctx, uint8_t *rsp, int rsp_length)
 #if defined(_WIN32)
     return win32_ser_read(&((modbus_rtu_t *)ctx->backend_data)->w_ser, rsp, rsp_length);
 #else
+#ifdef RT_SERIAL_USING_FRAME
+    modbus_rtu_t *ctx_rtu = ctx->backend_data;
+
+    if (ctx_rtu->frame_dev != NULL) {
+        if (ctx_rtu->frame_pos == ctx_rtu->frame_length) {
+            /* Consume the next frame whole, so the frames don't pile up */
+            ctx_rtu->frame_pos = 0;
+            ctx_rtu->frame_length = rt_serial_frame_read(ctx_rtu->frame_dev,
+                                                         ctx_rtu->frame,
+                                                         sizeof(ctx_rtu->frame),
+                                                         NULL);
+            if (ctx_rtu->frame_length == 0) {
+                /* The frame isn't ended yet */
+                return read(ctx->s, rsp, rsp_length);
+            }
+        }
+
+        if (rsp_length > ctx_rtu->frame_length - ctx_rtu->frame_pos) {
+            rsp_length = ctx_rtu->frame_length - ctx_rtu->frame_pos;
+        }
+        memcpy(rsp, ctx_rtu->frame + ctx_rtu->frame_pos, rsp_length);
+        ctx_rtu->frame_pos += rsp_length;
+
+        return rsp_length;
+    }
+#endif
     return read(ctx->s, rsp, rsp_length);
 #endif
 }
@@ -887,6 +935,35 @@ static int _modbus_rtu_connect(modbus_t *ctx)
     }
 #endif
 
+#ifdef RT_SERIAL_USING_FRAME
+    {
+        /* Wake up once per frame delimited by t3.5, which is fixed to
+           1750us above 19200 bauds. The gap is in 1/10 character. */
+        long char_bits = 1 + ctx_rtu->data_bit + (ctx_rtu->parity == 'N' ? 0 : 1) +
+                         ctx_rtu->stop_bit;
+        long gap = 35;
+
+        if (ctx_rtu->baud > 19200) {
+            gap = (1750L * (ctx_rtu->baud / 100) + char_bits * 1000 - 1) / (char_bits * 1000);
+        }
+        struct dfs_fd *d;
+
+        ctx_rtu->frame_dev = NULL;
+        ctx_rtu->frame_length = ctx_rtu->frame_pos = 0;
+        if (ioctl(ctx->s, RT_SERIAL_CTRL_SET_FRAME_GAP, (void *)gap) < 0) {
+            if (ctx->debug) {
+                fprintf(stderr, "The frame mode isn't supported by %s\n", ctx_rtu->device);
+            }
+        } else if ((d = fd_get(ctx->s)) != NULL) {
+            /* The frames are read from the serial device of the file */
+            if (d->data != NULL && ((rt_device_t)d->data)->type == RT_Device_Class_Char) {
+                ctx_rtu->frame_dev = (rt_device_t)d->data;
+            }
+            fd_put(d);
+        }
+    }
+#endif
+
     return 0;
 }
 
@@ -1109,6 +1186,9 @@ static void _modbus_rtu_close(modbus_t *ctx)
         close(ctx->s);
         ctx->s = -1;
     }
+#ifdef RT_SERIAL_USING_FRAME
+    ctx_rtu->frame_dev = NULL;
+#endif
 #endif
 }
 
@@ -1119,6 +1199,11 @@ static int _modbus_rtu_flush(modbus_t *ctx)
     ctx_rtu->w_ser.n_bytes = 0;
     return (PurgeComm(ctx_rtu->w_ser.fd, PURGE_RXCLEAR) == FALSE);
 #else
+#ifdef RT_SERIAL_USING_FRAME
+    modbus_rtu_t *ctx_rtu = ctx->backend_data;
+
+    ctx_rtu->frame_pos = ctx_rtu->frame_length;
+#endif
     return tcflush(ctx->s, TCIOFLUSH);
 #endif
 }
@@ -1139,6 +1224,14 @@ static int _modbus_rtu_select(modbus_t *ctx, fd_set *rset,
         return -1;
     }
 #else
+#ifdef RT_SERIAL_USING_FRAME
+    modbus_rtu_t *ctx_rtu = ctx->backend_data;
+
+    /* The rest of frame read before */
+    if (ctx_rtu->frame_dev != NULL && ctx_rtu->frame_pos < ctx_rtu->frame_length) {
+        return 1;
+    }
+#endif
     while ((s_rc = select(ctx->s+1, rset, NULL, NULL, tv)) == -1) {
         if (errno == EINTR) {
             if (ctx->debug) {
@@ -1255,6 +1348,10 @@ modbus_t* modbus_new_rtu(const char *device,
 #endif
 
     ctx_rtu->confirmation_to_ignore = FALSE;
+#ifdef RT_SERIAL_USING_FRAME
+    ctx_rtu->frame_dev = NULL;
+    ctx_rtu->frame_length = ctx_rtu->frame_pos = 0;
+#endif
 
     return ctx;
 }
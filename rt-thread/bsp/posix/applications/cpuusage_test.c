@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The test of CPU time accounting of threads. The threads spin for known
+ * time one after another, and the CPU time accounted to each of them shall
+ * match the time it spins. Then the ops of CPU time is removed, and the
+ * threads are switched by yield, the accounting shall be skipped and the
+ * errno of thread shall be kept.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#if defined(RT_USING_CPU_USAGE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define TEST_THREAD_PRIORITY    (FINSH_THREAD_PRIORITY + 1)
+#define TEST_YIELD_NUM          100
+
+static struct rt_semaphore test_done;
+
+static void test_spin_entry(void *parameter)
+{
+    rt_tick_t start = rt_tick_get();
+
+    while (rt_tick_get() - start < (rt_tick_t)(rt_ubase_t)parameter);
+
+    rt_sem_release(&test_done);
+}
+
+static void test_yield_entry(void *parameter)
+{
+    int count;
+
+    for (count = 0; count < TEST_YIELD_NUM; count ++)
+        rt_thread_yield();
+
+    rt_sem_release(&test_done);
+}
+
+/* spin in a thread for the time, return the CPU time accounted in ms */
+static int test_spin(int ms)
+{
+    rt_tick_t ticks = rt_tick_from_millisecond(ms);
+    rt_thread_t thread;
+    rt_uint64_t time;
+
+    thread = rt_thread_create("cutspin", test_spin_entry, (void *)(rt_ubase_t)ticks, 2048,
+                              TEST_THREAD_PRIORITY, 10);
+    if (thread == RT_NULL)
+        return -1;
+
+    /* the thread of lower priority is still alive after the release */
+    rt_thread_startup(thread);
+    rt_sem_take(&test_done, RT_WAITING_FOREVER);
+    time = rt_thread_cpu_time(thread);
+
+    return (int)(time * clock_cpu_getres() / 1000000);
+}
+
+static int cpuusage_test(int argc, char **argv)
+{
+    const struct rt_clock_cputime_ops *ops;
+    rt_thread_t thread;
+    int short_ms, long_ms, count, errors = 0;
+
+    if (clock_cpu_getops() == RT_NULL)
+    {
+        rt_kprintf("no CPU time clock\n");
+        return -RT_ENOSYS;
+    }
+    rt_sem_init(&test_done, "cutest", 0, RT_IPC_FLAG_FIFO);
+
+    /* the error of 20% for the time of interrupt and the host */
+    short_ms = test_spin(20);
+    long_ms  = test_spin(60);
+    if (short_ms < 16 || short_ms > 24)
+        errors ++;
+    if (long_ms < 48 || long_ms > 72)
+        errors ++;
+    rt_kprintf("spin 20 ms accounted %d ms, spin 60 ms accounted %d ms\n", short_ms, long_ms);
+
+    /* the errno is kept without the clock */
+    ops = clock_cpu_getops();
+    clock_cpu_setops(RT_NULL);
+    thread = rt_thread_create("cutyield", test_yield_entry, RT_NULL, 2048,
+                              FINSH_THREAD_PRIORITY, 10);
+    if (thread != RT_NULL)
+        rt_thread_startup(thread);
+    else
+        rt_sem_release(&test_done);
+    rt_set_errno(-RT_EBUSY);
+    for (count = 0; count < TEST_YIELD_NUM; count ++)
+        rt_thread_yield();
+    if (rt_get_errno() != -RT_EBUSY)
+        errors ++;
+    clock_cpu_setops(ops);
+    rt_sem_take(&test_done, RT_WAITING_FOREVER);
+
+    rt_kprintf("cpu usage test %s\n", errors == 0 ? "passed" : "failed");
+
+    rt_sem_detach(&test_done);
+
+    return 0;
+}
+MSH_CMD_EXPORT(cpuusage_test, test the CPU time accounting of threads);
+#endif
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The benchmark of heap latency and fragmentation by trace replay. The trace
+ * of malloc, realloc and free is recorded from a model of the network and
+ * JSON workload: the packet buffers of short life, the bursts of small JSON
+ * nodes released in bulk, and the socket buffers of long life which grow by
+ * realloc. The trace is replayed with rt_malloc, rt_realloc and rt_free of
+ * the heap algorithm in configuration, and it shows the average and the
+ * worst time of each operation, the peak usage of heap, and the largest
+ * block can be allocated at the end of the trace for the fragmentation.
+ * Build with each of the heap algorithms to compare them.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#if defined(RT_USING_HEAP) && defined(RT_USING_FINSH) && defined(RT_USING_CPUTIME)
+#include <finsh.h>
+
+#define BENCH_SLOT_NUM          512
+#define BENCH_JSON_SLOT_NUM     128
+#define BENCH_SOCKET_SLOT_NUM   16
+
+#if defined(RT_USING_TLSF)
+#define BENCH_HEAP_NAME         "tlsf"
+#elif defined(RT_USING_SLAB)
+#define BENCH_HEAP_NAME         "slab"
+#elif defined(RT_USING_MEMHEAP_AS_HEAP)
+#define BENCH_HEAP_NAME         "memheap"
+#else
+#define BENCH_HEAP_NAME         "small mem"
+#endif
+
+enum bench_op
+{
+    BENCH_OP_MALLOC,
+    BENCH_OP_REALLOC,
+    BENCH_OP_FREE,
+    BENCH_OP_NUM,
+};
+
+struct bench_event
+{
+    rt_uint8_t op;
+    rt_uint16_t slot;
+    rt_uint32_t size;
+};
+
+struct bench_stat
+{
+    rt_uint32_t count;
+    rt_uint32_t failed;
+    rt_uint32_t total;
+    rt_uint32_t worst;
+};
+
+/*
+ * The slots [0, BENCH_SOCKET_SLOT_NUM) are the socket buffers, the following
+ * BENCH_JSON_SLOT_NUM slots are the JSON nodes, and the rest are the packet
+ * buffers.
+ */
+#define BENCH_JSON_SLOT         BENCH_SOCKET_SLOT_NUM
+#define BENCH_PACKET_SLOT       (BENCH_JSON_SLOT + BENCH_JSON_SLOT_NUM)
+
+static int bench_record(struct bench_event *trace, int num)
+{
+    rt_uint32_t sizes[BENCH_SLOT_NUM];
+    int count = 0, slot, index, burst;
+
+    rt_memset(sizes, 0, sizeof(sizes));
+    srand(1);
+
+#define BENCH_RECORD(_op, _slot, _size)             \
+    do {                                            \
+        if (count >= num) return count;             \
+        trace[count].op = (_op);                    \
+        trace[count].slot = (_slot);                \
+        trace[count].size = (_size);                \
+        count ++;                                   \
+    } while (0)
+
+    while (count < num)
+    {
+        switch (rand() % 8)
+        {
+        case 0:
+            /* a JSON document is parsed, then it's released in bulk */
+            burst = 16 + rand() % (BENCH_JSON_SLOT_NUM - 16);
+            for (index = 0; index < burst; index ++)
+                BENCH_RECORD(BENCH_OP_MALLOC, BENCH_JSON_SLOT + index, 16 + rand() % 48);
+            for (index = 0; index < burst; index ++)
+                BENCH_RECORD(BENCH_OP_FREE, BENCH_JSON_SLOT + index, 0);
+            break;
+
+        case 1:
+            /* a socket buffer is opened, grown or closed */
+            slot = rand() % BENCH_SOCKET_SLOT_NUM;
+            if (sizes[slot] == 0)
+            {
+                sizes[slot] = 256 + rand() % 768;
+                BENCH_RECORD(BENCH_OP_MALLOC, slot, sizes[slot]);
+            }
+            else if (sizes[slot] < 8192 && rand() % 4)
+            {
+                sizes[slot] += 256 + rand() % 1024;
+                BENCH_RECORD(BENCH_OP_REALLOC, slot, sizes[slot]);
+            }
+            else
+            {
+                sizes[slot] = 0;
+                BENCH_RECORD(BENCH_OP_FREE, slot, 0);
+            }
+            break;
+
+        default:
+            /* a packet buffer is received or released */
+            slot = BENCH_PACKET_SLOT + rand() % (BENCH_SLOT_NUM - BENCH_PACKET_SLOT);
+            if (sizes[slot] == 0)
+            {
+                /* the small TCP segments and the full frames */
+                sizes[slot] = rand() % 4 ? 64 + rand() % 256 : 1536;
+                BENCH_RECORD(BENCH_OP_MALLOC, slot, sizes[slot]);
+            }
+            else
+            {
+                sizes[slot] = 0;
+                BENCH_RECORD(BENCH_OP_FREE, slot, 0);
+            }
+            break;
+        }
+    }
+
+#undef BENCH_RECORD
+
+    return count;
+}
+
+static void bench_heap_info(rt_uint32_t *total, rt_uint32_t *used, rt_uint32_t *max_used)
+{
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_memheap *heap;
+
+    *total = *used = *max_used = 0;
+    information = rt_object_get_information(RT_Object_Class_MemHeap);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        heap = (struct rt_memheap *)rt_list_entry(node, struct rt_object, list);
+        *total    += heap->pool_size;
+        *used     += heap->pool_size - heap->available_size;
+        *max_used += heap->max_used_size;
+    }
+#else
+    rt_memory_info(total, used, max_used);
+#endif
+}
+
+/* the largest block can be allocated, by bisection */
+static rt_size_t bench_largest_block(rt_size_t limit)
+{
+    rt_size_t low = 0, high = limit, size;
+    void *ptr;
+
+    while (low < high)
+    {
+        size = low + (high - low + 1) / 2;
+        ptr = rt_malloc(size);
+        if (ptr != RT_NULL)
+        {
+            rt_free(ptr);
+            low = size;
+        }
+        else
+        {
+            high = size - 1;
+        }
+    }
+
+    return low;
+}
+
+static int heap_bench(int argc, char **argv)
+{
+    static const char *name[BENCH_OP_NUM] = { "malloc", "realloc", "free" };
+    struct bench_stat stats[BENCH_OP_NUM];
+    struct bench_event *trace;
+    void **slots, *ptr;
+    rt_uint32_t stamp, elapsed, total, used, max_used, base_used, peak_used = 0;
+    rt_uint32_t live = 0, max_live = 0;
+    rt_uint32_t sizes[BENCH_SLOT_NUM];
+    float resolution = clock_cpu_getres();
+    rt_size_t largest;
+    int num = 100000, count, index;
+
+    if (argc > 1)
+        num = atoi(argv[1]);
+    if (num <= 0)
+    {
+        rt_kprintf("Usage: heap_bench [events]\n");
+        return -RT_EINVAL;
+    }
+
+    trace = (struct bench_event *)rt_malloc(num * sizeof(struct bench_event));
+    slots = (void **)rt_calloc(BENCH_SLOT_NUM, sizeof(void *));
+    if (trace == RT_NULL || slots == RT_NULL)
+    {
+        rt_kprintf("no memory for benchmark\n");
+        rt_free(trace);
+        rt_free(slots);
+        return -RT_ENOMEM;
+    }
+    num = bench_record(trace, num);
+    rt_memset(stats, 0, sizeof(stats));
+    rt_memset(sizes, 0, sizeof(sizes));
+    bench_heap_info(&total, &base_used, &max_used);
+
+    for (count = 0; count < num; count ++)
+    {
+        struct bench_event *event = &trace[count];
+        struct bench_stat *stat = &stats[event->op];
+
+        /* the slot is empty if the allocation has failed */
+        if (event->op != BENCH_OP_MALLOC && slots[event->slot] == RT_NULL)
+            continue;
+
+        stamp = clock_cpu_gettime();
+        switch (event->op)
+        {
+        case BENCH_OP_MALLOC:
+            ptr = rt_malloc(event->size);
+            break;
+        case BENCH_OP_REALLOC:
+            ptr = rt_realloc(slots[event->slot], event->size);
+            break;
+        default:
+            rt_free(slots[event->slot]);
+            ptr = RT_NULL;
+            break;
+        }
+        elapsed = clock_cpu_gettime() - stamp;
+
+        stat->count ++;
+        stat->total += elapsed;
+        if (elapsed > stat->worst)
+            stat->worst = elapsed;
+
+        if (event->op != BENCH_OP_FREE && ptr == RT_NULL)
+        {
+            stat->failed ++;
+            /* the block is kept on the failure of realloc */
+            continue;
+        }
+
+        /* touch the block as the workload does */
+        if (ptr != RT_NULL)
+            rt_memset(ptr, count, event->size);
+
+        live = live - sizes[event->slot] + event->size;
+        if (live > max_live)
+            max_live = live;
+        slots[event->slot] = ptr;
+        sizes[event->slot] = event->size;
+
+        bench_heap_info(&total, &used, &max_used);
+        if (used - base_used > peak_used)
+            peak_used = used - base_used;
+    }
+
+    bench_heap_info(&total, &used, &max_used);
+    largest = bench_largest_block(total);
+
+    rt_kprintf("heap %s, %d events, heap size %d\n", BENCH_HEAP_NAME, num, total);
+    rt_kprintf("operation  count   failed  average(ns) worst(ns)\n");
+    rt_kprintf("---------- ------- ------- ----------- ---------\n");
+    for (index = 0; index < BENCH_OP_NUM; index ++)
+    {
+        rt_kprintf("%-10s %7d %7d %11d %9d\n", name[index], stats[index].count, stats[index].failed,
+                   stats[index].count ? (int)(stats[index].total * resolution / stats[index].count) : 0,
+                   (int)(stats[index].worst * resolution));
+    }
+    rt_kprintf("peak live %d, peak used %d, used at end %d for live %d\n",
+               max_live, peak_used, used - base_used, live);
+    rt_kprintf("free %d, largest block %d, fragmentation %d%%\n", total - used, largest,
+               total > used ? (int)(100 - (rt_uint64_t)largest * 100 / (total - used)) : 0);
+
+    for (index = 0; index < BENCH_SLOT_NUM; index ++)
+        rt_free(slots[index]);
+    rt_free(slots);
+    rt_free(trace);
+
+    return 0;
+}
+MSH_CMD_EXPORT(heap_bench, benchmark heap latency and fragmentation by trace replay. Usage: heap_bench [events]);
+#endif
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The test of the fast path of semaphore and mutex. The threads of different
+ * priorities take and release the semaphore and the mutex, and they yield or
+ * delay while holding them, so the fast path and the slow path are mixed,
+ * and the contention mark is set and cleared. At the end, the counts shall
+ * match, the objects shall be released with no contention mark left, and
+ * the priorities shall be restored. It also shows the time of uncontended
+ * take and release.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#if defined(RT_USING_IPC_FASTPATH) && defined(RT_USING_FINSH) && defined(RT_USING_CPUTIME)
+#include <finsh.h>
+
+#define TEST_THREAD_NUM         3
+#define TEST_THREAD_PRIORITY    20
+
+struct fastpath_test
+{
+    struct rt_semaphore items;
+    struct rt_semaphore done;
+    struct rt_mutex lock;
+
+    int rounds;
+    volatile rt_uint32_t counter;
+    rt_uint32_t produced;
+    rt_uint32_t consumed;
+    rt_uint32_t errors;
+};
+
+static struct fastpath_test test;
+
+static void test_mutex_entry(void *parameter)
+{
+    rt_uint8_t priority = rt_thread_self()->current_priority;
+    rt_uint32_t value;
+    int round;
+
+    for (round = 0; round < test.rounds; round ++)
+    {
+        rt_mutex_take(&test.lock, RT_WAITING_FOREVER);
+        if (rt_mutex_take(&test.lock, RT_WAITING_FOREVER) != RT_EOK)
+            test.errors ++;
+
+        /* the other threads shall not change the counter */
+        value = test.counter;
+        if (round % 3 == 0)
+            rt_thread_yield();
+        else if (round % 7 == 0)
+            rt_thread_mdelay(1);
+        test.counter = value + 1;
+
+        rt_mutex_release(&test.lock);
+        rt_mutex_release(&test.lock);
+
+        if (rt_thread_self()->current_priority != priority)
+            test.errors ++;
+    }
+
+    rt_sem_release(&test.done);
+}
+
+static void test_producer_entry(void *parameter)
+{
+    int round;
+
+    for (round = 0; round < test.rounds; round ++)
+    {
+        rt_sem_release(&test.items);
+        test.produced ++;
+        if (round % 5 == 0)
+            rt_thread_yield();
+    }
+
+    rt_sem_release(&test.done);
+}
+
+static void test_consumer_entry(void *parameter)
+{
+    int round;
+
+    for (round = 0; round < test.rounds; round ++)
+    {
+        /* the timeout leaves the contention mark stale */
+        while (rt_sem_take(&test.items, round % 11 == 0 ? 0 : 1) != RT_EOK);
+        test.consumed ++;
+    }
+
+    rt_sem_release(&test.done);
+}
+
+static void test_run(void (*entry)(void *parameter), int num, rt_bool_t spread)
+{
+    rt_thread_t thread;
+    char name[RT_NAME_MAX];
+    int index;
+
+    for (index = 0; index < num; index ++)
+    {
+        rt_snprintf(name, sizeof(name), "fp%d", index);
+        thread = rt_thread_create(name, entry, RT_NULL, 2048,
+                                  TEST_THREAD_PRIORITY + (spread ? index : 0), 2);
+        if (thread != RT_NULL)
+            rt_thread_startup(thread);
+        else
+            rt_sem_release(&test.done);
+    }
+}
+
+static void test_uncontended(void)
+{
+    rt_uint32_t stamp, sem_time, mutex_time;
+    float resolution = clock_cpu_getres();
+    int count;
+
+    stamp = clock_cpu_gettime();
+    for (count = 0; count < 100000; count ++)
+    {
+        rt_sem_release(&test.items);
+        rt_sem_take(&test.items, 0);
+    }
+    sem_time = clock_cpu_gettime() - stamp;
+
+    stamp = clock_cpu_gettime();
+    for (count = 0; count < 100000; count ++)
+    {
+        rt_mutex_take(&test.lock, RT_WAITING_FOREVER);
+        rt_mutex_release(&test.lock);
+    }
+    mutex_time = clock_cpu_gettime() - stamp;
+
+    rt_kprintf("uncontended semaphore %d ns, mutex %d ns\n",
+               (int)(sem_time * resolution / 100000), (int)(mutex_time * resolution / 100000));
+}
+
+static int ipc_fastpath_test(int argc, char **argv)
+{
+    int index;
+
+    rt_memset(&test, 0, sizeof(test));
+    test.rounds = 2000;
+    if (argc > 1)
+        test.rounds = atoi(argv[1]);
+    if (test.rounds <= 0)
+    {
+        rt_kprintf("Usage: ipc_fastpath_test [rounds]\n");
+        return -RT_EINVAL;
+    }
+
+    rt_sem_init(&test.items, "fpitems", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&test.done, "fpdone", 0, RT_IPC_FLAG_FIFO);
+    rt_mutex_init(&test.lock, "fplock", RT_IPC_FLAG_FIFO);
+
+    test_uncontended();
+
+    /* the threads of different priorities, the priority is inherited */
+    test_run(test_mutex_entry, TEST_THREAD_NUM, RT_TRUE);
+    for (index = 0; index < TEST_THREAD_NUM; index ++)
+        rt_sem_take(&test.done, RT_WAITING_FOREVER);
+
+    test_run(test_producer_entry, 1, RT_FALSE);
+    test_run(test_consumer_entry, 1, RT_FALSE);
+    for (index = 0; index < 2; index ++)
+        rt_sem_take(&test.done, RT_WAITING_FOREVER);
+
+    if (test.counter != (rt_uint32_t)test.rounds * TEST_THREAD_NUM)
+        test.errors ++;
+    if (test.lock.value != 1 || test.lock.hold != 0 || test.lock.owner != RT_NULL)
+        test.errors ++;
+    if (test.produced != test.consumed || test.items.value != 0)
+        test.errors ++;
+    /* the release of semaphore through slow path clears the stale mark */
+    rt_sem_release(&test.items);
+    if (test.items.reserved != 0 || rt_sem_take(&test.items, 0) != RT_EOK)
+        test.errors ++;
+
+    rt_kprintf("mutex counter %d, semaphore %d/%d, errors %d: %s\n", test.counter,
+               test.produced, test.consumed, test.errors, test.errors == 0 ? "passed" : "failed");
+
+    rt_mutex_detach(&test.lock);
+    rt_sem_detach(&test.done);
+    rt_sem_detach(&test.items);
+
+    return 0;
+}
+MSH_CMD_EXPORT(ipc_fastpath_test, test the fast path of semaphore and mutex. Usage: ipc_fastpath_test [rounds]);
+#endif
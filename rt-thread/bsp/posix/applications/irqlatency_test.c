@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    check the sections in the tick interrupt
+ */
+
+/*
+ * The test of the measurement of interrupt-disabled sections. The threads
+ * are created, and they are switched out in the disabled sections of the
+ * scheduler, or start with interrupt enabled directly by the port. Then the
+ * sections are disabled and enabled in the thread of the command, and they
+ * shall be measured. The sections of rt_timer_check in the tick interrupt
+ * shall be measured as well, while the threads are switched.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h> /* for clock_cpu_getres */
+
+#if defined(RT_USING_IRQ_LATENCY) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define TEST_THREAD_NUM         3
+#define TEST_SECTION_NUM        100
+
+static struct rt_semaphore test_done;
+
+static void test_thread_entry(void *parameter)
+{
+    int round;
+
+    for (round = 0; round < 10; round ++)
+        rt_thread_mdelay(1);
+
+    rt_sem_release(&test_done);
+}
+
+static int irqlatency_test(int argc, char **argv)
+{
+    rt_uint32_t count, max, isr_count, errors = 0;
+    volatile rt_uint32_t spin;
+    rt_thread_t thread;
+    rt_base_t level;
+    char name[RT_NAME_MAX];
+    int index;
+
+    rt_sem_init(&test_done, "iltest", 0, RT_IPC_FLAG_FIFO);
+    rt_irq_latency_reset();
+
+    for (index = 0; index < TEST_THREAD_NUM; index ++)
+    {
+        rt_snprintf(name, sizeof(name), "ilt%d", index);
+        thread = rt_thread_create(name, test_thread_entry, RT_NULL, 2048,
+                                  RT_THREAD_PRIORITY_MAX - 4 - index, 5);
+        if (thread != RT_NULL)
+            rt_thread_startup(thread);
+        else
+            rt_sem_release(&test_done);
+    }
+    for (index = 0; index < TEST_THREAD_NUM; index ++)
+        rt_sem_take(&test_done, RT_WAITING_FOREVER);
+    isr_count = rt_irq_latency_get_func("rt_timer_check", RT_NULL);
+    if (isr_count == 0)
+        errors ++;
+
+    for (index = 0; index < TEST_SECTION_NUM; index ++)
+    {
+        level = rt_hw_interrupt_disable();
+        for (spin = 0; spin < 1000; spin ++);
+        rt_hw_interrupt_enable(level);
+    }
+
+    count = rt_irq_latency_get(RT_FALSE, &max);
+    if (count < TEST_SECTION_NUM || max == 0)
+        errors ++;
+
+    rt_kprintf("%d interrupt-disabled sections, max %d ns, %d in rt_timer_check, errors %d: %s\n",
+               count, (int)(max * clock_cpu_getres()), isr_count, errors, errors == 0 ? "passed" : "failed");
+
+    rt_sem_detach(&test_done);
+
+    return 0;
+}
+MSH_CMD_EXPORT(irqlatency_test, test the measurement of interrupt-disabled sections);
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The benchmark of the per-thread memory cache. The worker threads of the
+ * same priority allocate the batches of small blocks of random size and
+ * release them, through rt_malloc/rt_free with the cache, and through
+ * rt_heap_malloc/rt_heap_free of the heap directly. It shows the average
+ * time of allocation and release, and the time of all workers finished.
+ * The command `memcache` shows the hit and miss of the size classes after.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#if defined(RT_USING_MEMCACHE) && defined(RT_USING_FINSH) && defined(RT_USING_CPUTIME)
+#include <finsh.h>
+
+#define BENCH_THREAD_MAX        8
+#define BENCH_BATCH             32
+#define BENCH_ROUNDS            2000
+#define BENCH_MAX_SIZE          256
+
+struct bench_worker
+{
+    rt_thread_t thread;
+    rt_bool_t cached;
+    rt_uint32_t seed;
+    rt_uint32_t ops;
+    rt_uint32_t alloc_time;
+    rt_uint32_t free_time;
+    rt_uint32_t failed;
+};
+
+static struct rt_semaphore bench_done;
+
+static void bench_entry(void *parameter)
+{
+    struct bench_worker *worker = (struct bench_worker *)parameter;
+    void *blocks[BENCH_BATCH];
+    rt_uint32_t stamp, seed = worker->seed;
+    rt_size_t size;
+    int round, index;
+
+    for (round = 0; round < BENCH_ROUNDS; round ++)
+    {
+        for (index = 0; index < BENCH_BATCH; index ++)
+        {
+            seed = seed * 1103515245 + 12345;
+            size = 16 + (seed >> 16) % (BENCH_MAX_SIZE - 16 + 1);
+
+            stamp = clock_cpu_gettime();
+            blocks[index] = worker->cached ? rt_malloc(size) : rt_heap_malloc(size);
+            worker->alloc_time += clock_cpu_gettime() - stamp;
+
+            if (blocks[index] == RT_NULL)
+                worker->failed ++;
+        }
+
+        for (index = 0; index < BENCH_BATCH; index ++)
+        {
+            if (blocks[index] == RT_NULL)
+                continue;
+
+            stamp = clock_cpu_gettime();
+            if (worker->cached)
+                rt_free(blocks[index]);
+            else
+                rt_heap_free(blocks[index]);
+            worker->free_time += clock_cpu_gettime() - stamp;
+        }
+        worker->ops += BENCH_BATCH;
+
+        /* let the other workers run in the middle of their batches */
+        if ((round & 0x0F) == 0)
+            rt_thread_yield();
+    }
+
+    rt_sem_release(&bench_done);
+}
+
+static void bench_run(const char *title, rt_bool_t cached, int num)
+{
+    struct bench_worker workers[BENCH_THREAD_MAX];
+    rt_uint32_t stamp, elapsed, ops = 0, alloc_time = 0, free_time = 0, failed = 0;
+    float resolution = clock_cpu_getres();
+    char name[RT_NAME_MAX];
+    int index;
+
+    rt_memset(workers, 0, sizeof(workers));
+    stamp = clock_cpu_gettime();
+    for (index = 0; index < num; index ++)
+    {
+        workers[index].cached = cached;
+        workers[index].seed = index + 1;
+        rt_snprintf(name, sizeof(name), "mcb%d", index);
+        workers[index].thread = rt_thread_create(name, bench_entry, &workers[index], 2048,
+                                                 RT_THREAD_PRIORITY_MAX - 3, 5);
+        if (workers[index].thread != RT_NULL)
+            rt_thread_startup(workers[index].thread);
+        else
+            rt_sem_release(&bench_done);
+    }
+    for (index = 0; index < num; index ++)
+        rt_sem_take(&bench_done, RT_WAITING_FOREVER);
+    elapsed = clock_cpu_gettime() - stamp;
+
+    for (index = 0; index < num; index ++)
+    {
+        ops        += workers[index].ops;
+        alloc_time += workers[index].alloc_time;
+        free_time  += workers[index].free_time;
+        failed     += workers[index].failed;
+    }
+
+    rt_kprintf("%-10s %8d %9d %8d %9d %6d\n", title, ops,
+               ops ? (int)(alloc_time * resolution / ops) : 0,
+               ops ? (int)(free_time * resolution / ops) : 0,
+               (int)(elapsed * resolution / 1000), failed);
+}
+
+static int memcache_bench(int argc, char **argv)
+{
+    int num = 4;
+
+    if (argc > 1)
+        num = atoi(argv[1]);
+    if (num <= 0 || num > BENCH_THREAD_MAX)
+    {
+        rt_kprintf("Usage: memcache_bench [threads, 1-%d]\n", BENCH_THREAD_MAX);
+        return -RT_EINVAL;
+    }
+
+    rt_sem_init(&bench_done, "mcbench", 0, RT_IPC_FLAG_FIFO);
+
+    rt_kprintf("%d threads, batches of %d blocks of 16-%d bytes\n", num, BENCH_BATCH, BENCH_MAX_SIZE);
+    rt_kprintf("path       blocks   alloc(ns) free(ns) total(us) failed\n");
+    rt_kprintf("---------- -------- --------- -------- --------- ------\n");
+    bench_run("heap", RT_FALSE, num);
+    bench_run("memcache", RT_TRUE, num);
+
+    rt_sem_detach(&bench_done);
+
+    return 0;
+}
+MSH_CMD_EXPORT(memcache_bench, benchmark the per-thread memory cache. Usage: memcache_bench [threads]);
+#endif
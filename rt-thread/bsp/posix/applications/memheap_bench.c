@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The benchmark of the placement classes on the simulated memory regions.
+ * The blocks of random size are allocated by rt_malloc and rt_malloc_in of
+ * each class, until the number of blocks or the memory runs out, then they
+ * are released. It shows the average time of allocation and release, and
+ * the memory heaps the blocks are placed in.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#if defined(RT_USING_MEMHEAP_CLASS) && defined(RT_USING_FINSH) && defined(RT_USING_CPUTIME)
+#include <finsh.h>
+
+#define BENCH_BLOCK_NUM         1024
+#define BENCH_HEAP_NUM          8
+
+struct bench_heap
+{
+    struct rt_memheap *heap;
+    rt_uint32_t count;
+};
+
+static int bench_heap_collect(struct bench_heap *heaps)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    int num = 0;
+
+    information = rt_object_get_information(RT_Object_Class_MemHeap);
+    for (node  = information->object_list.next;
+         node != &(information->object_list) && num < BENCH_HEAP_NUM;
+         node  = node->next)
+    {
+        heaps[num].heap  = (struct rt_memheap *)rt_list_entry(node, struct rt_object, list);
+        heaps[num].count = 0;
+        num ++;
+    }
+
+    return num;
+}
+
+static void bench_heap_account(struct bench_heap *heaps, int num, void *ptr)
+{
+    rt_uint8_t *start;
+    int index;
+
+    for (index = 0; index < num; index ++)
+    {
+        start = (rt_uint8_t *)heaps[index].heap->start_addr;
+        if ((rt_uint8_t *)ptr >= start && (rt_uint8_t *)ptr < start + heaps[index].heap->pool_size)
+        {
+            heaps[index].count ++;
+            break;
+        }
+    }
+}
+
+static void bench_run(const char *title, int heap_class, rt_size_t max_size, void **blocks)
+{
+    struct bench_heap heaps[BENCH_HEAP_NUM];
+    rt_uint32_t stamp, alloc_time = 0, free_time = 0;
+    float resolution = clock_cpu_getres();
+    int count, index, num;
+
+    num = bench_heap_collect(heaps);
+    srand(1);
+
+    for (count = 0; count < BENCH_BLOCK_NUM; count ++)
+    {
+        rt_size_t size = 16 + rand() % max_size;
+
+        stamp = clock_cpu_gettime();
+        if (heap_class)
+            blocks[count] = rt_malloc_in(heap_class, size);
+        else
+            blocks[count] = rt_malloc(size);
+        alloc_time += clock_cpu_gettime() - stamp;
+
+        if (blocks[count] == RT_NULL)
+            break;
+        bench_heap_account(heaps, num, blocks[count]);
+    }
+
+    for (index = 0; index < count; index ++)
+    {
+        stamp = clock_cpu_gettime();
+        rt_free(blocks[index]);
+        free_time += clock_cpu_gettime() - stamp;
+    }
+
+    rt_kprintf("%-10s %6d %8d %8d  ", title, count,
+               count ? (int)(alloc_time * resolution / count) : 0,
+               count ? (int)(free_time * resolution / count) : 0);
+    for (index = 0; index < num; index ++)
+    {
+        if (heaps[index].count)
+            rt_kprintf(" %.*s:%d", RT_NAME_MAX, heaps[index].heap->parent.name, heaps[index].count);
+    }
+    rt_kprintf("\n");
+}
+
+static int memheap_bench(int argc, char **argv)
+{
+    rt_size_t max_size = 1024;
+    void **blocks;
+
+    if (argc > 1)
+        max_size = atoi(argv[1]);
+    if (max_size == 0)
+    {
+        rt_kprintf("Usage: memheap_bench [max size]\n");
+        return -RT_EINVAL;
+    }
+
+    blocks = (void **)rt_malloc(BENCH_BLOCK_NUM * sizeof(void *));
+    if (blocks == RT_NULL)
+    {
+        rt_kprintf("no memory for benchmark\n");
+        return -RT_ENOMEM;
+    }
+
+    rt_kprintf("class      blocks alloc(ns) free(ns)  placement\n");
+    rt_kprintf("---------- ------ -------- --------  ---------\n");
+    bench_run("rt_malloc", 0, max_size, blocks);
+    bench_run("fast", RT_MEMHEAP_CLASS_FAST, max_size, blocks);
+    bench_run("dma", RT_MEMHEAP_CLASS_DMA, max_size, blocks);
+    bench_run("bulk", RT_MEMHEAP_CLASS_BULK, max_size, blocks);
+
+    rt_free(blocks);
+
+    return 0;
+}
+MSH_CMD_EXPORT(memheap_bench, benchmark the placement classes of memory heaps. Usage: memheap_bench [max size]);
+#endif
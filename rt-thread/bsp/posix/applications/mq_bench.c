@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The benchmark of message queue throughput with copy and zero-copy. The
+ * messages of 16, 64 and 256 bytes are built by the producer and summed by
+ * the consumer, and the queue is filled and drained in turn. The copy path
+ * builds the message in a local buffer, sends it by rt_mq_send and receives
+ * it by rt_mq_recv; the zero-copy path builds it in place by rt_mq_reserve
+ * and rt_mq_commit, and sums it in place by rt_mq_peek and rt_mq_release;
+ * the burst path sends the batch by rt_mq_send_burst. It shows the average
+ * time of a message through the queue.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#if defined(RT_USING_MESSAGEQUEUE) && defined(RT_USING_FINSH) && defined(RT_USING_CPUTIME)
+#include <finsh.h>
+
+#define BENCH_QUEUE_DEPTH       32
+#define BENCH_MSG_MAX           256
+
+enum bench_mode
+{
+    BENCH_MODE_COPY,
+    BENCH_MODE_ZERO_COPY,
+    BENCH_MODE_BURST,
+};
+
+static void bench_build(rt_uint8_t *msg, rt_size_t size, rt_uint32_t seq)
+{
+    rt_size_t index;
+
+    for (index = 0; index < size; index ++)
+        msg[index] = (rt_uint8_t)(seq + index);
+}
+
+static rt_uint32_t bench_sum(const rt_uint8_t *msg, rt_size_t size)
+{
+    rt_uint32_t sum = 0;
+    rt_size_t index;
+
+    for (index = 0; index < size; index ++)
+        sum += msg[index];
+
+    return sum;
+}
+
+static void bench_run(const char *title, enum bench_mode mode, rt_size_t size, int num)
+{
+    static rt_uint8_t batch[BENCH_QUEUE_DEPTH * BENCH_MSG_MAX];
+    rt_uint8_t buffer[BENCH_MSG_MAX], *msg;
+    rt_uint32_t stamp, total = 0, sent_sum = 0, recv_sum = 0, seq = 0;
+    float resolution = clock_cpu_getres();
+    rt_mq_t mq;
+    int count, index, errors = 0;
+
+    mq = rt_mq_create("mqbench", size, BENCH_QUEUE_DEPTH, RT_IPC_FLAG_FIFO);
+    if (mq == RT_NULL)
+    {
+        rt_kprintf("no memory for benchmark\n");
+        return;
+    }
+
+    for (count = 0; count < num; count += BENCH_QUEUE_DEPTH)
+    {
+        stamp = clock_cpu_gettime();
+
+        /* fill the queue */
+        if (mode == BENCH_MODE_BURST)
+        {
+            for (index = 0; index < BENCH_QUEUE_DEPTH; index ++)
+                bench_build(&batch[index * size], size, seq ++);
+            if (rt_mq_send_burst(mq, batch, size, BENCH_QUEUE_DEPTH) != BENCH_QUEUE_DEPTH)
+                errors ++;
+        }
+        else
+        {
+            for (index = 0; index < BENCH_QUEUE_DEPTH; index ++)
+            {
+                if (mode == BENCH_MODE_COPY)
+                {
+                    bench_build(buffer, size, seq ++);
+                    if (rt_mq_send(mq, buffer, size) != RT_EOK)
+                        errors ++;
+                }
+                else
+                {
+                    msg = (rt_uint8_t *)rt_mq_reserve(mq);
+                    if (msg == RT_NULL)
+                    {
+                        errors ++;
+                        continue;
+                    }
+                    bench_build(msg, size, seq ++);
+                    rt_mq_commit(mq, msg);
+                }
+            }
+        }
+
+        /* drain the queue */
+        for (index = 0; index < BENCH_QUEUE_DEPTH; index ++)
+        {
+            if (mode == BENCH_MODE_COPY)
+            {
+                if (rt_mq_recv(mq, buffer, size, 0) != RT_EOK)
+                {
+                    errors ++;
+                    continue;
+                }
+                recv_sum += bench_sum(buffer, size);
+            }
+            else
+            {
+                if (rt_mq_peek(mq, (void **)&msg, 0) != RT_EOK)
+                {
+                    errors ++;
+                    continue;
+                }
+                recv_sum += bench_sum(msg, size);
+                rt_mq_release(mq, msg);
+            }
+        }
+
+        total += clock_cpu_gettime() - stamp;
+    }
+
+    /* the sum of messages sent, which is not timed */
+    for (index = 0; index < (int)seq; index ++)
+    {
+        bench_build(buffer, size, index);
+        sent_sum += bench_sum(buffer, size);
+    }
+    if (sent_sum != recv_sum)
+        errors ++;
+
+    rt_kprintf("%-10s %5d %8d %9d %6d\n", title, (int)size, seq,
+               seq ? (int)(total * resolution / seq) : 0, errors);
+
+    rt_mq_delete(mq);
+}
+
+static int mq_bench(int argc, char **argv)
+{
+    static const rt_size_t sizes[] = { 16, 64, 256 };
+    int num = 100000, index;
+
+    if (argc > 1)
+        num = atoi(argv[1]);
+    if (num <= 0)
+    {
+        rt_kprintf("Usage: mq_bench [messages]\n");
+        return -RT_EINVAL;
+    }
+
+    rt_kprintf("queue of %d messages\n", BENCH_QUEUE_DEPTH);
+    rt_kprintf("path       size  messages  avg(ns) errors\n");
+    rt_kprintf("---------- ----- -------- --------- ------\n");
+    for (index = 0; index < (int)(sizeof(sizes) / sizeof(sizes[0])); index ++)
+    {
+        bench_run("copy", BENCH_MODE_COPY, sizes[index], num);
+        bench_run("zero-copy", BENCH_MODE_ZERO_COPY, sizes[index], num);
+        bench_run("burst", BENCH_MODE_BURST, sizes[index], num);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(mq_bench, benchmark the message queue with copy and zero-copy. Usage: mq_bench [messages]);
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The benchmark of object lookup by name. The devices of numbered names are
+ * registered, then they are looked up by rt_device_find in random order, and
+ * the names not registered are looked up for the misses. The same lookups
+ * are done by walking the object list of class, as rt_object_find without
+ * the name hash index. It shows the average time of each lookup.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#if defined(RT_USING_DEVICE) && defined(RT_USING_FINSH) && defined(RT_USING_CPUTIME)
+#include <finsh.h>
+
+#define BENCH_LOOKUP_NUM        10000
+
+/* the lookup by walking the object list */
+static rt_object_t bench_list_find(const char *name, rt_uint8_t type)
+{
+    struct rt_object_information *information;
+    struct rt_object *object;
+    struct rt_list_node *node;
+
+    rt_enter_critical();
+    information = rt_object_get_information((enum rt_object_class_type)type);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            rt_exit_critical();
+            return object;
+        }
+    }
+    rt_exit_critical();
+
+    return RT_NULL;
+}
+
+static void bench_run(const char *title, rt_bool_t hash, int num, rt_bool_t hit)
+{
+    char name[RT_NAME_MAX];
+    rt_uint32_t stamp, total = 0;
+    float resolution = clock_cpu_getres();
+    rt_object_t object;
+    int count, errors = 0;
+
+    srand(1);
+    for (count = 0; count < BENCH_LOOKUP_NUM; count ++)
+    {
+        rt_snprintf(name, sizeof(name), hit ? "obj%d" : "nobj%d", rand() % num);
+
+        stamp = clock_cpu_gettime();
+        if (hash)
+            object = (rt_object_t)rt_device_find(name);
+        else
+            object = bench_list_find(name, RT_Object_Class_Device);
+        total += clock_cpu_gettime() - stamp;
+
+        if ((object != RT_NULL) != hit)
+            errors ++;
+    }
+
+    rt_kprintf("%-10s %-4s %9d %6d\n", title, hit ? "hit" : "miss",
+               (int)(total * resolution / BENCH_LOOKUP_NUM), errors);
+}
+
+static int object_bench(int argc, char **argv)
+{
+    struct rt_device *devices;
+    char name[RT_NAME_MAX];
+    int num = 200, index;
+
+    if (argc > 1)
+        num = atoi(argv[1]);
+    /* the names are obj0 to obj9999 */
+    if (num <= 0 || num > 10000)
+    {
+        rt_kprintf("Usage: object_bench [devices, 1-10000]\n");
+        return -RT_EINVAL;
+    }
+
+    devices = (struct rt_device *)rt_calloc(num, sizeof(struct rt_device));
+    if (devices == RT_NULL)
+    {
+        rt_kprintf("no memory for benchmark\n");
+        return -RT_ENOMEM;
+    }
+    for (index = 0; index < num; index ++)
+    {
+        rt_snprintf(name, sizeof(name), "obj%d", index);
+        rt_device_register(&devices[index], name, RT_DEVICE_FLAG_RDWR);
+    }
+
+#ifdef RT_USING_OBJECT_HASH
+    rt_kprintf("%d devices, %d buckets of name hash\n", num, RT_OBJECT_HASH_SIZE);
+#else
+    rt_kprintf("%d devices, no name hash\n", num);
+#endif
+    rt_kprintf("lookup     name avg(ns)   errors\n");
+    rt_kprintf("---------- ---- --------- ------\n");
+    bench_run("find", RT_TRUE, num, RT_TRUE);
+    bench_run("find", RT_TRUE, num, RT_FALSE);
+    bench_run("list walk", RT_FALSE, num, RT_TRUE);
+    bench_run("list walk", RT_FALSE, num, RT_FALSE);
+
+    for (index = 0; index < num; index ++)
+        rt_device_unregister(&devices[index]);
+    rt_free(devices);
+
+    return 0;
+}
+MSH_CMD_EXPORT(object_bench, benchmark the object lookup by name. Usage: object_bench [devices]);
+#endif
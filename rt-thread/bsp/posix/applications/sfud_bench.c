@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The benchmark of SFUD small reads on a simulated SPI NOR flash.
+ * The flash model decodes the commands on a SPI bus of RAM, and it has a
+ * SFDP table, so the flash is probed by rt_sfud_flash_probe as a real one.
+ * The reads of sequential and random address are issued by sfud_read with
+ * the read cache enabled and disabled, and the data is checked with the
+ * model. It shows the read commands, the bytes on bus, the simulated bus
+ * time at 50 MHz and the CPU time.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#if defined(RT_USING_SFUD) && defined(RT_SFUD_USING_READ_CACHE) && defined(RT_USING_FINSH) && defined(RT_USING_CPUTIME)
+#include <finsh.h>
+#include <spi_flash.h>
+#include <spi_flash_sfud.h>
+
+#define SIM_FLASH_SIZE          (1024 * 1024)
+#define SIM_BUS_HZ              (50 * 1000 * 1000)
+/* the overhead of a command on bus, CS setup and driver, in ns */
+#define SIM_CMD_OVERHEAD        2000
+
+#define BENCH_READ_NUM          4096
+
+struct sim_flash
+{
+    rt_uint8_t data[SIM_FLASH_SIZE];
+    rt_uint8_t cmd[5 + 256];
+    rt_size_t cmd_len;
+    rt_bool_t wel;
+
+    rt_uint32_t read_cmds;
+    rt_uint32_t bus_bytes;
+};
+
+static struct rt_spi_bus sim_bus;
+static struct rt_spi_device sim_device;
+static struct sim_flash *sim;
+static rt_spi_flash_device_t sim_dev;
+
+/* SFDP header, basic parameter header and the basic parameter table of JESD216 */
+static const rt_uint8_t sim_sfdp[] =
+{
+    'S', 'F', 'D', 'P', 0x00, 0x01, 0x00, 0xFF,
+    0x00, 0x00, 0x01, 0x09, 0x10, 0x00, 0x00, 0xFF,
+    /* 4 KB erase 20h, 1-1-2, 1-2-2, 1-4-4 and 1-1-4 fast read, 3-byte address */
+    0xE5, 0x20, 0xF1, 0xFF,
+    /* 8 Mbit */
+    0xFF, 0xFF, 0x7F, 0x00,
+    /* 1-4-4 EBh 4 wait states 2 mode clocks, 1-1-4 6Bh 8 wait states */
+    0x44, 0xEB, 0x08, 0x6B,
+    /* 1-1-2 3Bh 8 wait states, 1-2-2 BBh 4 mode clocks */
+    0x08, 0x3B, 0x80, 0xBB,
+    0xEE, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x00, 0x00,
+    0xFF, 0xFF, 0x00, 0x00,
+    /* 4 KB 20h, 32 KB 52h, 64 KB D8h erase */
+    0x0C, 0x20, 0x0F, 0x52,
+    0x10, 0xD8, 0x00, 0x00,
+};
+
+static rt_uint32_t sim_addr(void)
+{
+    return (sim->cmd[1] << 16) | (sim->cmd[2] << 8) | sim->cmd[3];
+}
+
+/* the command with data out of flash */
+static void sim_read(rt_uint8_t *buf, rt_size_t length)
+{
+    rt_uint32_t addr = sim_addr();
+    rt_size_t index;
+
+    for (index = 0; index < length; index ++)
+    {
+        switch (sim->cmd[0])
+        {
+        case 0x9F:
+            buf[index] = index == 0 ? 0xEF : (index == 1 ? 0x40 : 0x14);
+            break;
+        case 0x5A:
+            buf[index] = addr + index < sizeof(sim_sfdp) ? sim_sfdp[addr + index] : 0xFF;
+            break;
+        case 0x05:
+            buf[index] = sim->wel ? 0x02 : 0x00;
+            break;
+        case 0x03:
+            buf[index] = sim->data[(addr + index) % SIM_FLASH_SIZE];
+            break;
+        default:
+            buf[index] = 0xFF;
+            break;
+        }
+    }
+
+    if (sim->cmd[0] == 0x03)
+        sim->read_cmds ++;
+}
+
+/* the command without data out, it runs at the release of CS */
+static void sim_write(void)
+{
+    rt_uint32_t addr = sim_addr(), size = 0;
+    rt_size_t index;
+
+    switch (sim->cmd[0])
+    {
+    case 0x06:
+        sim->wel = RT_TRUE;
+        return;
+    case 0x04:
+        sim->wel = RT_FALSE;
+        return;
+    case 0x02:
+        if (!sim->wel) return;
+        /* the page program wraps in the page */
+        for (index = 4; index < sim->cmd_len; index ++)
+            sim->data[(addr & ~0xFF) | ((addr + index - 4) & 0xFF)] &= sim->cmd[index];
+        break;
+    case 0x20:
+        size = 4096;
+        break;
+    case 0x52:
+        size = 32 * 1024;
+        break;
+    case 0xD8:
+        size = 64 * 1024;
+        break;
+    case 0xC7:
+    case 0x60:
+        addr = 0;
+        size = SIM_FLASH_SIZE;
+        break;
+    default:
+        return;
+    }
+
+    if (!sim->wel) return;
+    if (size)
+        rt_memset(&sim->data[addr & ~(size - 1) & (SIM_FLASH_SIZE - 1)], 0xFF, size);
+    sim->wel = RT_FALSE;
+}
+
+static rt_err_t sim_configure(struct rt_spi_device *device, struct rt_spi_configuration *configuration)
+{
+    return RT_EOK;
+}
+
+static rt_uint32_t sim_xfer(struct rt_spi_device *device, struct rt_spi_message *message)
+{
+    const rt_uint8_t *send_buf = message->send_buf;
+    rt_size_t index;
+
+    if (message->cs_take)
+        sim->cmd_len = 0;
+
+    if (send_buf)
+    {
+        for (index = 0; index < message->length && sim->cmd_len < sizeof(sim->cmd); index ++)
+            sim->cmd[sim->cmd_len ++] = send_buf[index];
+    }
+    if (message->recv_buf && !send_buf)
+        sim_read(message->recv_buf, message->length);
+
+    sim->bus_bytes += message->length;
+    if (message->cs_release && !message->recv_buf)
+        sim_write();
+
+    return message->length;
+}
+
+static const struct rt_spi_ops sim_ops =
+{
+    sim_configure,
+    sim_xfer,
+};
+
+static int sim_flash_init(void)
+{
+    rt_size_t index;
+
+    if (sim_dev != RT_NULL)
+        return RT_EOK;
+
+    sim = (struct sim_flash *)rt_malloc(sizeof(struct sim_flash));
+    if (sim == RT_NULL)
+        return -RT_ENOMEM;
+    rt_memset(sim, 0, sizeof(struct sim_flash));
+    srand(1);
+    for (index = 0; index < SIM_FLASH_SIZE; index ++)
+        sim->data[index] = rand();
+
+    rt_spi_bus_register(&sim_bus, "sfsim", &sim_ops);
+    rt_spi_bus_attach_device(&sim_device, "sfsim0", "sfsim", RT_NULL);
+
+    sim_dev = rt_sfud_flash_probe("sfsim", "sfsim0");
+    if (sim_dev == RT_NULL)
+        return -RT_ERROR;
+
+    return RT_EOK;
+}
+
+static void bench_run(const char *title, sfud_flash *flash, rt_bool_t cache, int range, rt_size_t size)
+{
+    rt_uint8_t buf[256];
+    rt_uint32_t addr, stamp, cpu_time = 0;
+    rt_uint32_t read_cmds, bus_bytes;
+    float resolution = clock_cpu_getres();
+    int count, errors = 0;
+
+    sfud_read_cache_enable(flash, cache);
+    sim->read_cmds = 0;
+    sim->bus_bytes = 0;
+    srand(2);
+
+    for (count = 0, addr = 0; count < BENCH_READ_NUM; count ++)
+    {
+        if (range)
+            addr = (rand() % (range - size)) & ~3;
+
+        stamp = clock_cpu_gettime();
+        sfud_read(flash, addr, size, buf);
+        cpu_time += clock_cpu_gettime() - stamp;
+
+        if (rt_memcmp(buf, &sim->data[addr], size) != 0)
+            errors ++;
+
+        if (range == 0)
+            addr = (addr + size) % (SIM_FLASH_SIZE - size);
+    }
+
+    read_cmds = sim->read_cmds;
+    bus_bytes = sim->bus_bytes;
+    rt_kprintf("%-12s %-5s %6d %8d %8d %8d %6d\n", title, cache ? "yes" : "no",
+               read_cmds, bus_bytes,
+               (int)(((float)read_cmds * SIM_CMD_OVERHEAD + (float)bus_bytes * 8 * 1000 * 1000 * 1000 / SIM_BUS_HZ) / 1000),
+               (int)(cpu_time * resolution / 1000), errors);
+}
+
+/* the data read after erase and write is not stale */
+static int bench_verify(sfud_flash *flash)
+{
+    rt_uint8_t data[64], buf[64];
+    rt_size_t index;
+
+    sfud_read_cache_enable(flash, RT_TRUE);
+    sfud_read(flash, 0x2000, sizeof(buf), buf);
+
+    sfud_erase(flash, 0x2000, 4096);
+    sfud_read(flash, 0x2000, sizeof(buf), buf);
+    for (index = 0; index < sizeof(buf); index ++)
+        if (buf[index] != 0xFF) return -RT_ERROR;
+
+    for (index = 0; index < sizeof(data); index ++)
+        data[index] = index;
+    sfud_write(flash, 0x2010, sizeof(data), data);
+    sfud_read(flash, 0x2010, sizeof(buf), buf);
+
+    return rt_memcmp(buf, data, sizeof(data)) == 0 ? RT_EOK : -RT_ERROR;
+}
+
+static int sfud_bench(int argc, char **argv)
+{
+    rt_size_t size = 16;
+    sfud_flash *flash;
+
+    if (argc > 1)
+        size = atoi(argv[1]);
+    if (size == 0 || size > 256)
+    {
+        rt_kprintf("Usage: sfud_bench [read size, 1-256]\n");
+        return -RT_EINVAL;
+    }
+
+    if (sim_flash_init() != RT_EOK)
+    {
+        rt_kprintf("simulated flash probe failed\n");
+        return -RT_ERROR;
+    }
+    flash = (sfud_flash *)sim_dev->user_data;
+
+#ifdef SFUD_USING_SFDP
+    {
+        static const char *name[] = { "1-1-2", "1-2-2", "1-1-4", "1-4-4" };
+        int type;
+
+        rt_kprintf("SFDP fast read:");
+        for (type = 0; type < SFUD_SFDP_FAST_READ_TYPE_MAX_NUM; type ++)
+        {
+            if (flash->sfdp.fast_read[type].cmd)
+                rt_kprintf(" %s %02Xh/%d", name[type], flash->sfdp.fast_read[type].cmd,
+                           flash->sfdp.fast_read[type].dummy_cycles);
+        }
+        rt_kprintf("\n");
+    }
+#endif
+
+    rt_kprintf("%d reads of %d bytes, %d lines of cache\n", BENCH_READ_NUM, size, SFUD_READ_CACHE_LINE_NUM);
+    rt_kprintf("pattern      cache  cmds   bus(B)   bus(us)  cpu(us) errors\n");
+    rt_kprintf("------------ ----- ------ -------- -------- -------- ------\n");
+    bench_run("sequential", flash, RT_FALSE, 0, size);
+    bench_run("sequential", flash, RT_TRUE, 0, size);
+    bench_run("random 4K", flash, RT_FALSE, 4096, size);
+    bench_run("random 4K", flash, RT_TRUE, 4096, size);
+    bench_run("random 1M", flash, RT_FALSE, SIM_FLASH_SIZE, size);
+    bench_run("random 1M", flash, RT_TRUE, SIM_FLASH_SIZE, size);
+    rt_kprintf("hits %d, misses %d, write and erase coherence %s\n",
+               flash->read_cache.hits, flash->read_cache.misses,
+               bench_verify(flash) == RT_EOK ? "ok" : "failed");
+
+    return 0;
+}
+MSH_CMD_EXPORT(sfud_bench, benchmark the small reads of SFUD on simulated flash. Usage: sfud_bench [read size]);
+#endif
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The test of asynchronous SPI message queue on a simulated bus. The bus
+ * starts the messages of even length by xfer_start like DMA, and a periodic
+ * hard timer completes them in the tick interrupt. The messages of odd length
+ * are rejected by xfer_start, and transferred by xfer. Three cases are run:
+ * the requests of devices in different priorities are queued while the bus
+ * is locked, and they shall complete in the priority of device and FIFO in
+ * the same priority; the messages of a request shall be chained in ISR; and
+ * the message rejected by xfer_start shall be transferred by xfer in the
+ * thread, between the ones in DMA.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#if defined(RT_USING_SPI_ASYNC) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define SIM_DEVICE_NUM          4
+#define SIM_LOG_NUM             16
+#define TEST_REQUEST_NUM        5
+
+#define SIM_XFER_DMA            'd'
+#define SIM_XFER_CPU            'x'
+
+struct sim_log
+{
+    const void *send_buf;
+    char how;
+    rt_bool_t isr;
+};
+
+struct sim_spi
+{
+    struct rt_spi_bus bus;
+    struct rt_spi_device devices[SIM_DEVICE_NUM];
+    struct rt_timer dma_timer;
+    rt_bool_t inited;
+
+    /* the message in DMA, it's completed by the next tick */
+    volatile rt_bool_t dma_busy;
+
+    struct sim_log log[SIM_LOG_NUM];
+    int log_num;
+    int rejects;
+};
+
+static struct sim_spi sim;
+static struct rt_semaphore test_done;
+
+/* the requests in the order of completion */
+static struct rt_spi_request *test_order[TEST_REQUEST_NUM];
+static int test_order_num;
+
+static void sim_log(struct rt_spi_message *message, char how)
+{
+    if (sim.log_num < SIM_LOG_NUM)
+    {
+        sim.log[sim.log_num].send_buf = message->send_buf;
+        sim.log[sim.log_num].how = how;
+        sim.log[sim.log_num].isr = rt_interrupt_get_nest() > 0;
+        sim.log_num ++;
+    }
+}
+
+static rt_err_t sim_configure(struct rt_spi_device *device, struct rt_spi_configuration *configuration)
+{
+    return RT_EOK;
+}
+
+static rt_uint32_t sim_xfer(struct rt_spi_device *device, struct rt_spi_message *message)
+{
+    sim_log(message, SIM_XFER_CPU);
+
+    return message->length;
+}
+
+static rt_err_t sim_xfer_start(struct rt_spi_device *device, struct rt_spi_message *message)
+{
+    /* no DMA for the message of odd length */
+    if (message->length & 0x01)
+    {
+        sim.rejects ++;
+        return -RT_ENOSYS;
+    }
+
+    sim_log(message, SIM_XFER_DMA);
+    sim.dma_busy = RT_TRUE;
+
+    return RT_EOK;
+}
+
+static const struct rt_spi_ops sim_ops =
+{
+    sim_configure,
+    sim_xfer,
+    sim_xfer_start,
+};
+
+/* the interrupt of DMA completion */
+static void sim_dma_timeout(void *parameter)
+{
+    if (sim.dma_busy)
+    {
+        sim.dma_busy = RT_FALSE;
+        rt_spi_bus_xfer_done(&sim.bus, RT_EOK);
+    }
+}
+
+static int sim_spi_init(void)
+{
+    char name[RT_NAME_MAX];
+    int index;
+
+    if (sim.inited)
+        return RT_EOK;
+
+    if (rt_spi_bus_register(&sim.bus, "sasim", &sim_ops) != RT_EOK)
+        return -RT_ERROR;
+    for (index = 0; index < SIM_DEVICE_NUM; index ++)
+    {
+        rt_snprintf(name, sizeof(name), "sasim%d", index);
+        if (rt_spi_bus_attach_device(&sim.devices[index], name, "sasim", RT_NULL) != RT_EOK)
+            return -RT_ERROR;
+    }
+    rt_timer_init(&sim.dma_timer, "sadma", sim_dma_timeout, RT_NULL, 1,
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    sim.inited = RT_TRUE;
+
+    return RT_EOK;
+}
+
+static void test_complete(struct rt_spi_request *request)
+{
+    if (test_order_num < TEST_REQUEST_NUM)
+        test_order[test_order_num ++] = request;
+
+    rt_sem_release(&test_done);
+}
+
+static void test_request_init(struct rt_spi_request *request, struct rt_spi_message *message)
+{
+    rt_memset(request, 0, sizeof(struct rt_spi_request));
+    request->message  = message;
+    request->complete = test_complete;
+}
+
+static void test_message_init(struct rt_spi_message *message, const void *send_buf, rt_size_t length,
+                              struct rt_spi_message *next)
+{
+    rt_memset(message, 0, sizeof(struct rt_spi_message));
+    message->send_buf   = send_buf;
+    message->length     = length;
+    message->cs_take    = 1;
+    message->cs_release = 1;
+    message->next       = next;
+}
+
+static int test_wait(int num)
+{
+    int errors = 0;
+
+    while (num --)
+    {
+        if (rt_sem_take(&test_done, RT_TICK_PER_SECOND) != RT_EOK)
+            errors ++;
+    }
+
+    return errors;
+}
+
+/* the log shall be the messages in order, in the way and context expected */
+static int test_check_log(struct rt_spi_message *messages, const char *hows, const char *isrs)
+{
+    int index, errors = 0;
+
+    for (index = 0; hows[index] != '\0'; index ++)
+    {
+        if (index >= sim.log_num || sim.log[index].send_buf != messages[index].send_buf ||
+                sim.log[index].how != hows[index] || sim.log[index].isr != (isrs[index] == '1'))
+            errors ++;
+    }
+    if (sim.log_num != index)
+        errors ++;
+
+    return errors;
+}
+
+static void test_reset(void)
+{
+    rt_memset(sim.log, 0, sizeof(sim.log));
+    sim.log_num = 0;
+    sim.rejects = 0;
+    test_order_num = 0;
+}
+
+/* the requests complete in the priority of device, and FIFO in the same priority */
+static int test_priority(void)
+{
+    static const rt_uint8_t priorities[SIM_DEVICE_NUM] = {20, 5, 20, RT_SPI_PRIORITY_DEFAULT};
+    /* the requests of device 0, 0, 2, 1, 3 */
+    static const int devices[TEST_REQUEST_NUM] = {0, 0, 2, 1, 3};
+    static const int expected[TEST_REQUEST_NUM] = {3, 4, 0, 1, 2};
+    struct rt_spi_request requests[TEST_REQUEST_NUM];
+    struct rt_spi_message messages[TEST_REQUEST_NUM];
+    rt_uint8_t buf[TEST_REQUEST_NUM][2];
+    int index, errors = 0;
+
+    test_reset();
+    for (index = 0; index < SIM_DEVICE_NUM; index ++)
+        rt_spi_set_priority(&sim.devices[index], priorities[index]);
+
+    /* the async thread waits for the bus until all of requests are queued */
+    rt_mutex_take(&sim.bus.lock, RT_WAITING_FOREVER);
+    for (index = 0; index < TEST_REQUEST_NUM; index ++)
+    {
+        test_message_init(&messages[index], buf[index], sizeof(buf[index]), RT_NULL);
+        test_request_init(&requests[index], &messages[index]);
+        if (rt_spi_transfer_message_async(&sim.devices[devices[index]], &requests[index]) != RT_EOK)
+            errors ++;
+    }
+    rt_mutex_release(&sim.bus.lock);
+    errors += test_wait(TEST_REQUEST_NUM);
+
+    for (index = 0; index < TEST_REQUEST_NUM; index ++)
+    {
+        if (index >= test_order_num || test_order[index] != &requests[expected[index]] ||
+                test_order[index]->result != RT_EOK)
+            errors ++;
+    }
+    rt_kprintf("%-10s %d requests, completed %d, errors %d\n", "priority", TEST_REQUEST_NUM,
+               test_order_num, errors);
+
+    return errors;
+}
+
+/* the messages of a request are chained in ISR, or by xfer in thread if rejected */
+static int test_chain(const char *title, const rt_size_t *lengths, const char *hows, const char *isrs,
+                      int rejects)
+{
+    struct rt_spi_request request;
+    struct rt_spi_message messages[3];
+    rt_uint8_t buf[3][3];
+    int index, errors = 0;
+
+    test_reset();
+    for (index = 2; index >= 0; index --)
+        test_message_init(&messages[index], buf[index], lengths[index], index < 2 ? &messages[index + 1] : RT_NULL);
+    test_request_init(&request, &messages[0]);
+
+    if (rt_spi_transfer_message_async(&sim.devices[0], &request) != RT_EOK)
+        errors ++;
+    errors += test_wait(1);
+
+    if (request.result != RT_EOK)
+        errors ++;
+    errors += test_check_log(messages, hows, isrs);
+    if (sim.rejects != rejects)
+        errors ++;
+    rt_kprintf("%-10s %d messages, transferred %d, rejected %d, errors %d\n", title, 3,
+               sim.log_num, sim.rejects, errors);
+
+    return errors;
+}
+
+static int spi_async_test(int argc, char **argv)
+{
+    static const rt_size_t chain_lengths[3] = {2, 2, 2};
+    static const rt_size_t fallback_lengths[3] = {2, 3, 2};
+    int errors = 0;
+
+    if (sim_spi_init() != RT_EOK)
+    {
+        rt_kprintf("init simulated SPI bus failed\n");
+        return -RT_ERROR;
+    }
+    rt_sem_init(&test_done, "satest", 0, RT_IPC_FLAG_FIFO);
+    rt_timer_start(&sim.dma_timer);
+
+    errors += test_priority();
+    /* the first message is started by thread, the others in ISR */
+    errors += test_chain("chain", chain_lengths, "ddd", "011", 0);
+    /* the second one is rejected in ISR and in thread, then transferred by xfer */
+    errors += test_chain("fallback", fallback_lengths, "dxd", "000", 2);
+    rt_kprintf("spi async test %s\n", errors == 0 ? "passed" : "failed");
+
+    rt_timer_stop(&sim.dma_timer);
+    rt_sem_detach(&test_done);
+
+    return 0;
+}
+MSH_CMD_EXPORT(spi_async_test, test the asynchronous SPI message queue);
+#endif
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The stress test of the SPSC ring buffer. The producer is a host thread,
+ * which runs on the other CPU of host as an ISR or a DMA does, and the
+ * consumer is the thread of the command. The producer puts a known byte
+ * stream in chunks of random length by put, putchar and reserve/commit, and
+ * the consumer gets it by get, getchar and peek/consume, and checks each
+ * byte. The buffer size is odd by default, so the spans wrap at any offset.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdlib.h>
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define TEST_CHUNK_MAX          64
+
+struct spsc_test
+{
+    struct rt_ringbuffer_spsc rb;
+    rt_uint32_t total;
+    /* the calls of producer wait for space */
+    volatile rt_uint32_t full;
+};
+
+static struct spsc_test test;
+
+/* the byte of stream at the position */
+static rt_uint8_t test_byte(rt_uint32_t position)
+{
+    return (rt_uint8_t)(position ^ (position >> 8) ^ (position >> 16) ^ (position >> 24));
+}
+
+static void *test_producer(void *parameter)
+{
+    rt_uint8_t chunk[TEST_CHUNK_MAX], *ptr;
+    rt_uint32_t position = 0, length, index;
+    unsigned int seed = 1;
+
+    while (position < test.total)
+    {
+        length = 1 + rand_r(&seed) % TEST_CHUNK_MAX;
+        if (length > test.total - position)
+            length = test.total - position;
+
+        switch (rand_r(&seed) % 3)
+        {
+        case 0:
+            for (index = 0; index < length; index ++)
+                chunk[index] = test_byte(position + index);
+            length = rt_ringbuffer_spsc_put(&test.rb, chunk, length);
+            break;
+        case 1:
+            length = rt_ringbuffer_spsc_putchar(&test.rb, test_byte(position));
+            break;
+        default:
+            index = rt_ringbuffer_spsc_reserve(&test.rb, &ptr);
+            if (length > index)
+                length = index;
+            for (index = 0; index < length; index ++)
+                ptr[index] = test_byte(position + index);
+            rt_ringbuffer_spsc_commit(&test.rb, length);
+            break;
+        }
+
+        if (length == 0)
+        {
+            /* let the consumer run if the host has only one CPU */
+            test.full ++;
+            sched_yield();
+        }
+        position += length;
+    }
+
+    return RT_NULL;
+}
+
+static int spsc_test(int argc, char **argv)
+{
+    rt_uint8_t chunk[TEST_CHUNK_MAX], *pool, *ptr;
+    rt_uint32_t size = 1021, position = 0, length, index, errors = 0, empty = 0;
+    rt_tick_t stamp;
+    unsigned int seed = 2;
+    pthread_t producer;
+    sigset_t set, old;
+    int result;
+
+    test.total = 64 * 1024 * 1024;
+    if (argc > 1)
+        test.total = atoi(argv[1]) * 1024 * 1024;
+    if (argc > 2)
+        size = atoi(argv[2]);
+    if (test.total == 0 || size == 0)
+    {
+        rt_kprintf("Usage: spsc_test [MB] [buffer size]\n");
+        return -RT_EINVAL;
+    }
+
+    pool = (rt_uint8_t *)rt_malloc(size);
+    if (pool == RT_NULL)
+    {
+        rt_kprintf("no memory for test\n");
+        return -RT_ENOMEM;
+    }
+    rt_ringbuffer_spsc_init(&test.rb, pool, size);
+    test.full = 0;
+
+    /* the host thread never handles the signals of interrupt */
+    sigfillset(&set);
+    pthread_sigmask(SIG_BLOCK, &set, &old);
+    stamp = rt_tick_get();
+    result = pthread_create(&producer, RT_NULL, test_producer, RT_NULL);
+    pthread_sigmask(SIG_SETMASK, &old, RT_NULL);
+    if (result != 0)
+    {
+        rt_kprintf("create producer failed\n");
+        rt_free(pool);
+        return -RT_ERROR;
+    }
+
+    while (position < test.total)
+    {
+        length = 1 + rand_r(&seed) % TEST_CHUNK_MAX;
+
+        switch (rand_r(&seed) % 3)
+        {
+        case 0:
+            length = rt_ringbuffer_spsc_get(&test.rb, chunk, length);
+            ptr = chunk;
+            break;
+        case 1:
+            length = rt_ringbuffer_spsc_getchar(&test.rb, chunk);
+            ptr = chunk;
+            break;
+        default:
+            index = rt_ringbuffer_spsc_peek(&test.rb, &ptr);
+            if (length > index)
+                length = index;
+            break;
+        }
+
+        for (index = 0; index < length; index ++)
+        {
+            if (ptr[index] != test_byte(position + index))
+                errors ++;
+        }
+        if (ptr != chunk)
+            rt_ringbuffer_spsc_consume(&test.rb, length);
+
+        if (length == 0)
+        {
+            empty ++;
+            sched_yield();
+        }
+        position += length;
+    }
+    pthread_join(producer, RT_NULL);
+
+    rt_kprintf("%d MB through %d bytes buffer in %d ms, full %d, empty %d, errors %d: %s\n",
+               test.total / (1024 * 1024), size,
+               (int)((rt_tick_get() - stamp) * 1000 / RT_TICK_PER_SECOND), test.full, empty, errors,
+               (errors == 0 && rt_ringbuffer_spsc_data_len(&test.rb) == 0) ? "passed" : "failed");
+    rt_free(pool);
+
+    return 0;
+}
+MSH_CMD_EXPORT(spsc_test, stress test of SPSC ring buffer. Usage: spsc_test [MB] [buffer size]);
+#endif
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    run the tickless idle with the STM32 driver
+ */
+
+/*
+ * The test of tickless idle on a simulated SysTick. The tickless sleep of
+ * STM32 driver is built here on the simulated SysTick and SCB registers, and
+ * it's invoked by the idle thread. The clock model is a 24 bits down counter
+ * like SysTick: it takes LOAD on the count after it reaches 0, and it raises
+ * the interrupt when it counts from 1 to 0. While the test runs, the tick
+ * interrupt of host runs the simulated clock for a random time instead of
+ * one tick, and the interrupts of SysTick count the system tick. The thread
+ * of the command delays for random ticks, so the idle thread sleeps, and the
+ * sleep is woken up by the expiry or by other interrupt at a random count.
+ * After each delay, the system tick shall be the ticks of the simulated time,
+ * and the interrupts of SysTick shall stay on the tick boundaries.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <board.h>
+#include <stdlib.h>
+
+#ifdef RT_USING_TICKLESS
+
+/* the SysTick counts of one tick for HCLK 168 MHz / 8 and 1000 ticks per second */
+#define SIM_CYCLES_PER_TICK     21000
+
+struct sim_systick_regs
+{
+    volatile rt_uint32_t CTRL;
+    volatile rt_uint32_t LOAD;
+    volatile rt_uint32_t VAL;
+    volatile rt_uint32_t CALIB;
+};
+
+struct sim_scb_regs
+{
+    volatile rt_uint32_t ICSR;
+};
+
+struct sim_systick
+{
+    struct sim_systick_regs regs;               /* the registers accessed by the driver */
+    struct sim_systick_regs shadow;             /* the registers published to the driver */
+    struct sim_scb_regs scb;
+
+    rt_uint32_t load;
+    rt_uint32_t val;
+    rt_bool_t enabled;
+    rt_bool_t countflag;
+    rt_bool_t pending;
+    rt_bool_t running;                          /* the clock is simulated in the test */
+
+    rt_uint64_t now;                            /* the simulated time in counts */
+    rt_uint32_t cycles;                         /* the HCLK cycles of register accesses */
+    rt_uint32_t sleeps;                         /* the sleeps of driver */
+    rt_uint32_t expiries;                       /* the sleeps woken up by the expiry */
+    rt_uint32_t phase_errors;                   /* the interrupts not on the tick boundary */
+};
+
+static struct sim_systick sim;
+
+/* the interrupt of SysTick counts a tick if irq is enabled */
+static void sim_deliver(rt_bool_t irq)
+{
+    if (irq && sim.pending)
+    {
+        sim.pending = RT_FALSE;
+        rt_tick_increase();
+    }
+}
+
+/* run the clock for counts */
+static void sim_run(rt_uint32_t counts, rt_bool_t irq)
+{
+    rt_uint32_t step;
+
+    sim_deliver(irq);
+    while (counts)
+    {
+        if (!sim.enabled)
+        {
+            sim.now += counts;
+            break;
+        }
+
+        if (sim.val == 0)
+        {
+            /* take the LOAD */
+            sim.val = sim.load;
+            step = 1;
+        }
+        else
+        {
+            step = counts < sim.val ? counts : sim.val;
+            sim.val -= step;
+        }
+        sim.now += step;
+        counts -= step;
+
+        if (step && sim.val == 0 && sim.load != 0)
+        {
+            sim.countflag = RT_TRUE;
+            sim.pending = RT_TRUE;
+            if (sim.now % SIM_CYCLES_PER_TICK)
+                sim.phase_errors ++;
+        }
+        sim_deliver(irq);
+    }
+}
+
+/* take the registers written by the driver since the last access */
+static void sim_take_writes(void)
+{
+    if (sim.regs.LOAD != sim.shadow.LOAD)
+        sim.load = sim.regs.LOAD & 0xFFFFFF;
+    /* writing VAL clears it and the COUNTFLAG */
+    if (sim.regs.VAL != sim.shadow.VAL)
+    {
+        sim.val = 0;
+        sim.countflag = RT_FALSE;
+    }
+    sim.enabled = (sim.regs.CTRL & 0x01) ? RT_TRUE : RT_FALSE;
+    sim.shadow = sim.regs;
+}
+
+static struct sim_systick_regs *sim_systick_access(void)
+{
+    if (!sim.running)
+        return &sim.regs;
+
+    sim_take_writes();
+    /* the counter runs on HCLK/8, and each access takes one HCLK cycle */
+    if (sim.enabled && ++ sim.cycles % 8 == 0)
+        sim_run(1, RT_FALSE);
+
+    /* any access is taken as reading CTRL, which clears the COUNTFLAG */
+    sim.regs.CTRL = (sim.enabled ? 0x01 : 0) | (sim.countflag ? (1UL << 16) : 0);
+    sim.regs.LOAD = sim.load;
+    sim.regs.VAL  = sim.val;
+    sim.shadow    = sim.regs;
+    sim.countflag = RT_FALSE;
+
+    return &sim.regs;
+}
+
+static struct sim_scb_regs *sim_scb_access(void)
+{
+    /* out of the test, a tick is always pending to keep the periodic tick of host */
+    sim.scb.ICSR = (!sim.running || sim.pending) ? (1UL << 26) : 0;
+
+    return &sim.scb;
+}
+
+/* sleep until the expiry or other interrupt, and the wakeup latency */
+static void sim_wfi(void)
+{
+    rt_uint32_t counts;
+
+    if (!sim.running)
+        return;
+
+    sim_take_writes();
+    sim.sleeps ++;
+
+    counts = sim.val ? sim.val : sim.load + 1;
+    if (counts > 1 && rand() % 2)
+    {
+        sim_run(1 + rand() % (counts - 1), RT_FALSE);
+    }
+    else
+    {
+        sim_run(counts, RT_FALSE);
+        sim.expiries ++;
+    }
+    sim_run(rand() % (SIM_CYCLES_PER_TICK / 4), RT_FALSE);
+}
+
+/* the CMSIS of the simulated SysTick for the driver */
+#define SysTick                         (sim_systick_access())
+#define SCB                             (sim_scb_access())
+#define SysTick_CTRL_ENABLE_Msk         (1UL << 0)
+#define SysTick_CTRL_COUNTFLAG_Msk      (1UL << 16)
+#define SysTick_LOAD_RELOAD_Msk         (0xFFFFFFUL)
+#define SCB_ICSR_PENDSTSET_Msk          (1UL << 26)
+#define __DSB()
+#define __ISB()
+#define __WFI()                         sim_wfi()
+
+/* the tickless sleep of STM32 driver */
+#include "../../../../libraries/HAL_Drivers/drv_tickless.c"
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+/* the tick interrupt of host runs the simulated clock for a while */
+static void sim_tick_isr(int vector, void *param)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    /* the registers written at the end of sleep */
+    sim_take_writes();
+    sim_run(rand() % (2 * SIM_CYCLES_PER_TICK), RT_TRUE);
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+static int tickless_test(int argc, char **argv)
+{
+    rt_uint32_t count, num = 1000, tick_errors = 0;
+    rt_tick_t start_tick, delay_tick, timeout_tick;
+    rt_uint64_t sleep_ticks = 0;
+    rt_isr_handler_t tick_isr;
+    rt_base_t level;
+
+    if (argc > 1)
+        num = atoi(argv[1]);
+    if (num == 0)
+        num = 1;
+    srand(1);
+
+    /* start the simulated clock on a tick boundary */
+    level = rt_hw_interrupt_disable();
+    rt_memset(&sim, 0, sizeof(sim));
+    sim.load = SIM_CYCLES_PER_TICK - 1;
+    sim.enabled = RT_TRUE;
+    sim.regs.CTRL = SysTick_CTRL_ENABLE_Msk;
+    sim.regs.LOAD = sim.load;
+    sim.shadow = sim.regs;
+    sim.running = RT_TRUE;
+    start_tick = rt_tick_get();
+    tick_isr = rt_hw_interrupt_install(POSIX_IRQ_TICK, sim_tick_isr, RT_NULL, "tick");
+    rt_hw_interrupt_enable(level);
+
+    for (count = 0; count < num; count ++)
+    {
+        /* the idle thread sleeps until the delay expires */
+        timeout_tick = 2 + rand() % 1000;
+        delay_tick = rt_tick_get();
+        rt_thread_delay(timeout_tick);
+        sleep_ticks += timeout_tick;
+
+        level = rt_hw_interrupt_disable();
+        if (rt_tick_get() - delay_tick < timeout_tick)
+            tick_errors ++;
+        /* the pending interrupt counts a tick */
+        if (rt_tick_get() - start_tick + (sim.pending ? 1 : 0) != sim.now / SIM_CYCLES_PER_TICK)
+            tick_errors ++;
+        rt_hw_interrupt_enable(level);
+    }
+
+    level = rt_hw_interrupt_disable();
+    sim.running = RT_FALSE;
+    rt_hw_interrupt_install(POSIX_IRQ_TICK, tick_isr, RT_NULL, "tick");
+    rt_hw_interrupt_enable(level);
+
+    rt_kprintf("%d delays of %d ticks on average, %d simulated ticks\n", num,
+               (int)(sleep_ticks / num), (int)(sim.now / SIM_CYCLES_PER_TICK));
+    rt_kprintf("%d sleeps, %d woken up by expiry\n", sim.sleeps, sim.expiries);
+    rt_kprintf("tick errors %d, phase errors %d: %s\n", tick_errors, sim.phase_errors,
+               (tick_errors == 0 && sim.phase_errors == 0 && sim.sleeps != 0) ? "passed" : "failed");
+
+    return 0;
+}
+MSH_CMD_EXPORT(tickless_test, test tickless idle on simulated SysTick. Usage: tickless_test [delays]);
+#endif /* RT_USING_FINSH */
+#endif /* RT_USING_TICKLESS */
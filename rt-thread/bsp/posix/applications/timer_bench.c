@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    10000 timers, the time of interrupt disabled
+ */
+
+/*
+ * The benchmark of timer insert and expire. The timers of random timeout
+ * are started and stopped while the number of active timers grows, then the
+ * timers of the same timeout expire in one tick, and the timers of random
+ * timeout expire in the following ticks. It shows the average time of start,
+ * stop and expire, and the lateness of the timers, for the timing wheel or
+ * the sorted timer list. With RT_USING_IRQ_LATENCY, it also shows the
+ * maximal time of interrupt disabled in rt_timer_start, rt_timer_stop and
+ * rt_timer_check.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#if defined(RT_USING_FINSH) && defined(RT_USING_CPUTIME)
+#include <finsh.h>
+
+#define BENCH_EXPIRE_TICKS      100
+
+#if defined(RT_USING_TIMER_WHEEL) && !defined(RT_TIMER_WHEEL_BITS)
+#define RT_TIMER_WHEEL_BITS     4
+#endif
+
+struct bench_expire
+{
+    rt_uint32_t count;
+    rt_uint32_t late;
+    rt_uint32_t first;
+    rt_uint32_t last;
+};
+
+static struct bench_expire bench_expire;
+
+static void bench_timeout(void *parameter)
+{
+    rt_uint32_t stamp = clock_cpu_gettime();
+    rt_tick_t expected = (rt_tick_t)(rt_ubase_t)parameter;
+
+    if (bench_expire.count == 0)
+        bench_expire.first = stamp;
+    bench_expire.last = stamp;
+    bench_expire.count ++;
+
+    if (rt_tick_get() - expected > bench_expire.late)
+        bench_expire.late = rt_tick_get() - expected;
+}
+
+/* show the maximal time of interrupt disabled in the function */
+static void bench_show_irq_off(const char *func, float resolution)
+{
+#ifdef RT_USING_IRQ_LATENCY
+    rt_uint32_t max;
+
+    rt_irq_latency_get_func(func, &max);
+    rt_kprintf(" %11d", (int)(max * resolution));
+#else
+    rt_kprintf(" %11s", "-");
+#endif
+}
+
+/* clear the time of interrupt disabled */
+static void bench_reset_irq_off(void)
+{
+#ifdef RT_USING_IRQ_LATENCY
+    rt_irq_latency_reset();
+#endif
+}
+
+/* start the timers with timeout of [base, base + range) ticks, and return the total time */
+static rt_uint32_t bench_start(struct rt_timer *timers, int num, rt_tick_t base, rt_tick_t range)
+{
+    rt_uint32_t stamp, total = 0;
+    rt_tick_t timeout;
+    int index;
+
+    for (index = 0; index < num; index ++)
+    {
+        timeout = base + (range > 1 ? rand() % range : 0);
+        rt_timer_control(&timers[index], RT_TIMER_CTRL_SET_TIME, &timeout);
+        timers[index].parameter = (void *)(rt_ubase_t)(rt_tick_get() + timeout);
+
+        stamp = clock_cpu_gettime();
+        rt_timer_start(&timers[index]);
+        total += clock_cpu_gettime() - stamp;
+    }
+
+    return total;
+}
+
+/* start the timers to expire at the same tick */
+static void bench_start_at(struct rt_timer *timers, int num, rt_tick_t tick)
+{
+    rt_tick_t timeout;
+    int index;
+
+    for (index = 0; index < num; index ++)
+    {
+        timeout = tick - rt_tick_get();
+        rt_timer_control(&timers[index], RT_TIMER_CTRL_SET_TIME, &timeout);
+        timers[index].parameter = (void *)(rt_ubase_t)tick;
+        rt_timer_start(&timers[index]);
+    }
+}
+
+static int timer_bench(int argc, char **argv)
+{
+    struct rt_timer *timers;
+    rt_uint32_t stamp, start_time, stop_time = 0;
+    rt_tick_t expire_tick;
+    float resolution = clock_cpu_getres();
+    int num = 10000, index;
+
+    if (argc > 1)
+        num = atoi(argv[1]);
+    if (num <= 1)
+    {
+        rt_kprintf("Usage: timer_bench [timers]\n");
+        return -RT_EINVAL;
+    }
+
+    timers = (struct rt_timer *)rt_malloc(num * sizeof(struct rt_timer));
+    if (timers == RT_NULL)
+    {
+        rt_kprintf("no memory for benchmark\n");
+        return -RT_ENOMEM;
+    }
+    for (index = 0; index < num; index ++)
+        rt_timer_init(&timers[index], "bench", bench_timeout, RT_NULL, 1,
+                      RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+    srand(1);
+
+#ifdef RT_USING_TIMER_WHEEL
+    rt_kprintf("timing wheel of %d bits, %d timers\n", RT_TIMER_WHEEL_BITS, num);
+#else
+    rt_kprintf("sorted timer list, %d timers\n", num);
+#endif
+    rt_kprintf("operation  average(ns) irq off(ns) expired late(tick)\n");
+    rt_kprintf("---------- ----------- ----------- ------- ----------\n");
+
+    /* insert far from the current tick, nothing expires */
+    bench_reset_irq_off();
+    start_time = bench_start(timers, num, 10 * RT_TICK_PER_SECOND, 10 * RT_TICK_PER_SECOND);
+    for (index = 0; index < num; index ++)
+    {
+        stamp = clock_cpu_gettime();
+        rt_timer_stop(&timers[index]);
+        stop_time += clock_cpu_gettime() - stamp;
+    }
+    rt_kprintf("%-10s %11d", "start", (int)(start_time * resolution / num));
+    bench_show_irq_off("rt_timer_start", resolution);
+    rt_kprintf("\n%-10s %11d", "stop", (int)(stop_time * resolution / num));
+    bench_show_irq_off("rt_timer_stop", resolution);
+    rt_kprintf("\n");
+
+    /* all of timers expire in the same tick, after all of them are started */
+    rt_memset(&bench_expire, 0, sizeof(bench_expire));
+    expire_tick = rt_tick_from_millisecond((rt_int32_t)(start_time * resolution / 1000000) * 2);
+    expire_tick += rt_tick_get() + BENCH_EXPIRE_TICKS;
+    bench_start_at(timers, num, expire_tick);
+    bench_reset_irq_off();
+    rt_thread_delay(expire_tick - rt_tick_get() + BENCH_EXPIRE_TICKS);
+    rt_kprintf("%-10s %11d", "expire", bench_expire.count > 1 ?
+               (int)((bench_expire.last - bench_expire.first) * resolution / (bench_expire.count - 1)) : 0);
+    bench_show_irq_off("rt_timer_check", resolution);
+    rt_kprintf(" %7d %10d\n", bench_expire.count, bench_expire.late);
+
+    /* the timers expire in the following ticks, and cascade in the wheel */
+    rt_memset(&bench_expire, 0, sizeof(bench_expire));
+    bench_start(timers, num, 1, BENCH_EXPIRE_TICKS * 3);
+    bench_reset_irq_off();
+    rt_thread_delay(BENCH_EXPIRE_TICKS * 4);
+    rt_kprintf("%-10s %11s", "spread", "-");
+    bench_show_irq_off("rt_timer_check", resolution);
+    rt_kprintf(" %7d %10d\n", bench_expire.count, bench_expire.late);
+
+    for (index = 0; index < num; index ++)
+        rt_timer_detach(&timers[index]);
+    rt_free(timers);
+
+    return 0;
+}
+MSH_CMD_EXPORT(timer_bench, benchmark the insert and expire of timers. Usage: timer_bench [timers]);
+#endif
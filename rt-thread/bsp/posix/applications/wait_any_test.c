@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The test of waiting on multiple objects. A thread of higher priority waits
+ * on two semaphores by rt_wait_any, and the thread of the command wakes it
+ * by one of them, lets it time out, detaches one of them while it waits,
+ * and wakes it by the second one, takes that back and detaches the first one
+ * before it runs. At the end of each case, the result shall be expected and
+ * no waiter shall be left in the wait lists of semaphores.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_IPC_WAIT_ANY) && defined(RT_USING_SEMAPHORE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define TEST_THREAD_PRIORITY    (FINSH_THREAD_PRIORITY - 5)
+
+enum test_case
+{
+    TEST_CASE_WAKE,
+    TEST_CASE_TIMEOUT,
+    TEST_CASE_DETACH,
+    TEST_CASE_STEAL,
+};
+
+struct wait_any_test
+{
+    struct rt_semaphore sems[2];
+    struct rt_semaphore done;
+
+    rt_int32_t timeout;
+    rt_int32_t result;
+};
+
+static struct wait_any_test test;
+
+/* the name of result, rt_kprintf shows the negative number as unsigned on 64-bit host */
+static const char *test_result_name(rt_int32_t result, char *buf, rt_size_t size)
+{
+    if (result == -RT_ETIMEOUT)
+        return "timeout";
+    if (result == -RT_ERROR)
+        return "error";
+
+    rt_snprintf(buf, size, "%d", (int)result);
+    return buf;
+}
+
+static void test_waiter_entry(void *parameter)
+{
+    rt_object_t objects[2];
+
+    objects[0] = &(test.sems[0].parent.parent);
+    objects[1] = &(test.sems[1].parent.parent);
+    test.result = rt_wait_any(objects, 2, test.timeout);
+
+    rt_sem_release(&test.done);
+}
+
+static int test_run(const char *title, enum test_case which, rt_int32_t expected)
+{
+    char expected_buf[12], result_buf[12];
+    rt_thread_t thread;
+    int errors = 0;
+
+    rt_sem_init(&test.sems[0], "wasem0", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&test.sems[1], "wasem1", 0, RT_IPC_FLAG_FIFO);
+    test.timeout = which == TEST_CASE_TIMEOUT ? 10 : RT_WAITING_FOREVER;
+    test.result = 0;
+
+    /* the waiter of higher priority is blocked when it's started */
+    thread = rt_thread_create("waiter", test_waiter_entry, RT_NULL, 2048,
+                              TEST_THREAD_PRIORITY, 10);
+    if (thread == RT_NULL)
+    {
+        rt_kprintf("create waiter failed\n");
+        return 1;
+    }
+    rt_thread_startup(thread);
+
+    switch (which)
+    {
+    case TEST_CASE_WAKE:
+        rt_sem_release(&test.sems[1]);
+        break;
+    case TEST_CASE_DETACH:
+        rt_sem_detach(&test.sems[0]);
+        break;
+    case TEST_CASE_STEAL:
+        /* the waiter is resumed by sems[1], but it runs after all of these */
+        rt_enter_critical();
+        rt_sem_release(&test.sems[1]);
+        if (rt_sem_trytake(&test.sems[1]) != RT_EOK)
+            errors ++;
+        rt_sem_detach(&test.sems[0]);
+        rt_exit_critical();
+        break;
+    default:
+        break;
+    }
+    rt_sem_take(&test.done, RT_WAITING_FOREVER);
+
+    if (test.result != expected)
+        errors ++;
+    if (!rt_list_isempty(&(test.sems[0].parent.wait_list)) ||
+            !rt_list_isempty(&(test.sems[1].parent.wait_list)))
+        errors ++;
+
+    rt_kprintf("%-8s %-8s %-8s %6d\n", title,
+               test_result_name(expected, expected_buf, sizeof(expected_buf)),
+               test_result_name(test.result, result_buf, sizeof(result_buf)), errors);
+
+    if (which != TEST_CASE_DETACH && which != TEST_CASE_STEAL)
+        rt_sem_detach(&test.sems[0]);
+    rt_sem_detach(&test.sems[1]);
+
+    return errors;
+}
+
+static int wait_any_test(int argc, char **argv)
+{
+    int errors = 0;
+
+    rt_sem_init(&test.done, "wadone", 0, RT_IPC_FLAG_FIFO);
+
+    rt_kprintf("case     expected result   errors\n");
+    rt_kprintf("-------- -------- -------- ------\n");
+    errors += test_run("wake", TEST_CASE_WAKE, 1);
+    errors += test_run("timeout", TEST_CASE_TIMEOUT, -RT_ETIMEOUT);
+    errors += test_run("detach", TEST_CASE_DETACH, -RT_ERROR);
+    errors += test_run("steal", TEST_CASE_STEAL, -RT_ERROR);
+    rt_kprintf("wait any test %s\n", errors == 0 ? "passed" : "failed");
+
+    rt_sem_detach(&test.done);
+
+    return 0;
+}
+MSH_CMD_EXPORT(wait_any_test, test waiting on multiple objects);
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include "board.h"
+
+#ifdef RT_USING_HEAP
+static rt_uint8_t _heap[BSP_HEAP_SIZE];
+#endif
+#ifdef BSP_USING_MEMHEAP_REGION
+static struct rt_memheap _fast_heap, _bulk_heap;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _fast_mem[BSP_FAST_MEM_SIZE];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _bulk_mem[BSP_BULK_MEM_SIZE];
+#endif
+
+static pthread_t _tick_pthread;
+
+/* the tick interrupt */
+static void _tick_isr(int vector, void *param)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    rt_tick_increase();
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+/* the host thread of tick timer, it's driven by the absolute time of host */
+static void *_tick_entry(void *parameter)
+{
+    struct timespec next;
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (1)
+    {
+        next.tv_nsec += 1000000000L / RT_TICK_PER_SECOND;
+        if (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec ++;
+        }
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, RT_NULL) != 0);
+
+        rt_hw_interrupt_trigger(POSIX_IRQ_TICK);
+    }
+
+    return RT_NULL;
+}
+
+#ifdef RT_USING_IDLE_HOOK
+/* sleep the host thread of idle instead of the busy loop */
+static void _idle_hook(void)
+{
+    rt_hw_cpu_idle();
+}
+#endif
+
+/**
+ * This function will output a string to the host console.
+ *
+ * @param str the string to output
+ */
+void rt_hw_console_output(const char *str)
+{
+    rt_size_t length = rt_strlen(str);
+    ssize_t result;
+
+    while (length > 0)
+    {
+        result = write(STDOUT_FILENO, str, length);
+        if (result <= 0)
+            break;
+
+        str    += result;
+        length -= result;
+    }
+}
+
+/**
+ * This function will initialize the host board, it's invoked with interrupt
+ * disabled before scheduler starts.
+ */
+void rt_hw_board_init(void)
+{
+    pthread_attr_t attr;
+    sigset_t set, old;
+
+    rt_hw_interrupt_init();
+
+#ifdef RT_USING_HEAP
+    rt_system_heap_init(_heap, _heap + sizeof(_heap));
+#endif
+#ifdef BSP_USING_MEMHEAP_REGION
+    rt_memheap_init(&_fast_heap, "fast", _fast_mem, sizeof(_fast_mem));
+    rt_memheap_set_class(&_fast_heap, RT_MEMHEAP_CLASS_FAST);
+    rt_memheap_init(&_bulk_heap, "bulk", _bulk_mem, sizeof(_bulk_mem));
+    rt_memheap_set_class(&_bulk_heap, RT_MEMHEAP_CLASS_BULK);
+#endif
+
+    /* the host threads of peripherals never handle interrupt */
+    sigfillset(&set);
+    pthread_sigmask(SIG_BLOCK, &set, &old);
+
+    rt_hw_interrupt_install(POSIX_IRQ_TICK, _tick_isr, RT_NULL, "tick");
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_create(&_tick_pthread, &attr, _tick_entry, RT_NULL);
+    pthread_attr_destroy(&attr);
+
+#ifdef BSP_USING_CONSOLE
+    rt_hw_console_init();
+#endif
+#ifdef BSP_USING_HWTIMER
+    rt_hw_hwtimer_init();
+#endif
+
+    pthread_sigmask(SIG_SETMASK, &old, RT_NULL);
+
+#if defined(RT_USING_CONSOLE) && defined(BSP_USING_CONSOLE)
+    rt_console_set_device(RT_CONSOLE_DEVICE_NAME);
+#endif
+
+#ifdef RT_USING_IDLE_HOOK
+    rt_thread_idle_sethook(_idle_hook);
+#endif
+
+#ifdef RT_USING_COMPONENTS_INIT
+    rt_components_board_init();
+#endif
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static int cmd_exit(int argc, char **argv)
+{
+    rt_hw_cpu_shutdown();
+
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(cmd_exit, exit, exit the host process);
+#endif /* RT_USING_FINSH */
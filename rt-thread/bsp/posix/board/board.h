@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+#include <rtthread.h>
+#include <cpuport.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the interrupts raised by the host threads of peripherals */
+#define POSIX_IRQ_TICK          0
+#define POSIX_IRQ_CONSOLE       1
+#define POSIX_IRQ_HWTIMER       2
+
+#ifndef BSP_HEAP_SIZE
+#define BSP_HEAP_SIZE           (4 * 1024 * 1024)
+#endif
+
+#ifdef BSP_USING_MEMHEAP_REGION
+#ifndef BSP_FAST_MEM_SIZE
+#define BSP_FAST_MEM_SIZE       (64 * 1024)
+#endif
+#ifndef BSP_BULK_MEM_SIZE
+#define BSP_BULK_MEM_SIZE       (8 * 1024 * 1024)
+#endif
+#endif
+
+void rt_hw_board_init(void);
+
+#ifdef BSP_USING_CONSOLE
+int rt_hw_console_init(void);
+#endif
+#ifdef BSP_USING_HWTIMER
+int rt_hw_hwtimer_init(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOARD_H__ */
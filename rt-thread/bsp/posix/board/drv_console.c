@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The console device on the stdin and stdout of host process.
+ *
+ * A host thread reads stdin into a ring buffer and raises the console
+ * interrupt, and the ISR indicates the received data to the device user, such
+ * as finsh. The terminal of stdin is set in non-canonical mode without echo,
+ * and it's restored when the host process exits.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include "board.h"
+
+#ifdef BSP_USING_CONSOLE
+
+#ifndef BSP_CONSOLE_RX_BUFSZ
+#define BSP_CONSOLE_RX_BUFSZ    256
+#endif
+
+struct posix_console
+{
+    struct rt_device parent;
+
+    /* the ring buffer of receiving, written by the host thread only */
+    rt_uint8_t rx_buffer[BSP_CONSOLE_RX_BUFSZ];
+    volatile rt_uint32_t put_index;
+    volatile rt_uint32_t get_index;
+
+    pthread_t pthread;
+};
+
+static struct posix_console _console;
+static struct termios _termios;
+static int _termios_saved;
+
+static void _console_restore(void)
+{
+    tcsetattr(STDIN_FILENO, TCSANOW, &_termios);
+}
+
+static void _console_isr(int vector, void *param)
+{
+    struct posix_console *console = (struct posix_console *)param;
+    rt_size_t length;
+
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    length = console->put_index - console->get_index;
+    if (length > 0 && console->parent.rx_indicate != RT_NULL)
+        console->parent.rx_indicate(&console->parent, length);
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+/* the host thread of receiving */
+static void *_console_entry(void *parameter)
+{
+    struct posix_console *console = (struct posix_console *)parameter;
+    rt_uint8_t buffer[64];
+    ssize_t length, index;
+
+    while (1)
+    {
+        length = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            /* the end of stdin, such as a pipe of script */
+            break;
+        }
+
+        for (index = 0; index < length; index ++)
+        {
+            /* drop the data if the buffer is full */
+            if (console->put_index - console->get_index >= BSP_CONSOLE_RX_BUFSZ)
+                break;
+
+            console->rx_buffer[console->put_index % BSP_CONSOLE_RX_BUFSZ] = buffer[index];
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            console->put_index ++;
+        }
+
+        rt_hw_interrupt_trigger(POSIX_IRQ_CONSOLE);
+    }
+
+    return RT_NULL;
+}
+
+static rt_size_t _console_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    struct posix_console *console = (struct posix_console *)dev;
+    rt_uint8_t *ptr = (rt_uint8_t *)buffer;
+    rt_size_t length = 0;
+
+    while (length < size && console->get_index != console->put_index)
+    {
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        ptr[length ++] = console->rx_buffer[console->get_index % BSP_CONSOLE_RX_BUFSZ];
+        console->get_index ++;
+    }
+
+    return length;
+}
+
+static rt_size_t _console_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    const rt_uint8_t *ptr = (const rt_uint8_t *)buffer;
+    rt_size_t length = size;
+    ssize_t result;
+
+    while (length > 0)
+    {
+        result = write(STDOUT_FILENO, ptr, length);
+        if (result <= 0)
+            break;
+
+        ptr    += result;
+        length -= result;
+    }
+
+    return size - length;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops _console_ops =
+{
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    _console_read,
+    _console_write,
+    RT_NULL
+};
+#endif
+
+/**
+ * This function will initialize the console device of host process. It's
+ * invoked with the signals blocked in rt_hw_board_init.
+ *
+ * @return RT_EOK on successful
+ */
+int rt_hw_console_init(void)
+{
+    struct posix_console *console = &_console;
+    struct termios raw;
+    pthread_attr_t attr;
+
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &_termios) == 0)
+    {
+        if (!_termios_saved)
+        {
+            _termios_saved = 1;
+            atexit(_console_restore);
+        }
+
+        raw = _termios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN]  = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+
+    console->parent.type      = RT_Device_Class_Char;
+#ifdef RT_USING_DEVICE_OPS
+    console->parent.ops       = &_console_ops;
+#else
+    console->parent.init      = RT_NULL;
+    console->parent.open      = RT_NULL;
+    console->parent.close     = RT_NULL;
+    console->parent.read      = _console_read;
+    console->parent.write     = _console_write;
+    console->parent.control   = RT_NULL;
+#endif
+    console->parent.user_data = RT_NULL;
+
+    rt_device_register(&console->parent, RT_CONSOLE_DEVICE_NAME,
+                       RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_STREAM | RT_DEVICE_FLAG_INT_RX);
+
+    rt_hw_interrupt_install(POSIX_IRQ_CONSOLE, _console_isr, console, "console");
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_create(&console->pthread, &attr, _console_entry, console);
+    pthread_attr_destroy(&attr);
+
+    return RT_EOK;
+}
+
+#endif /* BSP_USING_CONSOLE */
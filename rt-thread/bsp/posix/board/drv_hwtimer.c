@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The hardware timer device and the CPU time counter on the monotonic clock
+ * of host. The expiration of timer is waited by a host thread, which raises
+ * the timer interrupt.
+ */
+
+#include <pthread.h>
+#include <time.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#include "board.h"
+
+#ifdef RT_USING_CPUTIME
+static float _cputime_getres(void)
+{
+    /* nanosecond per tick */
+    return 1.0f;
+}
+
+static uint32_t _cputime_gettime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+const static struct rt_clock_cputime_ops _cputime_ops =
+{
+    _cputime_getres,
+    _cputime_gettime
+};
+
+static int posix_cputime_init(void)
+{
+    clock_cpu_setops(&_cputime_ops);
+
+    return 0;
+}
+INIT_BOARD_EXPORT(posix_cputime_init);
+#endif /* RT_USING_CPUTIME */
+
+#if defined(RT_USING_HWTIMER) && defined(BSP_USING_HWTIMER)
+struct posix_hwtimer
+{
+    rt_hwtimer_t parent;
+
+    pthread_t pthread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+
+    int running;
+    rt_hwtimer_mode_t mode;
+    rt_uint64_t start;                          /* the time of starting in nanosecond */
+    rt_uint64_t period;                         /* the period in nanosecond */
+    rt_uint64_t expire;
+};
+
+static struct posix_hwtimer _hwtimer;
+
+static const struct rt_hwtimer_info _hwtimer_info =
+{
+    1000000,                                    /* the maximum count frequency */
+    1,                                          /* the minimum count frequency */
+    0xFFFFFFFF,                                 /* the maximum counter value */
+    HWTIMER_CNTMODE_UP,
+};
+
+static rt_uint64_t _hwtimer_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void _hwtimer_isr(int vector, void *param)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    rt_device_hwtimer_isr((rt_hwtimer_t *)param);
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+/* the host thread of timer */
+static void *_hwtimer_entry(void *parameter)
+{
+    struct posix_hwtimer *timer = (struct posix_hwtimer *)parameter;
+    struct timespec ts;
+
+    pthread_mutex_lock(&timer->lock);
+    while (1)
+    {
+        if (!timer->running)
+        {
+            pthread_cond_wait(&timer->cond, &timer->lock);
+            continue;
+        }
+
+        ts.tv_sec  = timer->expire / 1000000000ULL;
+        ts.tv_nsec = timer->expire % 1000000000ULL;
+        if (pthread_cond_timedwait(&timer->cond, &timer->lock, &ts) == 0)
+            continue;
+        if (!timer->running || _hwtimer_now() < timer->expire)
+            continue;
+
+        if (timer->mode == HWTIMER_MODE_PERIOD)
+        {
+            timer->start   = timer->expire;
+            timer->expire += timer->period;
+        }
+        else
+        {
+            timer->running = 0;
+        }
+
+        rt_hw_interrupt_trigger(POSIX_IRQ_HWTIMER);
+    }
+
+    return RT_NULL;
+}
+
+/* the host lock is held with interrupt disabled, no thread is switched in */
+static void _hwtimer_init(rt_hwtimer_t *timer, rt_uint32_t state)
+{
+}
+
+static rt_err_t _hwtimer_start(rt_hwtimer_t *timer, rt_uint32_t cnt, rt_hwtimer_mode_t mode)
+{
+    struct posix_hwtimer *hwtimer = (struct posix_hwtimer *)timer;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    pthread_mutex_lock(&hwtimer->lock);
+    hwtimer->mode    = mode;
+    hwtimer->period  = (rt_uint64_t)cnt * 1000000000ULL / timer->freq;
+    hwtimer->start   = _hwtimer_now();
+    hwtimer->expire  = hwtimer->start + hwtimer->period;
+    hwtimer->running = 1;
+    pthread_cond_signal(&hwtimer->cond);
+    pthread_mutex_unlock(&hwtimer->lock);
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+static void _hwtimer_stop(rt_hwtimer_t *timer)
+{
+    struct posix_hwtimer *hwtimer = (struct posix_hwtimer *)timer;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    pthread_mutex_lock(&hwtimer->lock);
+    hwtimer->running = 0;
+    pthread_cond_signal(&hwtimer->cond);
+    pthread_mutex_unlock(&hwtimer->lock);
+    rt_hw_interrupt_enable(level);
+}
+
+static rt_uint32_t _hwtimer_count_get(rt_hwtimer_t *timer)
+{
+    struct posix_hwtimer *hwtimer = (struct posix_hwtimer *)timer;
+    rt_uint64_t elapsed = 0;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    pthread_mutex_lock(&hwtimer->lock);
+    if (hwtimer->running)
+    {
+        elapsed = _hwtimer_now() - hwtimer->start;
+        if (elapsed > hwtimer->period)
+            elapsed = hwtimer->period;
+    }
+    pthread_mutex_unlock(&hwtimer->lock);
+    rt_hw_interrupt_enable(level);
+
+    return (rt_uint32_t)(elapsed * timer->freq / 1000000000ULL);
+}
+
+static rt_err_t _hwtimer_control(rt_hwtimer_t *timer, rt_uint32_t cmd, void *args)
+{
+    switch (cmd)
+    {
+    case HWTIMER_CTRL_FREQ_SET:
+        /* the frequency is applied at starting */
+        return RT_EOK;
+
+    default:
+        return -RT_ENOSYS;
+    }
+}
+
+static const struct rt_hwtimer_ops _hwtimer_ops =
+{
+    _hwtimer_init,
+    _hwtimer_start,
+    _hwtimer_stop,
+    _hwtimer_count_get,
+    _hwtimer_control
+};
+
+/**
+ * This function will initialize the hardware timer of host. It's invoked
+ * with the signals blocked in rt_hw_board_init.
+ *
+ * @return RT_EOK on successful
+ */
+int rt_hw_hwtimer_init(void)
+{
+    struct posix_hwtimer *timer = &_hwtimer;
+    pthread_condattr_t condattr;
+    pthread_attr_t attr;
+
+    pthread_mutex_init(&timer->lock, RT_NULL);
+    pthread_condattr_init(&condattr);
+    pthread_condattr_setclock(&condattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer->cond, &condattr);
+    pthread_condattr_destroy(&condattr);
+
+    timer->parent.info = &_hwtimer_info;
+    timer->parent.ops  = &_hwtimer_ops;
+    rt_device_hwtimer_register(&timer->parent, "timer0", RT_NULL);
+
+    rt_hw_interrupt_install(POSIX_IRQ_HWTIMER, _hwtimer_isr, timer, "timer0");
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_create(&timer->pthread, &attr, _hwtimer_entry, timer);
+    pthread_attr_destroy(&attr);
+
+    return RT_EOK;
+}
+#endif /* RT_USING_HWTIMER && BSP_USING_HWTIMER */
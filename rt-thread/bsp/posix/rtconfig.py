@@ -0,0 +1,54 @@
+import os
+
+# toolchains options
+ARCH='posix'
+CPU='posix'
+CROSS_TOOL='gcc'
+
+if os.getenv('RTT_CC'):
+    CROSS_TOOL = os.getenv('RTT_CC')
+if os.getenv('RTT_ROOT'):
+    RTT_ROOT = os.getenv('RTT_ROOT')
+
+# the host compiler of Linux
+PLATFORM    = 'gcc'
+EXEC_PATH   = '/usr/bin'
+
+if os.getenv('RTT_EXEC_PATH'):
+    EXEC_PATH = os.getenv('RTT_EXEC_PATH')
+
+BUILD = 'release'
+
+if PLATFORM == 'gcc':
+    # toolchains
+    PREFIX = ''
+    CC = PREFIX + 'gcc'
+    AS = PREFIX + 'gcc'
+    AR = PREFIX + 'ar'
+    CXX = PREFIX + 'g++'
+    LINK = PREFIX + 'gcc'
+    TARGET_EXT = 'elf'
+    SIZE = PREFIX + 'size'
+    OBJDUMP = PREFIX + 'objdump'
+    OBJCPY = PREFIX + 'objcopy'
+
+    DEVICE = ' -pthread -ffunction-sections -fdata-sections'
+    CFLAGS = DEVICE + ' -Wall -D_GNU_SOURCE'
+    # the signal types are defined by glibc
+    CFLAGS += ' -DHAVE_SIGVAL -DHAVE_SIGEVENT -DHAVE_SIGINFO -DHAVE_SIGACTION'
+    AFLAGS = ' -c' + DEVICE + ' -x assembler-with-cpp'
+    LFLAGS = DEVICE + ' -no-pie -Wl,--gc-sections,-Map=rt-thread.map,-cref -T board/linker_scripts/posix.lds'
+
+    CPATH = ''
+    LPATH = ''
+
+    if BUILD == 'debug':
+        CFLAGS += ' -O0 -g'
+        AFLAGS += ' -g'
+    else:
+        # the same flags on all build servers for the repeatable benchmark
+        CFLAGS += ' -O2 -g'
+
+    CXXFLAGS = CFLAGS
+
+    POST_ACTION = SIZE + ' $TARGET \n'
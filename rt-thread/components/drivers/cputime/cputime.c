@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author            Notes
  * 2017-12-23     Bernard           first version
+ * 2026-10-17     RT-Thread         add the clock of IPC statistics
+ * 2026-10-17     RT-Thread         add clock_cpu_getops
  */
 
 #include <rtdevice.h>
@@ -88,3 +90,45 @@ int clock_cpu_setops(const struct rt_clock_cputime_ops *ops)
 
     return 0;
 }
+
+/**
+ * The clock_cpu_getops() function shall return the ops of cpu time. It's used
+ * by the measurement in the paths of kernel, which shall not set errno when
+ * the ops isn't set yet.
+ *
+ * @return the ops of cpu time, or RT_NULL if it isn't set
+ */
+const struct rt_clock_cputime_ops *clock_cpu_getops(void)
+{
+    return _cputime_ops;
+}
+
+#ifdef RT_USING_IPC_STATS
+/**
+ * The rt_ipc_stats_clock() function overrides the OS tick of kernel with the
+ * CPU time for the contention statistics of semaphore and mutex.
+ *
+ * @return the cpu tick, or the OS tick if there is no CPU time
+ */
+rt_uint32_t rt_ipc_stats_clock(void)
+{
+    if (_cputime_ops)
+        return _cputime_ops->cputime_gettime();
+
+    return rt_tick_get();
+}
+
+/**
+ * The rt_ipc_stats_clock_getres() function shall return the resolution of
+ * rt_ipc_stats_clock().
+ *
+ * @return the number of nanosecond per tick
+ */
+float rt_ipc_stats_clock_getres(void)
+{
+    if (_cputime_ops)
+        return _cputime_ops->cputime_getres();
+
+    return 1000000000.0f / RT_TICK_PER_SECOND;
+}
+#endif
@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    check the hardware timer before updating the time
+ * 2026-10-17     RT-Thread    bound the ISR loop, limit the period, return the
+ *                             error of sleep resumed early
+ */
+
+/*
+ * High-resolution timer in microsecond.
+ *
+ * All of the high-resolution timers are kept in a queue sorted by the expired
+ * time, and they are multiplexed over one hardware timer, which is programmed
+ * in oneshot mode to the expired time of the first timer. The time is taken by
+ * the CPU time counter, which is free running, so the hardware timer can be
+ * stopped and programmed again at any time without drift, and an interrupt of
+ * the hardware timer programmed before is harmless.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#define DBG_TAG  "hrtimer"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+static rt_hwtimer_t *_hw;
+static rt_list_t _hrtimer_list = RT_LIST_OBJECT_INIT(_hrtimer_list);
+
+/* the time in microsecond extended from the CPU time counter */
+static rt_uint32_t _cpu_hz;
+static rt_uint32_t _cpu_last;
+static rt_uint64_t _cpu_frac;                   /* the remainder in cpu tick * 1000000 */
+static rt_uint64_t _now;
+
+static rt_uint32_t _max_timeout;                /* the maximal timeout of hardware timer */
+static rt_uint32_t _slack;                      /* the resolution of hardware timer */
+static rt_uint32_t _min_period;                 /* the minimal period of periodic timer */
+
+/* update the time, it's invoked with interrupt disabled and the hardware
+ * timer initialized, as _cpu_hz is 0 before */
+static rt_uint64_t _hrtimer_update(void)
+{
+    rt_uint32_t cpu = clock_cpu_gettime();
+
+    _cpu_frac += (rt_uint64_t)(cpu - _cpu_last) * 1000000;
+    _cpu_last = cpu;
+
+    _now += _cpu_frac / _cpu_hz;
+    _cpu_frac %= _cpu_hz;
+
+    return _now;
+}
+
+/* program the hardware timer to the first timer, or the maximal timeout to
+ * keep the time updated before the CPU time counter overflows */
+static void _hrtimer_program(rt_uint64_t now)
+{
+    struct rt_hrtimer *timer;
+    rt_uint64_t timeout = _max_timeout;
+    rt_uint32_t count;
+
+    if (!rt_list_isempty(&_hrtimer_list))
+    {
+        timer = rt_list_first_entry(&_hrtimer_list, struct rt_hrtimer, list);
+        timeout = timer->expire > now ? timer->expire - now : 0;
+        if (timeout > _max_timeout)
+            timeout = _max_timeout;
+    }
+
+    /* never expire before the time */
+    count = (rt_uint32_t)((timeout * _hw->freq + 999999) / 1000000);
+    if (count == 0)
+        count = 1;
+    if (count > _hw->info->maxcnt)
+        count = _hw->info->maxcnt;
+
+    _hw->ops->stop(_hw);
+    _hw->ops->start(_hw, count, HWTIMER_MODE_ONESHOT);
+}
+
+/* insert the timer to the sorted queue, and return RT_TRUE if it's the first */
+static rt_bool_t _hrtimer_insert(struct rt_hrtimer *timer)
+{
+    struct rt_list_node *node;
+    struct rt_hrtimer *t;
+
+    for (node = _hrtimer_list.next; node != &_hrtimer_list; node = node->next)
+    {
+        t = rt_list_entry(node, struct rt_hrtimer, list);
+        if (t->expire > timer->expire)
+            break;
+    }
+    rt_list_insert_before(node, &timer->list);
+    timer->flag |= RT_HRTIMER_FLAG_ACTIVATED;
+
+    return _hrtimer_list.next == &timer->list;
+}
+
+/* the interrupt of hardware timer */
+static rt_err_t _hrtimer_isr(rt_device_t dev, rt_size_t size)
+{
+    struct rt_hrtimer *timer;
+    register rt_base_t level;
+    rt_uint64_t now, deadline;
+
+    level = rt_hw_interrupt_disable();
+    now = _hrtimer_update();
+
+    /*
+     * only the timers expired at the entry are handled, the periodic timer
+     * restarted in the loop waits for the next interrupt, even if its time
+     * has come during the timeout functions
+     */
+    deadline = now + _slack;
+    while (!rt_list_isempty(&_hrtimer_list))
+    {
+        timer = rt_list_first_entry(&_hrtimer_list, struct rt_hrtimer, list);
+        if (timer->expire > deadline)
+            break;
+
+        rt_list_remove(&timer->list);
+        timer->flag &= ~RT_HRTIMER_FLAG_ACTIVATED;
+        if (timer->flag & RT_HRTIMER_FLAG_PERIODIC)
+        {
+            /* skip the periods which are missed */
+            timer->expire += timer->period;
+            if (timer->expire <= now)
+                timer->expire = now + timer->period;
+            _hrtimer_insert(timer);
+        }
+        rt_hw_interrupt_enable(level);
+
+        timer->timeout_func(timer->parameter);
+
+        level = rt_hw_interrupt_disable();
+        now = _hrtimer_update();
+    }
+    _hrtimer_program(now);
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will initialize a high-resolution timer.
+ *
+ * @param timer the timer to be initialized
+ * @param name the name of timer
+ * @param timeout the timeout function, it runs in ISR
+ * @param parameter the parameter of timeout function
+ * @param flag RT_HRTIMER_FLAG_ONE_SHOT or RT_HRTIMER_FLAG_PERIODIC
+ */
+void rt_hrtimer_init(rt_hrtimer_t timer, const char *name,
+                     void (*timeout)(void *parameter), void *parameter,
+                     rt_uint8_t flag)
+{
+    RT_ASSERT(timer != RT_NULL);
+    RT_ASSERT(timeout != RT_NULL);
+
+    rt_list_init(&timer->list);
+    timer->name         = name;
+    timer->timeout_func = timeout;
+    timer->parameter    = parameter;
+    timer->expire       = 0;
+    timer->period       = 0;
+    timer->flag         = flag & RT_HRTIMER_FLAG_PERIODIC;
+}
+RTM_EXPORT(rt_hrtimer_init);
+
+static void _hrtimer_start(rt_hrtimer_t timer, rt_uint64_t expire, rt_uint64_t now)
+{
+    if (timer->flag & RT_HRTIMER_FLAG_ACTIVATED)
+        rt_list_remove(&timer->list);
+
+    timer->expire = expire;
+    if (_hrtimer_insert(timer))
+        _hrtimer_program(now);
+}
+
+/**
+ * This function will start a high-resolution timer, and it's restarted if the
+ * timer is active. The period of periodic timer is raised to twice of the
+ * resolution of hardware timer at least.
+ *
+ * @param timer the timer to be started
+ * @param us the timeout in microsecond, and the period of periodic timer
+ *
+ * @return RT_EOK on successful, -RT_ERROR if there is no hardware timer,
+ *         -RT_EINVAL if the period of periodic timer is 0.
+ */
+rt_err_t rt_hrtimer_start(rt_hrtimer_t timer, rt_uint32_t us)
+{
+    register rt_base_t level;
+    rt_uint64_t now;
+
+    RT_ASSERT(timer != RT_NULL);
+
+    if (_hw == RT_NULL)
+        return -RT_ERROR;
+
+    if (timer->flag & RT_HRTIMER_FLAG_PERIODIC)
+    {
+        if (us == 0)
+            return -RT_EINVAL;
+        if (us < _min_period)
+            us = _min_period;
+    }
+
+    level = rt_hw_interrupt_disable();
+    now = _hrtimer_update();
+    timer->period = us;
+    _hrtimer_start(timer, now + us, now);
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_hrtimer_start);
+
+/**
+ * This function will start a high-resolution timer to expire at an absolute
+ * time. The period of periodic timer is kept.
+ *
+ * @param timer the timer to be started
+ * @param expire the expired time in microsecond, see rt_hrtimer_now()
+ *
+ * @return RT_EOK on successful, -RT_ERROR if there is no hardware timer,
+ *         -RT_EINVAL if the periodic timer has no period set by
+ *         rt_hrtimer_start().
+ */
+rt_err_t rt_hrtimer_start_at(rt_hrtimer_t timer, rt_uint64_t expire)
+{
+    register rt_base_t level;
+
+    RT_ASSERT(timer != RT_NULL);
+
+    if (_hw == RT_NULL)
+        return -RT_ERROR;
+
+    if ((timer->flag & RT_HRTIMER_FLAG_PERIODIC) && timer->period == 0)
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+    _hrtimer_start(timer, expire, _hrtimer_update());
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_hrtimer_start_at);
+
+/**
+ * This function will stop a high-resolution timer.
+ *
+ * @param timer the timer to be stopped
+ *
+ * @return RT_EOK on successful, -RT_ERROR if the timer is not active.
+ */
+rt_err_t rt_hrtimer_stop(rt_hrtimer_t timer)
+{
+    register rt_base_t level;
+
+    RT_ASSERT(timer != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    if (!(timer->flag & RT_HRTIMER_FLAG_ACTIVATED))
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_ERROR;
+    }
+
+    /* the hardware timer is kept, its interrupt finds nothing to do */
+    rt_list_remove(&timer->list);
+    timer->flag &= ~RT_HRTIMER_FLAG_ACTIVATED;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_hrtimer_stop);
+
+/**
+ * This function will return the time in microsecond since the high-resolution
+ * timer is initialized.
+ *
+ * @return the time in microsecond
+ */
+rt_uint64_t rt_hrtimer_now(void)
+{
+    register rt_base_t level;
+    rt_uint64_t now;
+
+    if (_hw == RT_NULL)
+        return 0;
+
+    level = rt_hw_interrupt_disable();
+    now = _hrtimer_update();
+    rt_hw_interrupt_enable(level);
+
+    return now;
+}
+RTM_EXPORT(rt_hrtimer_now);
+
+static void _hrtimer_wakeup(void *parameter)
+{
+    rt_thread_t thread = (rt_thread_t)parameter;
+    register rt_base_t level;
+    rt_err_t result;
+
+    /* the thread may be resumed by others */
+    level = rt_hw_interrupt_disable();
+    result = rt_thread_resume(thread);
+    if (result == RT_EOK)
+        thread->error = RT_EOK;
+    rt_hw_interrupt_enable(level);
+
+    if (result == RT_EOK)
+        rt_schedule();
+}
+
+/**
+ * This function will let current thread sleep until an absolute time.
+ *
+ * @param expire the expired time in microsecond, see rt_hrtimer_now()
+ *
+ * @return RT_EOK on successful, -RT_ERROR if there is no hardware timer, or
+ *         the error of thread if it's resumed before the time, which is
+ *         -RT_EINTR unless it's set by the resumer.
+ */
+rt_err_t rt_hrtimer_sleep_until(rt_uint64_t expire)
+{
+    struct rt_hrtimer timer;
+    register rt_base_t level;
+    rt_thread_t thread;
+    rt_uint64_t now;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    if (_hw == RT_NULL)
+        return -RT_ERROR;
+
+    thread = rt_thread_self();
+    rt_hrtimer_init(&timer, thread->name, _hrtimer_wakeup, thread, RT_HRTIMER_FLAG_ONE_SHOT);
+
+    level = rt_hw_interrupt_disable();
+    now = _hrtimer_update();
+    if (expire <= now + _slack)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return RT_EOK;
+    }
+
+    /* the error is cleared by the timer */
+    thread->error = -RT_EINTR;
+    rt_thread_suspend(thread);
+    _hrtimer_start(&timer, expire, now);
+    rt_hw_interrupt_enable(level);
+
+    rt_schedule();
+
+    /* the timer is on stack */
+    rt_hrtimer_stop(&timer);
+
+    return thread->error;
+}
+RTM_EXPORT(rt_hrtimer_sleep_until);
+
+/**
+ * This function will let current thread sleep for some microseconds.
+ *
+ * @param us the sleeping time in microsecond
+ *
+ * @return RT_EOK on successful, -RT_ERROR if there is no hardware timer.
+ */
+rt_err_t rt_hrtimer_sleep(rt_uint32_t us)
+{
+    return rt_hrtimer_sleep_until(rt_hrtimer_now() + us);
+}
+RTM_EXPORT(rt_hrtimer_sleep);
+
+/**
+ * This function will initialize the high-resolution timer on the hardware
+ * timer of RT_HRTIMER_DEVICE_NAME.
+ *
+ * @return RT_EOK on successful, -RT_ERROR on failed.
+ */
+int rt_hrtimer_system_init(void)
+{
+    register rt_base_t level;
+    rt_device_t dev;
+    rt_uint64_t max_timeout;
+    float res;
+
+    if (_hw != RT_NULL)
+        return RT_EOK;
+
+    res = clock_cpu_getres();
+    if (res <= 0)
+    {
+        LOG_E("no CPU time counter");
+        return -RT_ERROR;
+    }
+
+    dev = rt_device_find(RT_HRTIMER_DEVICE_NAME);
+    if (dev == RT_NULL || rt_device_open(dev, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+    {
+        LOG_E("open hardware timer %s failed", RT_HRTIMER_DEVICE_NAME);
+        return -RT_ERROR;
+    }
+    rt_device_set_rx_indicate(dev, _hrtimer_isr);
+
+    _cpu_hz = (rt_uint32_t)(1000000000.0f / res + 0.5f);
+
+    /* within the hardware timer, and half of the CPU time counter */
+    max_timeout = (rt_uint64_t)((rt_hwtimer_t *)dev)->info->maxcnt * 1000000 / ((rt_hwtimer_t *)dev)->freq;
+    if (max_timeout > ((rt_uint64_t)1 << 31) * 1000000 / _cpu_hz)
+        max_timeout = ((rt_uint64_t)1 << 31) * 1000000 / _cpu_hz;
+    _max_timeout = (rt_uint32_t)max_timeout;
+    _slack = 1000000 / ((rt_hwtimer_t *)dev)->freq;
+    _min_period = _slack ? _slack * 2 : 1;
+
+    level = rt_hw_interrupt_disable();
+    _cpu_last = clock_cpu_gettime();
+    _cpu_frac = 0;
+    _now = 0;
+    _hw = (rt_hwtimer_t *)dev;
+    _hrtimer_program(0);
+    rt_hw_interrupt_enable(level);
+
+    LOG_D("on %s, maximal timeout %d us", RT_HRTIMER_DEVICE_NAME, _max_timeout);
+
+    return RT_EOK;
+}
+INIT_DEVICE_EXPORT(rt_hrtimer_system_init);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static int list_hrtimer(void)
+{
+    struct rt_list_node *node;
+    struct rt_hrtimer *timer;
+    register rt_base_t level;
+    rt_uint64_t now;
+    rt_uint32_t remain;
+
+    if (_hw == RT_NULL)
+    {
+        rt_kprintf("no hardware timer for hrtimer\n");
+        return -RT_ERROR;
+    }
+
+    rt_kprintf("hrtimer  periodic   period(us) remain(us)\n");
+    rt_kprintf("-------- -------- ---------- ----------\n");
+
+    level = rt_hw_interrupt_disable();
+    now = _hrtimer_update();
+    for (node = _hrtimer_list.next; node != &_hrtimer_list; node = node->next)
+    {
+        timer = rt_list_entry(node, struct rt_hrtimer, list);
+        remain = timer->expire > now ? (rt_uint32_t)(timer->expire - now) : 0;
+
+        rt_kprintf("%-*.*s %-8s %10d %10d\n", RT_NAME_MAX, RT_NAME_MAX,
+                   timer->name ? timer->name : "",
+                   (timer->flag & RT_HRTIMER_FLAG_PERIODIC) ? "yes" : "no",
+                   timer->period, remain);
+    }
+    rt_hw_interrupt_enable(level);
+
+    rt_kprintf("current time: %d.%06d s\n", (rt_uint32_t)(now / 1000000), (rt_uint32_t)(now % 1000000));
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_hrtimer, list high-resolution timer in system);
+#endif /* RT_USING_FINSH */
@@ -6,11 +6,14 @@
  * Change Logs:
  * Date           Author            Notes
  * 2017-12-23     Bernard           first version
+ * 2026-10-17     RT-Thread         add clock_cpu_getops
  */
 
 #ifndef CPUTIME_H__
 #define CPUTIME_H__
 
+#include <stdint.h>
+
 struct rt_clock_cputime_ops
 {
     float    (*cputime_getres) (void);
@@ -24,5 +27,6 @@ uint32_t clock_cpu_microsecond(uint32_t cpu_tick);
 uint32_t clock_cpu_millisecond(uint32_t cpu_tick);
 
 int clock_cpu_setops(const struct rt_clock_cputime_ops *ops);
+const struct rt_clock_cputime_ops *clock_cpu_getops(void);
 
 #endif
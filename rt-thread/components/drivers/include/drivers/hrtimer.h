@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __HRTIMER_H__
+#define __HRTIMER_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RT_HRTIMER_FLAG_ONE_SHOT        0x0     /**< one shot timer */
+#define RT_HRTIMER_FLAG_PERIODIC        0x1     /**< periodic timer */
+#define RT_HRTIMER_FLAG_ACTIVATED       0x2     /**< timer is active */
+
+/*
+ * high-resolution timer, the timeout function runs in the ISR of hardware
+ * timer with interrupt enabled.
+ */
+struct rt_hrtimer
+{
+    rt_list_t list;                             /**< the node of sorted queue */
+    const char *name;
+
+    void (*timeout_func)(void *parameter);      /**< timeout function */
+    void *parameter;                            /**< timeout function's parameter */
+
+    rt_uint64_t expire;                         /**< the expired time in microsecond */
+    rt_uint32_t period;                         /**< the period in microsecond */
+    rt_uint8_t  flag;
+};
+typedef struct rt_hrtimer *rt_hrtimer_t;
+
+void rt_hrtimer_init(rt_hrtimer_t timer, const char *name,
+                     void (*timeout)(void *parameter), void *parameter,
+                     rt_uint8_t flag);
+rt_err_t rt_hrtimer_start(rt_hrtimer_t timer, rt_uint32_t us);
+rt_err_t rt_hrtimer_start_at(rt_hrtimer_t timer, rt_uint64_t expire);
+rt_err_t rt_hrtimer_stop(rt_hrtimer_t timer);
+
+rt_uint64_t rt_hrtimer_now(void);
+rt_err_t rt_hrtimer_sleep(rt_uint32_t us);
+rt_err_t rt_hrtimer_sleep_until(rt_uint64_t expire);
+
+int rt_hrtimer_system_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
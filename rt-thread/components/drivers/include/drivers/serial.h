@@ -58,11 +58,35 @@
 #define RT_SERIAL_RB_BUFSZ              64
 #endif
 
+#ifdef RT_SERIAL_USING_DMA_TX_RING
+#ifndef RT_SERIAL_DMA_TX_BUFSZ
+#define RT_SERIAL_DMA_TX_BUFSZ          256
+#endif
+/* the indexes of tx ring are 16 bits */
+#if RT_SERIAL_DMA_TX_BUFSZ > 32768
+#error "RT_SERIAL_DMA_TX_BUFSZ is too large, it shall be 32768 at most"
+#endif
+#endif
+
 #define RT_SERIAL_EVENT_RX_IND          0x01    /* Rx indication */
 #define RT_SERIAL_EVENT_TX_DONE         0x02    /* Tx complete   */
 #define RT_SERIAL_EVENT_RX_DMADONE      0x03    /* Rx DMA transfer done */
 #define RT_SERIAL_EVENT_TX_DMADONE      0x04    /* Tx DMA transfer done */
 #define RT_SERIAL_EVENT_RX_TIMEOUT      0x05    /* Rx timeout    */
+#define RT_SERIAL_EVENT_RX_IDLE         0x06    /* Rx idle line  */
+
+#ifdef RT_SERIAL_USING_FRAME
+#ifndef RT_SERIAL_FRAME_NUM
+#define RT_SERIAL_FRAME_NUM             8
+#endif
+
+#ifdef RT_USING_HRTIMER
+#include "hrtimer.h"
+#endif
+
+/* set the inter-character gap of frame mode, in 1/10 character, 0 for disable */
+#define RT_SERIAL_CTRL_SET_FRAME_GAP    0x20
+#endif
 
 #define RT_SERIAL_DMA_RX                0x01
 #define RT_SERIAL_DMA_TX                0x02
@@ -114,6 +138,9 @@ struct rt_serial_rx_fifo
     rt_uint16_t put_index, get_index;
 
     rt_bool_t is_full;
+#ifdef RT_SERIAL_USING_DMA
+    rt_uint32_t overrun;        /* the times of the received data overwritten by DMA */
+#endif
 };
 
 struct rt_serial_tx_fifo
@@ -129,12 +156,82 @@ struct rt_serial_rx_dma
     rt_bool_t activated;
 };
 
+#ifdef RT_SERIAL_USING_DMA_TX_RING
+struct rt_serial_tx_stats
+{
+    rt_uint32_t bytes;          /* the bytes written */
+    rt_uint32_t writes;         /* the times of write */
+    rt_uint32_t bursts;         /* the DMA bursts */
+    rt_uint32_t stalls;         /* the times of write waiting for the tx ring */
+    rt_tick_t stall_time;       /* the total ticks of waiting for the tx ring */
+};
+#endif
+
 struct rt_serial_tx_dma
 {
     rt_bool_t activated;
+#ifdef RT_SERIAL_USING_DMA_TX_RING
+    /* tx ring, DMA sends the burst at get index, the writes are appended at put index */
+    rt_uint8_t *buffer;
+    rt_uint16_t put_index, get_index;
+    rt_uint16_t count;          /* the pending bytes, including the burst in flight */
+    rt_uint16_t burst;          /* the bytes of the burst in flight */
+
+    struct rt_completion completion;
+    struct rt_mutex lock;       /* the writers in thread wait for the tx ring in turn */
+    struct rt_serial_tx_stats stats;
+#else
     struct rt_data_queue data_queue;
+#endif
 };
 
+/*
+ * The received data in DMA receive fifo, it's in two spans when the data
+ * wraps around the end of fifo.
+ */
+struct rt_serial_rx_span
+{
+    rt_uint8_t *data[2];
+    rt_size_t size[2];
+
+    rt_uint32_t overrun;        /* the overrun times when the span is acquired */
+};
+
+#ifdef RT_SERIAL_USING_FRAME
+/*
+ * Serial frame mode, the received data is split into frames on the
+ * inter-character gap.
+ */
+struct rt_serial_frame
+{
+    rt_uint32_t end;            /* the received bytes at the end of frame */
+    rt_uint32_t timestamp;      /* the CPU time of the last character */
+};
+
+struct rt_serial_rx_frame
+{
+    rt_uint32_t gap;            /* the inter-character gap in 1/10 character */
+    rt_uint32_t gap_delay;      /* the CPU time from the last character to the receiver timeout */
+    rt_uint32_t idle_delay;     /* the CPU time from the last character to the idle line */
+    rt_tick_t confirm;          /* the ticks to confirm the gap after the idle line */
+#ifdef RT_USING_HRTIMER
+    rt_uint32_t confirm_us;     /* the microseconds to confirm the gap after the idle line */
+    struct rt_hrtimer hrtimer;
+#endif
+
+    rt_uint32_t received;       /* the total bytes received */
+    rt_uint32_t last_end;       /* the received bytes at the end of last frame */
+    rt_uint32_t idle_received;  /* the received bytes at the idle line */
+    rt_uint32_t idle_timestamp;
+    struct rt_timer timer;
+
+    struct rt_serial_frame frames[RT_SERIAL_FRAME_NUM];
+    rt_uint16_t put_index, get_index;
+    rt_uint16_t count;
+    rt_uint32_t dropped;        /* the frames dropped for the full queue */
+};
+#endif
+
 struct rt_serial_device
 {
     struct rt_device          parent;
@@ -144,6 +241,9 @@ struct rt_serial_device
 
     void *serial_rx;
     void *serial_tx;
+#ifdef RT_SERIAL_USING_FRAME
+    struct rt_serial_rx_frame *rx_frame;
+#endif
 };
 typedef struct rt_serial_device rt_serial_t;
 
@@ -168,4 +268,13 @@ rt_err_t rt_hw_serial_register(struct rt_serial_device *serial,
                                rt_uint32_t              flag,
                                void                    *data);
 
+#ifdef RT_SERIAL_USING_DMA
+rt_size_t rt_serial_rx_acquire(rt_device_t dev, struct rt_serial_rx_span *span);
+rt_err_t rt_serial_rx_release(rt_device_t dev, struct rt_serial_rx_span *span, rt_size_t len);
+#endif
+
+#ifdef RT_SERIAL_USING_FRAME
+rt_size_t rt_serial_frame_read(rt_device_t dev, void *buffer, rt_size_t size, rt_uint32_t *timestamp);
+#endif
+
 #endif
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2012-11-23     Bernard      Add extern "C"
+ * 2026-10-17     RT-Thread    Add asynchronous message queue
  */
 
 #ifndef __SPI_H__
@@ -13,6 +14,9 @@
 
 #include <stdlib.h>
 #include <rtthread.h>
+#ifdef RT_USING_SPI_ASYNC
+#include <ipc/completion.h>
+#endif
 
 #ifdef __cplusplus
 extern "C"{
@@ -80,6 +84,7 @@ struct rt_spi_configuration
 };
 
 struct rt_spi_ops;
+struct rt_spi_request;
 struct rt_spi_bus
 {
     struct rt_device parent;
@@ -88,6 +93,16 @@ struct rt_spi_bus
 
     struct rt_mutex lock;
     struct rt_spi_device *owner;
+
+#ifdef RT_USING_SPI_ASYNC
+    rt_list_t async_queue;                      /* the requests sorted by priority of device */
+    struct rt_semaphore async_sem;
+    rt_thread_t async_thread;
+
+    struct rt_spi_request *async_request;       /* the request in transfer */
+    struct rt_spi_message *async_message;       /* the message to be transferred */
+    struct rt_completion async_completion;
+#endif
 };
 
 /**
@@ -97,6 +112,13 @@ struct rt_spi_ops
 {
     rt_err_t (*configure)(struct rt_spi_device *device, struct rt_spi_configuration *configuration);
     rt_uint32_t (*xfer)(struct rt_spi_device *device, struct rt_spi_message *message);
+
+#ifdef RT_USING_SPI_ASYNC
+    /* start the transfer of message and return at once, the driver invokes
+       rt_spi_bus_xfer_done when it's done. It's optional, and returns error
+       if the message can't be transferred in this way, such as without DMA. */
+    rt_err_t (*xfer_start)(struct rt_spi_device *device, struct rt_spi_message *message);
+#endif
 };
 
 /**
@@ -109,7 +131,38 @@ struct rt_spi_device
 
     struct rt_spi_configuration config;
     void   *user_data;
+
+#ifdef RT_USING_SPI_ASYNC
+    rt_uint8_t priority;                        /* the priority of requests, the lower is the higher */
+#endif
+};
+
+#ifdef RT_USING_SPI_ASYNC
+#define RT_SPI_PRIORITY_DEFAULT     16
+
+/**
+ * SPI asynchronous request, the message list transferred by the async thread
+ * of bus
+ */
+struct rt_spi_request
+{
+    rt_list_t list;
+    struct rt_spi_device *device;
+
+    struct rt_spi_message *message;             /* the message list */
+    /* the completion callback runs in the async thread of bus with the bus lock
+       held, while the next request may be in transfer. It may submit requests
+       by rt_spi_transfer_message_async, but it shall not transfer on the same
+       bus synchronously, such as by rt_spi_transfer_message: the lock is taken
+       recursively by the same thread, and the transfer collides with the one
+       in progress. */
+    void (*complete)(struct rt_spi_request *request);
+    void *user_data;
+
+    rt_err_t result;                            /* RT_EOK or -RT_EIO */
+    struct rt_spi_message *failed;              /* the message failed */
 };
+#endif
 
 struct rt_qspi_message
 {
@@ -252,6 +305,27 @@ rt_size_t rt_spi_transfer(struct rt_spi_device *device,
 struct rt_spi_message *rt_spi_transfer_message(struct rt_spi_device  *device,
                                                struct rt_spi_message *message);
 
+#ifdef RT_USING_SPI_ASYNC
+/* set the priority of device in the asynchronous message queue */
+void rt_spi_set_priority(struct rt_spi_device *device, rt_uint8_t priority);
+
+/**
+ * This function submits a message list to the asynchronous message queue of
+ * SPI bus, and returns at once.
+ *
+ * @param device the SPI device attached to SPI bus
+ * @param request the request with the message list and completion callback,
+ *        it must be kept until the callback is invoked.
+ *
+ * @return RT_EOK on submitted successfully.
+ */
+rt_err_t rt_spi_transfer_message_async(struct rt_spi_device  *device,
+                                       struct rt_spi_request *request);
+
+/* the driver notifies the message started by xfer_start is done */
+void rt_spi_bus_xfer_done(struct rt_spi_bus *bus, rt_err_t result);
+#endif
+
 rt_inline rt_size_t rt_spi_recv(struct rt_spi_device *device,
                                 void                 *recv_buf,
                                 rt_size_t             length)
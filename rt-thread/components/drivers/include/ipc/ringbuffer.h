@@ -88,6 +88,42 @@ rt_inline rt_uint16_t rt_ringbuffer_get_size(struct rt_ringbuffer *rb)
 /** return the size of empty space in rb */
 #define rt_ringbuffer_space_len(rb) ((rb)->buffer_size - rt_ringbuffer_data_len(rb))
 
+/*
+ * Single-producer/single-consumer ring buffer.
+ *
+ * It can be used without lock when there is only one producer and one
+ * consumer, such as an ISR puts data and a thread gets data. The write_index
+ * is only changed by producer and the read_index is only changed by consumer.
+ * Both of the index count in [0, 2 * buffer_size), the range of
+ * [buffer_size, 2 * buffer_size) works as the mirror of buffer, so the full
+ * and empty buffer can be distinguished.
+ */
+struct rt_ringbuffer_spsc
+{
+    rt_uint8_t *buffer_ptr;
+    rt_uint32_t buffer_size;
+
+    volatile rt_uint32_t write_index;
+    volatile rt_uint32_t read_index;
+};
+
+void rt_ringbuffer_spsc_init(struct rt_ringbuffer_spsc *rb, rt_uint8_t *pool, rt_uint32_t size);
+void rt_ringbuffer_spsc_reset(struct rt_ringbuffer_spsc *rb);
+rt_size_t rt_ringbuffer_spsc_data_len(struct rt_ringbuffer_spsc *rb);
+rt_size_t rt_ringbuffer_spsc_space_len(struct rt_ringbuffer_spsc *rb);
+
+/* producer side */
+rt_size_t rt_ringbuffer_spsc_put(struct rt_ringbuffer_spsc *rb, const rt_uint8_t *ptr, rt_size_t length);
+rt_size_t rt_ringbuffer_spsc_putchar(struct rt_ringbuffer_spsc *rb, const rt_uint8_t ch);
+rt_size_t rt_ringbuffer_spsc_reserve(struct rt_ringbuffer_spsc *rb, rt_uint8_t **ptr);
+void rt_ringbuffer_spsc_commit(struct rt_ringbuffer_spsc *rb, rt_size_t length);
+
+/* consumer side */
+rt_size_t rt_ringbuffer_spsc_get(struct rt_ringbuffer_spsc *rb, rt_uint8_t *ptr, rt_size_t length);
+rt_size_t rt_ringbuffer_spsc_getchar(struct rt_ringbuffer_spsc *rb, rt_uint8_t *ch);
+rt_size_t rt_ringbuffer_spsc_peek(struct rt_ringbuffer_spsc *rb, rt_uint8_t **ptr);
+void rt_ringbuffer_spsc_consume(struct rt_ringbuffer_spsc *rb, rt_size_t length);
+
 
 #ifdef __cplusplus
 }
@@ -5,6 +5,7 @@
  *
  * Change Logs:
  * Date           Author       Notes
+ * 2026-10-17     RT-Thread    add the pool of work
  */
 #ifndef WORKQUEUE_H__
 #define WORKQUEUE_H__
@@ -25,6 +26,17 @@ enum
     RT_WORK_TYPE_DELAYED     = 0x0001,
 };
 
+/**
+ * priority lanes of workqueue pool
+ */
+enum
+{
+    RT_WORK_LANE_HIGH        = 0,
+    RT_WORK_LANE_NORMAL,
+    RT_WORK_LANE_LOW,
+    RT_WORK_LANE_NUM,
+};
+
 /* workqueue implementation */
 struct rt_workqueue
 {
@@ -43,6 +55,12 @@ struct rt_work
     void *work_data;
     rt_uint16_t flags;
     rt_uint16_t type;
+
+#ifdef RT_USING_WORKQUEUE_POOL
+    rt_uint8_t  lane;           /* priority lane in pool */
+    rt_tick_t   submit_tick;    /* the tick when work is queued */
+    struct rt_workqueue_pool *pool; /* the pool which the work is submitted to */
+#endif
 };
 
 struct rt_delayed_work
@@ -52,6 +70,39 @@ struct rt_delayed_work
     struct rt_workqueue *workqueue;
 };
 
+#ifdef RT_USING_WORKQUEUE_POOL
+/* statistics of a priority lane */
+struct rt_workqueue_lane_stat
+{
+    rt_uint32_t submitted;      /* works queued */
+    rt_uint32_t started;        /* works dispatched to worker */
+    rt_uint16_t depth;          /* works pending in lane */
+    rt_uint16_t max_depth;
+    rt_uint32_t total_latency;  /* ticks from queued to dispatched */
+    rt_uint32_t max_latency;
+};
+
+struct rt_workqueue_worker
+{
+    rt_thread_t    thread;
+    struct rt_work *work_current;
+    struct rt_workqueue_pool *pool;
+};
+
+/* workqueue pool, the works of lanes are dispatched to any idle worker */
+struct rt_workqueue_pool
+{
+    rt_list_t      lanes[RT_WORK_LANE_NUM];
+    struct rt_workqueue_lane_stat stats[RT_WORK_LANE_NUM];
+    rt_uint8_t     priorities[RT_WORK_LANE_NUM];
+
+    struct rt_semaphore sem;    /* the number of works to be dispatched */
+
+    rt_uint8_t     worker_num;
+    struct rt_workqueue_worker *workers;
+};
+#endif
+
 #ifdef RT_USING_HEAP
 /**
  * WorkQueue for DeviceDriver
@@ -63,9 +114,26 @@ rt_err_t rt_workqueue_submit_work(struct rt_workqueue *queue, struct rt_work *wo
 rt_err_t rt_workqueue_cancel_work(struct rt_workqueue *queue, struct rt_work *work);
 rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_work *work);
 
+#ifdef RT_USING_WORKQUEUE_POOL
+/**
+ * WorkQueue pool with multiple workers and priority lanes
+ */
+struct rt_workqueue_pool *rt_workqueue_pool_create(const char *name, rt_uint8_t worker_num,
+                                                   rt_uint16_t stack_size, rt_uint8_t priority);
+rt_err_t rt_workqueue_pool_destroy(struct rt_workqueue_pool *pool);
+rt_err_t rt_workqueue_pool_submit(struct rt_workqueue_pool *pool, struct rt_work *work,
+                                  rt_uint8_t lane, rt_tick_t time);
+rt_err_t rt_workqueue_pool_cancel(struct rt_workqueue_pool *pool, struct rt_work *work);
+void rt_workqueue_pool_stat(struct rt_workqueue_pool *pool, rt_uint8_t lane,
+                            struct rt_workqueue_lane_stat *stat);
+#endif
+
 #ifdef RT_USING_SYSTEM_WORKQUEUE
 rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t time);
 rt_err_t rt_work_cancel(struct rt_work *work);
+#ifdef RT_USING_WORKQUEUE_POOL
+rt_err_t rt_work_submit_lane(struct rt_work *work, rt_uint8_t lane, rt_tick_t time);
+#endif
 #endif
 
 rt_inline void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data),
@@ -76,6 +144,9 @@ rt_inline void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_wo
     work->work_data = work_data;
     work->flags = 0;
     work->type = 0;
+#ifdef RT_USING_WORKQUEUE_POOL
+    work->pool = RT_NULL;
+#endif
 }
 
 void rt_delayed_work_init(struct rt_delayed_work *work, void (*work_func)(struct rt_work *work,
@@ -89,6 +89,9 @@ extern "C" {
 
 #ifdef RT_USING_HWTIMER
 #include "drivers/hwtimer.h"
+#ifdef RT_USING_HRTIMER
+#include "drivers/hrtimer.h"
+#endif
 #endif
 
 #ifdef RT_USING_AUDIO
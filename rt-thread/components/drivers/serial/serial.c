@@ -22,6 +22,11 @@
  * 2017-11-15     JasonJia     fix poll rx issue when data is full.
  *                             add TCFLSH and FIONREAD support.
  * 2018-12-08     Ernest Chen  add DMA choice
+ * 2026-10-17     RT-Thread    add DMA rx spans and DMA tx ring
+ * 2026-10-17     RT-Thread    add rx frame mode
+ * 2026-10-17     RT-Thread    serialize the writers of DMA tx ring
+ * 2026-10-17     RT-Thread    confirm the frame gap by hrtimer, copy the frame
+ *                             with interrupt enabled
  */
 
 #include <rthw.h>
@@ -327,7 +332,7 @@ rt_inline int _serial_int_tx(struct rt_serial_device *serial, const rt_uint8_t *
     return size - length;
 }
 
-#if defined(RT_USING_POSIX) || defined(RT_SERIAL_USING_DMA)
+#if defined(RT_USING_POSIX) || defined(RT_SERIAL_USING_DMA) || defined(RT_SERIAL_USING_FRAME)
 static rt_size_t _serial_fifo_calc_recved_len(struct rt_serial_device *serial)
 {
     struct rt_serial_rx_fifo *rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
@@ -350,7 +355,7 @@ static rt_size_t _serial_fifo_calc_recved_len(struct rt_serial_device *serial)
         }
     }
 }
-#endif /* RT_USING_POSIX || RT_SERIAL_USING_DMA */
+#endif /* RT_USING_POSIX || RT_SERIAL_USING_DMA || RT_SERIAL_USING_FRAME */
 
 #ifdef RT_SERIAL_USING_DMA
 /**
@@ -431,6 +436,7 @@ static void rt_dma_recv_update_put_index(struct rt_serial_device *serial, rt_siz
     if(rx_fifo->is_full == RT_TRUE)
     {
         rx_fifo->get_index = rx_fifo->put_index;
+        rx_fifo->overrun ++;
     }
 }
 
@@ -494,6 +500,116 @@ rt_inline int _serial_dma_rx(struct rt_serial_device *serial, rt_uint8_t *data,
     }
 }
 
+#ifdef RT_SERIAL_USING_DMA_TX_RING
+/**
+ * Start next DMA burst with the pending data in tx ring, it's invoked with
+ * interrupt disabled.
+ *
+ * @param serial serial device
+ *
+ * @return the length of burst, 0 for no pending data
+ */
+static rt_size_t rt_dma_tx_start_burst(struct rt_serial_device *serial)
+{
+    struct rt_serial_tx_dma *tx_dma = (struct rt_serial_tx_dma *) serial->serial_tx;
+
+    /* the burst is the contiguous pending data from get index */
+    tx_dma->burst = tx_dma->count;
+    if (tx_dma->get_index + tx_dma->burst > RT_SERIAL_DMA_TX_BUFSZ)
+    {
+        tx_dma->burst = RT_SERIAL_DMA_TX_BUFSZ - tx_dma->get_index;
+    }
+
+    if (tx_dma->burst)
+    {
+        tx_dma->activated = RT_TRUE;
+        tx_dma->stats.bursts ++;
+    }
+    else
+    {
+        tx_dma->activated = RT_FALSE;
+    }
+
+    return tx_dma->burst;
+}
+
+/*
+ * The data is copied to tx ring, it's sent in one DMA burst with the other
+ * data written while the current burst is in flight. The writers in thread
+ * are serialized by the lock, so only one of them waits on the completion
+ * when the tx ring is full.
+ */
+rt_inline int _serial_dma_tx(struct rt_serial_device *serial, const rt_uint8_t *data, int length)
+{
+    rt_base_t level;
+    rt_tick_t tick;
+    rt_size_t len, burst;
+    rt_bool_t locked;
+    struct rt_serial_tx_dma *tx_dma;
+    int size = length;
+
+    tx_dma = (struct rt_serial_tx_dma*)(serial->serial_tx);
+
+    /* don't lock or wait in interrupt or before the scheduler starts */
+    locked = (rt_interrupt_get_nest() == 0 && rt_thread_self() != RT_NULL);
+    if (locked)
+    {
+        rt_mutex_take(&(tx_dma->lock), RT_WAITING_FOREVER);
+    }
+
+    while (length)
+    {
+        level = rt_hw_interrupt_disable();
+        if (tx_dma->count == RT_SERIAL_DMA_TX_BUFSZ)
+        {
+            rt_hw_interrupt_enable(level);
+
+            /* the tx ring is full, return the bytes copied */
+            if (locked != RT_TRUE) break;
+
+            tick = rt_tick_get();
+            rt_completion_wait(&(tx_dma->completion), RT_WAITING_FOREVER);
+            tx_dma->stats.stalls ++;
+            tx_dma->stats.stall_time += rt_tick_get() - tick;
+            continue;
+        }
+
+        /* copy the contiguous space at put index */
+        len = RT_SERIAL_DMA_TX_BUFSZ - tx_dma->count;
+        if (len > RT_SERIAL_DMA_TX_BUFSZ - tx_dma->put_index)
+            len = RT_SERIAL_DMA_TX_BUFSZ - tx_dma->put_index;
+        if (len > (rt_size_t)length)
+            len = length;
+
+        rt_memcpy(tx_dma->buffer + tx_dma->put_index, data, len);
+        tx_dma->put_index = (tx_dma->put_index + len) % RT_SERIAL_DMA_TX_BUFSZ;
+        tx_dma->count += len;
+        tx_dma->stats.bytes += len;
+        data += len; length -= len;
+
+        if (tx_dma->activated != RT_TRUE)
+        {
+            burst = rt_dma_tx_start_burst(serial);
+            rt_hw_interrupt_enable(level);
+
+            /* make a DMA transfer */
+            serial->ops->dma_transmit(serial, tx_dma->buffer + tx_dma->get_index, burst, RT_SERIAL_DMA_TX);
+        }
+        else
+        {
+            rt_hw_interrupt_enable(level);
+        }
+    }
+    tx_dma->stats.writes ++;
+
+    if (locked)
+    {
+        rt_mutex_release(&(tx_dma->lock));
+    }
+
+    return size - length;
+}
+#else
 rt_inline int _serial_dma_tx(struct rt_serial_device *serial, const rt_uint8_t *data, int length)
 {
     rt_base_t level;
@@ -527,8 +643,415 @@ rt_inline int _serial_dma_tx(struct rt_serial_device *serial, const rt_uint8_t *
         return 0;
     }
 }
+#endif /* RT_SERIAL_USING_DMA_TX_RING */
+
+/**
+ * This function will acquire the received data in the DMA receive fifo
+ * without copy. The data is in the first span, and the rest of it is in the
+ * second span when it wraps around the end of fifo. The data stays in the
+ * fifo until it's released by rt_serial_rx_release.
+ *
+ * @param dev the serial device opened with RT_DEVICE_FLAG_DMA_RX
+ * @param span the spans of received data
+ *
+ * @return the total length of received data, 0 for no data or the device
+ *         doesn't work in DMA receive fifo mode.
+ */
+rt_size_t rt_serial_rx_acquire(rt_device_t dev, struct rt_serial_rx_span *span)
+{
+    struct rt_serial_device *serial = (struct rt_serial_device *)dev;
+    struct rt_serial_rx_fifo *rx_fifo;
+    rt_size_t length;
+    rt_base_t level;
+
+    RT_ASSERT((serial != RT_NULL) && (span != RT_NULL));
+
+    span->data[0] = span->data[1] = RT_NULL;
+    span->size[0] = span->size[1] = 0;
+    span->overrun = 0;
+
+    if (!(dev->open_flag & RT_DEVICE_FLAG_DMA_RX) || serial->config.bufsz == 0)
+    {
+        rt_set_errno(-RT_ENOSYS);
+        return 0;
+    }
+
+    rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+    RT_ASSERT(rx_fifo != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    length = rt_dma_calc_recved_len(serial);
+    if (length)
+    {
+        span->data[0] = rx_fifo->buffer + rx_fifo->get_index;
+        if (rx_fifo->get_index + length <= serial->config.bufsz)
+        {
+            span->size[0] = length;
+        }
+        else
+        {
+            /* wrap around the end of fifo */
+            span->size[0] = serial->config.bufsz - rx_fifo->get_index;
+            span->data[1] = rx_fifo->buffer;
+            span->size[1] = length - span->size[0];
+        }
+    }
+    span->overrun = rx_fifo->overrun;
+    rt_hw_interrupt_enable(level);
+
+    return length;
+}
+
+/**
+ * This function will release the data acquired by rt_serial_rx_acquire, then
+ * the space can be used by DMA again.
+ *
+ * @param dev the serial device
+ * @param span the spans returned by rt_serial_rx_acquire
+ * @param len the length of data consumed from the beginning of spans
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the fifo is overrun after the
+ *         spans are acquired, the data in spans may be overwritten and nothing
+ *         is released, please acquire again.
+ */
+rt_err_t rt_serial_rx_release(rt_device_t dev, struct rt_serial_rx_span *span, rt_size_t len)
+{
+    struct rt_serial_device *serial = (struct rt_serial_device *)dev;
+    struct rt_serial_rx_fifo *rx_fifo;
+    rt_base_t level;
+
+    RT_ASSERT((serial != RT_NULL) && (span != RT_NULL));
+    RT_ASSERT(len <= span->size[0] + span->size[1]);
+
+    if (len == 0)
+        return RT_EOK;
+
+    rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+    RT_ASSERT(rx_fifo != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    if (rx_fifo->overrun != span->overrun)
+    {
+        /* the get index has been forced to the put index by DMA */
+        rt_hw_interrupt_enable(level);
+        return -RT_EFULL;
+    }
+    rt_dma_recv_update_get_index(serial, len);
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
 #endif /* RT_SERIAL_USING_DMA */
 
+#ifdef RT_SERIAL_USING_FRAME
+/*
+ * Serial frame mode routines
+ */
+
+/* drop the frames consumed by read or overwritten in fifo, it's invoked with
+ * interrupt disabled */
+static void _serial_frame_drop(struct rt_serial_device *serial)
+{
+    struct rt_serial_rx_frame *rx_frame = serial->rx_frame;
+    rt_uint32_t consumed;
+
+    consumed = rx_frame->received - _serial_fifo_calc_recved_len(serial);
+    while (rx_frame->count)
+    {
+        if ((rt_int32_t)(rx_frame->frames[rx_frame->get_index].end - consumed) > 0)
+            break;
+
+        rx_frame->get_index = (rx_frame->get_index + 1) % RT_SERIAL_FRAME_NUM;
+        rx_frame->count --;
+    }
+}
+
+static rt_bool_t _serial_frame_end(struct rt_serial_device *serial, rt_uint32_t timestamp)
+{
+    struct rt_serial_rx_frame *rx_frame = serial->rx_frame;
+    struct rt_serial_frame *frame;
+
+    /* no data received after last frame */
+    if (rx_frame->received == rx_frame->last_end)
+        return RT_FALSE;
+
+    /* the frames read by rt_device_read don't pile up */
+    _serial_frame_drop(serial);
+    if (rx_frame->count < RT_SERIAL_FRAME_NUM)
+    {
+        frame = &rx_frame->frames[rx_frame->put_index];
+        frame->end = rx_frame->received;
+        frame->timestamp = timestamp;
+
+        rx_frame->put_index = (rx_frame->put_index + 1) % RT_SERIAL_FRAME_NUM;
+        rx_frame->count ++;
+    }
+    else
+    {
+        /* the data of dropped frame is read with next frame */
+        rx_frame->dropped ++;
+    }
+    rx_frame->last_end = rx_frame->received;
+
+    return RT_TRUE;
+}
+
+static void _serial_frame_indicate(struct rt_serial_device *serial)
+{
+    rt_size_t length;
+    rt_base_t level;
+
+    if (serial->parent.rx_indicate != RT_NULL)
+    {
+        level = rt_hw_interrupt_disable();
+        length = _serial_fifo_calc_recved_len(serial);
+        rt_hw_interrupt_enable(level);
+
+        serial->parent.rx_indicate(&(serial->parent), length);
+    }
+}
+
+/* the gap is confirmed if there is no data received after the idle line */
+static void _serial_frame_timeout(void *parameter)
+{
+    struct rt_serial_device *serial = (struct rt_serial_device *)parameter;
+    struct rt_serial_rx_frame *rx_frame;
+    rt_bool_t ended = RT_FALSE;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rx_frame = serial->rx_frame;
+    if (rx_frame && rx_frame->received == rx_frame->idle_received)
+    {
+        ended = _serial_frame_end(serial, rx_frame->idle_timestamp);
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (ended) _serial_frame_indicate(serial);
+}
+
+/*
+ * The receiver timeout ends the frame at once. The idle line is one
+ * character of gap, the frame is ended when the rest of gap is confirmed.
+ */
+static void _serial_frame_idle(struct rt_serial_device *serial, int event)
+{
+    struct rt_serial_rx_frame *rx_frame = serial->rx_frame;
+    rt_bool_t ended = RT_FALSE;
+    rt_uint32_t now;
+    rt_base_t level;
+
+    if (rx_frame == RT_NULL) return;
+
+    now = clock_cpu_gettime();
+
+    level = rt_hw_interrupt_disable();
+    if (event == RT_SERIAL_EVENT_RX_TIMEOUT)
+    {
+        ended = _serial_frame_end(serial, now - rx_frame->gap_delay);
+    }
+    else if (rx_frame->confirm == 0)
+    {
+        ended = _serial_frame_end(serial, now - rx_frame->idle_delay);
+    }
+    else if (rx_frame->received != rx_frame->last_end)
+    {
+        rx_frame->idle_received = rx_frame->received;
+        rx_frame->idle_timestamp = now - rx_frame->idle_delay;
+#ifdef RT_USING_HRTIMER
+        if (rt_hrtimer_start(&(rx_frame->hrtimer), rx_frame->confirm_us) != RT_EOK)
+#endif
+        {
+            /* the gap is confirmed in ticks, which is coarse */
+            rt_timer_start(&(rx_frame->timer));
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (ended) _serial_frame_indicate(serial);
+}
+
+/* convert the time of bits to CPU time */
+static rt_uint32_t _serial_frame_cputime(struct rt_serial_device *serial, rt_uint32_t bits)
+{
+    float resolution = clock_cpu_getres();
+
+    if (resolution == 0)
+        return 0;
+
+    return (rt_uint32_t)((rt_uint64_t)bits * 1000000000ULL / serial->config.baud_rate / resolution);
+}
+
+static rt_err_t _serial_frame_config(struct rt_serial_device *serial, rt_uint32_t gap)
+{
+    struct rt_serial_rx_frame *rx_frame = serial->rx_frame;
+    rt_uint32_t char_bits, gap_bits;
+    rt_tick_t confirm;
+    rt_base_t level;
+
+    if (gap == 0)
+    {
+        if (rx_frame != RT_NULL)
+        {
+            serial->ops->control(serial, RT_SERIAL_CTRL_SET_FRAME_GAP, (void *)0);
+
+            level = rt_hw_interrupt_disable();
+            serial->rx_frame = RT_NULL;
+            rt_hw_interrupt_enable(level);
+
+            rt_timer_detach(&(rx_frame->timer));
+#ifdef RT_USING_HRTIMER
+            rt_hrtimer_stop(&(rx_frame->hrtimer));
+#endif
+            rt_free(rx_frame);
+        }
+
+        return RT_EOK;
+    }
+
+    /* the frame is delimited in receive fifo */
+    if (!(serial->parent.open_flag & (RT_DEVICE_FLAG_INT_RX | RT_DEVICE_FLAG_DMA_RX)) ||
+            serial->serial_rx == RT_NULL || serial->config.bufsz == 0)
+    {
+        return -RT_ENOSYS;
+    }
+
+    if (rx_frame == RT_NULL)
+    {
+        rx_frame = (struct rt_serial_rx_frame *) rt_malloc(sizeof(struct rt_serial_rx_frame));
+        if (rx_frame == RT_NULL) return -RT_ENOMEM;
+
+        rt_memset(rx_frame, 0, sizeof(struct rt_serial_rx_frame));
+        rt_timer_init(&(rx_frame->timer), serial->parent.parent.name, _serial_frame_timeout,
+                      serial, 1, RT_TIMER_FLAG_ONE_SHOT);
+#ifdef RT_USING_HRTIMER
+        rt_hrtimer_init(&(rx_frame->hrtimer), serial->parent.parent.name, _serial_frame_timeout,
+                        serial, RT_HRTIMER_FLAG_ONE_SHOT);
+#endif
+    }
+
+    /* start bit, data bits, parity bit and stop bits */
+    char_bits = 1 + serial->config.data_bits + (serial->config.parity != PARITY_NONE ? 1 : 0) +
+                (serial->config.stop_bits == STOP_BITS_2 ? 2 : 1);
+    gap_bits = (gap * char_bits + 9) / 10;
+
+    rx_frame->gap = gap;
+    rx_frame->gap_delay = _serial_frame_cputime(serial, gap_bits);
+    rx_frame->idle_delay = _serial_frame_cputime(serial, char_bits);
+
+    /* the rest of gap after the idle line, and one more tick for the partial tick */
+    confirm = 0;
+    if (gap_bits > char_bits)
+    {
+        confirm = (rt_tick_t)(((rt_uint64_t)(gap_bits - char_bits) * RT_TICK_PER_SECOND +
+                               serial->config.baud_rate - 1) / serial->config.baud_rate) + 1;
+        rt_timer_control(&(rx_frame->timer), RT_TIMER_CTRL_SET_TIME, &confirm);
+#ifdef RT_USING_HRTIMER
+        rx_frame->confirm_us = (rt_uint32_t)(((rt_uint64_t)(gap_bits - char_bits) * 1000000 +
+                                              serial->config.baud_rate - 1) / serial->config.baud_rate);
+#endif
+    }
+    rx_frame->confirm = confirm;
+
+    level = rt_hw_interrupt_disable();
+    serial->rx_frame = rx_frame;
+    rt_hw_interrupt_enable(level);
+
+    /* configure the receiver timeout of low level device */
+    serial->ops->control(serial, RT_SERIAL_CTRL_SET_FRAME_GAP, (void *)(rt_ubase_t)gap_bits);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will read one frame received in frame mode. The frame is
+ * delimited by the inter-character gap set by RT_SERIAL_CTRL_SET_FRAME_GAP,
+ * the data of the frame consumed by rt_device_read is skipped.
+ *
+ * @param dev the serial device
+ * @param buffer the buffer of frame
+ * @param size the size of buffer, the rest of a longer frame is discarded
+ * @param timestamp the CPU time of the last character of frame, RT_NULL for
+ *        ignore
+ *
+ * @return the length of frame read, 0 for no frame received
+ */
+rt_size_t rt_serial_frame_read(rt_device_t dev, void *buffer, rt_size_t size, rt_uint32_t *timestamp)
+{
+    struct rt_serial_device *serial = (struct rt_serial_device *)dev;
+    struct rt_serial_rx_frame *rx_frame;
+    struct rt_serial_rx_fifo *rx_fifo;
+    struct rt_serial_frame *frame;
+    rt_uint32_t received, recved_len, space, length, stamp;
+    rt_uint16_t get_index;
+    rt_size_t bufsz, count;
+    rt_uint8_t *data = (rt_uint8_t *)buffer;
+    rt_base_t level;
+
+    RT_ASSERT(serial != RT_NULL);
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        rx_frame = serial->rx_frame;
+        if (rx_frame == RT_NULL)
+        {
+            rt_hw_interrupt_enable(level);
+            rt_set_errno(-RT_ENOSYS);
+            return 0;
+        }
+        rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+        bufsz = serial->config.bufsz;
+
+        /* drop the frames consumed by read or overwritten in fifo */
+        _serial_frame_drop(serial);
+        if (rx_frame->count == 0)
+        {
+            rt_hw_interrupt_enable(level);
+            return 0;
+        }
+
+        frame = &rx_frame->frames[rx_frame->get_index];
+        received = rx_frame->received;
+        recved_len = _serial_fifo_calc_recved_len(serial);
+        space = bufsz - recved_len;
+        length = frame->end - (received - recved_len);
+        get_index = rx_fifo->get_index;
+        stamp = frame->timestamp;
+        rt_hw_interrupt_enable(level);
+
+        /* copy the frame with interrupt enabled, the receiving goes on */
+        count = size > length ? length : size;
+        if (get_index + count <= bufsz)
+        {
+            rt_memcpy(data, rx_fifo->buffer + get_index, count);
+        }
+        else
+        {
+            rt_memcpy(data, rx_fifo->buffer + get_index, bufsz - get_index);
+            rt_memcpy(data + bufsz - get_index, rx_fifo->buffer, count + get_index - bufsz);
+        }
+
+        level = rt_hw_interrupt_disable();
+        /* the frame is neither read nor overwritten during the copy */
+        if (serial->rx_frame == rx_frame && rx_fifo->get_index == get_index &&
+                rx_frame->received - received <= space)
+        {
+            /* release the whole frame */
+            rx_fifo->is_full = RT_FALSE;
+            rx_fifo->get_index = (get_index + length) % bufsz;
+            rx_frame->get_index = (rx_frame->get_index + 1) % RT_SERIAL_FRAME_NUM;
+            rx_frame->count --;
+            rt_hw_interrupt_enable(level);
+
+            if (timestamp) *timestamp = stamp;
+            return count;
+        }
+        rt_hw_interrupt_enable(level);
+    }
+}
+#endif /* RT_SERIAL_USING_FRAME */
+
 /* RT-Thread Device Interface */
 /*
  * This function initializes serial device.
@@ -544,6 +1067,9 @@ static rt_err_t rt_serial_init(struct rt_device *dev)
     /* initialize rx/tx */
     serial->serial_rx = RT_NULL;
     serial->serial_tx = RT_NULL;
+#ifdef RT_SERIAL_USING_FRAME
+    serial->rx_frame = RT_NULL;
+#endif
 
     /* apply configuration */
     if (serial->ops->configure)
@@ -622,6 +1148,7 @@ static rt_err_t rt_serial_open(struct rt_device *dev, rt_uint16_t oflag)
                 rx_fifo->put_index = 0;
                 rx_fifo->get_index = 0;
                 rx_fifo->is_full = RT_FALSE;
+                rx_fifo->overrun = 0;
                 serial->serial_rx = rx_fifo;
                 /* configure fifo address and length to low level device */
                 serial->ops->control(serial, RT_DEVICE_CTRL_CONFIG, (void *) RT_DEVICE_FLAG_DMA_RX);
@@ -665,11 +1192,27 @@ static rt_err_t rt_serial_open(struct rt_device *dev, rt_uint16_t oflag)
         {
             struct rt_serial_tx_dma* tx_dma;
 
+#ifdef RT_SERIAL_USING_DMA_TX_RING
+            tx_dma = (struct rt_serial_tx_dma*) rt_malloc (sizeof(struct rt_serial_tx_dma) +
+                RT_SERIAL_DMA_TX_BUFSZ);
+            RT_ASSERT(tx_dma != RT_NULL);
+            tx_dma->activated = RT_FALSE;
+
+            tx_dma->buffer = (rt_uint8_t*) (tx_dma + 1);
+            tx_dma->put_index = 0;
+            tx_dma->get_index = 0;
+            tx_dma->count = 0;
+            tx_dma->burst = 0;
+            rt_completion_init(&(tx_dma->completion));
+            rt_mutex_init(&(tx_dma->lock), "serdma", RT_IPC_FLAG_FIFO);
+            rt_memset(&(tx_dma->stats), 0, sizeof(tx_dma->stats));
+#else
             tx_dma = (struct rt_serial_tx_dma*) rt_malloc (sizeof(struct rt_serial_tx_dma));
             RT_ASSERT(tx_dma != RT_NULL);
             tx_dma->activated = RT_FALSE;
 
             rt_data_queue_init(&(tx_dma->data_queue), 8, 4, RT_NULL);
+#endif
             serial->serial_tx = tx_dma;
 
             dev->open_flag |= RT_DEVICE_FLAG_DMA_TX;
@@ -708,6 +1251,10 @@ static rt_err_t rt_serial_close(struct rt_device *dev)
     /* this device has more reference count */
     if (dev->ref_count > 1) return RT_EOK;
 
+#ifdef RT_SERIAL_USING_FRAME
+    _serial_frame_config(serial, 0);
+#endif
+
     if (dev->open_flag & RT_DEVICE_FLAG_INT_RX)
     {
         struct rt_serial_rx_fifo* rx_fifo;
@@ -767,6 +1314,17 @@ static rt_err_t rt_serial_close(struct rt_device *dev)
         tx_dma = (struct rt_serial_tx_dma*)serial->serial_tx;
         RT_ASSERT(tx_dma != RT_NULL);
 
+#ifdef RT_SERIAL_USING_DMA_TX_RING
+        /* wait for the pending data in tx ring to be sent */
+        rt_mutex_take(&(tx_dma->lock), RT_WAITING_FOREVER);
+        while (tx_dma->count != 0)
+        {
+            if (rt_completion_wait(&(tx_dma->completion), RT_TICK_PER_SECOND) != RT_EOK)
+                break;
+        }
+        rt_mutex_detach(&(tx_dma->lock));
+#endif
+
         rt_free(tx_dma);
         serial->serial_tx = RT_NULL;
         dev->open_flag &= ~RT_DEVICE_FLAG_DMA_TX;
@@ -963,11 +1521,22 @@ static rt_err_t rt_serial_control(struct rt_device *dev,
                 {
                     /* serial device has been opened, to configure it */
                     serial->ops->configure(serial, (struct serial_configure *) args);
+#ifdef RT_SERIAL_USING_FRAME
+                    /* the gap depends on baud rate */
+                    if (serial->rx_frame)
+                        _serial_frame_config(serial, serial->rx_frame->gap);
+#endif
                 }
             }
 
             break;
 
+#ifdef RT_SERIAL_USING_FRAME
+        case RT_SERIAL_CTRL_SET_FRAME_GAP:
+            ret = _serial_frame_config(serial, (rt_uint32_t)(rt_ubase_t)args);
+            break;
+#endif
+
 #ifdef RT_USING_POSIX_TERMIOS
         case TCGETA:
             {
@@ -1161,6 +1730,9 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
                 level = rt_hw_interrupt_disable();
 
                 rx_fifo->buffer[rx_fifo->put_index] = ch;
+#ifdef RT_SERIAL_USING_FRAME
+                if (serial->rx_frame) serial->rx_frame->received ++;
+#endif
                 rx_fifo->put_index += 1;
                 if (rx_fifo->put_index >= serial->config.bufsz) rx_fifo->put_index = 0;
 
@@ -1176,6 +1748,11 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
                 rt_hw_interrupt_enable(level);
             }
 
+#ifdef RT_SERIAL_USING_FRAME
+            /* indicate at the end of frame */
+            if (serial->rx_frame) break;
+#endif
+
             /* invoke callback */
             if (serial->parent.rx_indicate != RT_NULL)
             {
@@ -1204,6 +1781,38 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
         }
 #ifdef RT_SERIAL_USING_DMA
         case RT_SERIAL_EVENT_TX_DMADONE:
+#ifdef RT_SERIAL_USING_DMA_TX_RING
+        {
+            struct rt_serial_tx_dma *tx_dma;
+            rt_size_t burst;
+            rt_base_t level;
+
+            tx_dma = (struct rt_serial_tx_dma*) serial->serial_tx;
+
+            level = rt_hw_interrupt_disable();
+            /* release the space of last burst */
+            tx_dma->get_index = (tx_dma->get_index + tx_dma->burst) % RT_SERIAL_DMA_TX_BUFSZ;
+            tx_dma->count -= tx_dma->burst;
+
+            /* send the data written during last burst */
+            burst = rt_dma_tx_start_burst(serial);
+            rt_hw_interrupt_enable(level);
+            if (burst)
+            {
+                serial->ops->dma_transmit(serial, tx_dma->buffer + tx_dma->get_index, burst, RT_SERIAL_DMA_TX);
+            }
+
+            /* wake up the write waiting for the tx ring */
+            rt_completion_done(&(tx_dma->completion));
+
+            /* invoke callback when all of the data is sent */
+            if (burst == 0 && serial->parent.tx_complete != RT_NULL)
+            {
+                serial->parent.tx_complete(&serial->parent, RT_NULL);
+            }
+            break;
+        }
+#else
         {
             const void *data_ptr;
             rt_size_t data_size;
@@ -1231,6 +1840,7 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
             }
             break;
         }
+#endif /* RT_SERIAL_USING_DMA_TX_RING */
         case RT_SERIAL_EVENT_RX_DMADONE:
         {
             int length;
@@ -1256,6 +1866,16 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
                 level = rt_hw_interrupt_disable();
                 /* update fifo put index */
                 rt_dma_recv_update_put_index(serial, length);
+#ifdef RT_SERIAL_USING_FRAME
+                if (serial->rx_frame)
+                {
+                    serial->rx_frame->received += length;
+                    rt_hw_interrupt_enable(level);
+
+                    /* indicate at the end of frame */
+                    break;
+                }
+#endif
                 /* calculate received total length */
                 length = rt_dma_calc_recved_len(serial);
                 /* enable interrupt */
@@ -1269,6 +1889,58 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
             break;
         }
 #endif /* RT_SERIAL_USING_DMA */
+#ifdef RT_SERIAL_USING_FRAME
+        case RT_SERIAL_EVENT_RX_TIMEOUT:
+        case RT_SERIAL_EVENT_RX_IDLE:
+        {
+            _serial_frame_idle(serial, event & 0xff);
+            break;
+        }
+#endif /* RT_SERIAL_USING_FRAME */
     }
 }
 
+
+#if defined(RT_SERIAL_USING_DMA_TX_RING) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+static int list_serial_tx(void)
+{
+    struct rt_object_information *information;
+    struct rt_serial_device *serial;
+    struct rt_serial_tx_dma *tx_dma;
+    struct rt_list_node *node;
+    struct rt_device *device;
+
+    rt_kprintf("%-*.*s bytes      writes     bursts     stalls     stall(ms) pending\n",
+               RT_NAME_MAX, RT_NAME_MAX, "device");
+    rt_kprintf("%-*.*s ---------- ---------- ---------- ---------- --------- -------\n",
+               RT_NAME_MAX, RT_NAME_MAX, "--------------------");
+
+    information = rt_object_get_information(RT_Object_Class_Device);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        device = (struct rt_device *)rt_list_entry(node, struct rt_object, list);
+#ifdef RT_USING_DEVICE_OPS
+        if (device->ops != &serial_ops) continue;
+#else
+        if (device->write != rt_serial_write) continue;
+#endif
+        if (!(device->open_flag & RT_DEVICE_FLAG_DMA_TX)) continue;
+
+        serial = (struct rt_serial_device *)device;
+        tx_dma = (struct rt_serial_tx_dma *)serial->serial_tx;
+        if (tx_dma == RT_NULL) continue;
+
+        rt_kprintf("%-*.*s %-10d %-10d %-10d %-10d %-9d %d\n", RT_NAME_MAX, RT_NAME_MAX,
+                   device->parent.name, tx_dma->stats.bytes, tx_dma->stats.writes,
+                   tx_dma->stats.bursts, tx_dma->stats.stalls,
+                   tx_dma->stats.stall_time * 1000 / RT_TICK_PER_SECOND, tx_dma->count);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_serial_tx, list the DMA tx statistics of serial devices);
+#endif /* RT_SERIAL_USING_DMA_TX_RING && RT_USING_FINSH */
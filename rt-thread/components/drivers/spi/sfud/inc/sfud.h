@@ -92,6 +92,18 @@ const sfud_flash *sfud_get_device_table(void);
 sfud_err sfud_qspi_fast_read_enable(sfud_flash *flash, uint8_t data_line_width);
 #endif /* SFUD_USING_QSPI */
 
+#ifdef SFUD_USING_READ_CACHE
+/**
+ * Enable or disable the read-ahead cache. It's enabled by default after sfud_device_init().
+ *
+ * @param flash flash device
+ * @param enabled true: enable, false: disable
+ *
+ * @return result
+ */
+sfud_err sfud_read_cache_enable(sfud_flash *flash, bool enabled);
+#endif /* SFUD_USING_READ_CACHE */
+
 /**
  * read flash data
  *
@@ -52,6 +52,14 @@
 #define SFUD_USING_QSPI
 #endif
 
+/**
+ * Using read-ahead cache for small reads, the number of 256 bytes cache lines per flash device.
+ */
+#ifdef RT_SFUD_USING_READ_CACHE
+#define SFUD_USING_READ_CACHE
+#define SFUD_READ_CACHE_LINE_NUM RT_SFUD_READ_CACHE_LINE_NUM
+#endif
+
 /**
  * Using probe flash JEDEC ID then query defined supported flash chip information table. @see SFUD_FLASH_CHIP_TABLE
  */
@@ -178,6 +178,27 @@ if (!(EXPR))                                                                   \
 /* maximum number of erase type support on JESD216 (V1.0) */
 #define SFUD_SFDP_ERASE_TYPE_MAX_NUM                      4
 
+/* fast read type in SFDP fast read table, 1-2-2 means 1 instruction line, 2 address lines and 2 data lines */
+enum {
+    SFUD_SFDP_FAST_READ_1_1_2,
+    SFUD_SFDP_FAST_READ_1_2_2,
+    SFUD_SFDP_FAST_READ_1_1_4,
+    SFUD_SFDP_FAST_READ_1_4_4,
+    SFUD_SFDP_FAST_READ_TYPE_MAX_NUM,
+};
+
+#ifdef SFUD_USING_READ_CACHE
+/* read cache line size, the read smaller than it is served by read cache */
+#ifndef SFUD_READ_CACHE_LINE_SIZE
+#define SFUD_READ_CACHE_LINE_SIZE                      256
+#endif
+
+/* the number of read cache lines */
+#ifndef SFUD_READ_CACHE_LINE_NUM
+#define SFUD_READ_CACHE_LINE_NUM                       4
+#endif
+#endif /* SFUD_USING_READ_CACHE */
+
 /**
  * status register bits
  */
@@ -237,10 +258,37 @@ typedef struct {
         uint32_t size;                           /**< erase sector size (bytes). 0x00: not available */
         uint8_t cmd;                             /**< erase command */
     } eraser[SFUD_SFDP_ERASE_TYPE_MAX_NUM];      /**< supported eraser types table */
-    //TODO lots of fast read-related stuff (like modes supported and number of wait states/dummy cycles needed in each)
+    struct {
+        uint8_t cmd;                             /**< fast read command. 0x00: not available */
+        uint8_t dummy_cycles;                    /**< wait states and mode clocks */
+    } fast_read[SFUD_SFDP_FAST_READ_TYPE_MAX_NUM]; /**< supported fast read types table */
 } sfud_sfdp, *sfud_sfdp_t;
 #endif
 
+#ifdef SFUD_USING_READ_CACHE
+/**
+ * read cache line, it's filled by one read command
+ */
+typedef struct {
+    bool valid;                                  /**< the line is filled */
+    uint32_t addr;                               /**< start address, align by line size */
+    uint32_t stamp;                              /**< the last access stamp for LRU eviction */
+    uint8_t data[SFUD_READ_CACHE_LINE_SIZE];     /**< the cached data */
+} sfud_read_cache_line;
+
+/**
+ * read-ahead cache of flash device
+ */
+typedef struct {
+    bool enabled;                                /**< the small reads are served by cache */
+    uint32_t stamp;                              /**< access stamp */
+    uint32_t next_addr;                          /**< the end address of last read for sequential detection */
+    size_t hits;                                 /**< the cache line hit times */
+    size_t misses;                               /**< the cache line fill times */
+    sfud_read_cache_line line[SFUD_READ_CACHE_LINE_NUM];
+} sfud_read_cache;
+#endif /* SFUD_USING_READ_CACHE */
+
 /**
  * SPI device
  */
@@ -287,6 +335,10 @@ typedef struct {
     sfud_sfdp sfdp;                              /**< serial flash discoverable parameters by JEDEC standard */
 #endif
 
+#ifdef SFUD_USING_READ_CACHE
+    sfud_read_cache read_cache;                  /**< read-ahead cache */
+#endif
+
 } sfud_flash, *sfud_flash_t;
 
 #ifdef __cplusplus
@@ -62,7 +62,7 @@ enum sfud_qspi_read_mode {
 static const sfud_qspi_flash_ext_info qspi_flash_ext_info_table[] = SFUD_FLASH_EXT_INFO_TABLE;
 #endif /* SFUD_USING_QSPI */
 
-static sfud_err software_init(const sfud_flash *flash);
+static sfud_err software_init(sfud_flash *flash);
 static sfud_err hardware_init(sfud_flash *flash);
 static sfud_err page256_or_1_byte_write(const sfud_flash *flash, uint32_t addr, size_t size, uint16_t write_gran,
         const uint8_t *data);
@@ -73,6 +73,10 @@ static sfud_err read_jedec_id(sfud_flash *flash);
 static sfud_err set_write_enabled(const sfud_flash *flash, bool enabled);
 static sfud_err set_4_byte_address_mode(sfud_flash *flash, bool enabled);
 static void make_adress_byte_array(const sfud_flash *flash, uint32_t addr, uint8_t *array);
+#ifdef SFUD_USING_READ_CACHE
+static sfud_err read_cache_read(const sfud_flash *flash, uint32_t addr, size_t size, uint8_t *data);
+static void read_cache_invalidate(const sfud_flash *flash, uint32_t addr, size_t size);
+#endif
 
 /* ../port/sfup_port.c */
 extern void sfud_log_debug(const char *file, const long line, const char *format, ...);
@@ -181,11 +185,29 @@ static void qspi_set_read_cmd_format(sfud_flash *flash, uint8_t ins, uint8_t ins
     flash->read_cmd_format.data_lines = data_lines;
 }
 
+#ifdef SFUD_USING_SFDP
+/**
+ * set the fast read cmd format by SFDP fast read table
+ *
+ * @return true: the fast read type is supported
+ */
+static bool qspi_set_sfdp_read_cmd_format(sfud_flash *flash, size_t type, uint8_t addr_lines, uint8_t data_lines) {
+    if (!flash->sfdp.available || flash->sfdp.fast_read[type].cmd == 0x00) {
+        return false;
+    }
+
+    qspi_set_read_cmd_format(flash, flash->sfdp.fast_read[type].cmd, 1, addr_lines,
+            flash->sfdp.fast_read[type].dummy_cycles, data_lines);
+
+    return true;
+}
+#endif /* SFUD_USING_SFDP */
+
 /**
  * Enbale the fast read mode in QSPI flash mode. Default read mode is normal SPI mode.
  *
  * it will find the appropriate fast-read instruction to replace the read instruction(0x03)
- * fast-read instruction @see SFUD_FLASH_EXT_INFO_TABLE
+ * fast-read instruction @see SFUD_FLASH_EXT_INFO_TABLE, the fast read types discovered by SFDP are preferred.
  *
  * @note When Flash is in QSPI mode, the method must be called after sfud_device_init().
  *
@@ -211,6 +233,24 @@ sfud_err sfud_qspi_fast_read_enable(sfud_flash *flash, uint8_t data_line_width)
         }
     }
 
+#ifdef SFUD_USING_SFDP
+    /* using the fast read commands and dummy cycles of SFDP parameter */
+    switch (data_line_width) {
+    case 2:
+        if (qspi_set_sfdp_read_cmd_format(flash, SFUD_SFDP_FAST_READ_1_2_2, 2, 2)
+                || qspi_set_sfdp_read_cmd_format(flash, SFUD_SFDP_FAST_READ_1_1_2, 1, 2)) {
+            return result;
+        }
+        break;
+    case 4:
+        if (qspi_set_sfdp_read_cmd_format(flash, SFUD_SFDP_FAST_READ_1_4_4, 4, 4)
+                || qspi_set_sfdp_read_cmd_format(flash, SFUD_SFDP_FAST_READ_1_1_4, 1, 4)) {
+            return result;
+        }
+        break;
+    }
+#endif /* SFUD_USING_SFDP */
+
     /* determine qspi supports which read mode and set read_cmd_format struct */
     switch (data_line_width) {
     case 1:
@@ -374,14 +414,168 @@ static sfud_err hardware_init(sfud_flash *flash) {
  *
  * @return result
  */
-static sfud_err software_init(const sfud_flash *flash) {
+static sfud_err software_init(sfud_flash *flash) {
     sfud_err result = SFUD_SUCCESS;
+#ifdef SFUD_USING_READ_CACHE
+    size_t i;
+#endif
 
     SFUD_ASSERT(flash);
 
+#ifdef SFUD_USING_READ_CACHE
+    /* the read cache is enabled by default */
+    flash->read_cache.enabled = true;
+    flash->read_cache.stamp = 0;
+    flash->read_cache.next_addr = 0;
+    flash->read_cache.hits = 0;
+    flash->read_cache.misses = 0;
+    for (i = 0; i < SFUD_READ_CACHE_LINE_NUM; i++) {
+        flash->read_cache.line[i].valid = false;
+    }
+#endif
+
+    return result;
+}
+
+/**
+ * read flash data by read command
+ *
+ * @note the SPI is locked by caller
+ */
+static sfud_err read_data(const sfud_flash *flash, uint32_t addr, size_t size, uint8_t *data) {
+    sfud_err result = SFUD_SUCCESS;
+    const sfud_spi *spi = &flash->spi;
+    uint8_t cmd_data[5], cmd_size;
+
+    result = wait_busy(flash);
+
+    if (result == SFUD_SUCCESS) {
+#ifdef SFUD_USING_QSPI
+        if (flash->read_cmd_format.instruction != SFUD_CMD_READ_DATA) {
+            result = spi->qspi_read(spi, addr, (sfud_qspi_read_cmd_format *)&flash->read_cmd_format, data, size);
+        } else
+#endif
+        {
+            cmd_data[0] = SFUD_CMD_READ_DATA;
+            make_adress_byte_array(flash, addr, &cmd_data[1]);
+            cmd_size = flash->addr_in_4_byte ? 5 : 4;
+            result = spi->wr(spi, cmd_data, cmd_size, data, size);
+        }
+    }
+
+    return result;
+}
+
+#ifdef SFUD_USING_READ_CACHE
+/**
+ * read flash data by read cache. The missed line is filled by one read command when the read follows the last
+ * one, and the random read is read directly, so it won't evict the lines of sequential reads.
+ *
+ * @note the SPI is locked by caller, the read cache is modified under the lock
+ */
+static sfud_err read_cache_read(const sfud_flash *flash, uint32_t addr, size_t size, uint8_t *data) {
+    sfud_err result = SFUD_SUCCESS;
+    sfud_read_cache *cache = (sfud_read_cache *) &flash->read_cache;
+    sfud_read_cache_line *line;
+    uint32_t line_addr;
+    size_t i, line_size, offset, copy_size;
+    bool sequential = (addr == cache->next_addr);
+
+    cache->next_addr = addr + size;
+    while (size) {
+        line_addr = addr - addr % SFUD_READ_CACHE_LINE_SIZE;
+        /* find the line, or the least recently used line to fill */
+        line = &cache->line[0];
+        for (i = 0; i < SFUD_READ_CACHE_LINE_NUM; i++) {
+            if (cache->line[i].valid && cache->line[i].addr == line_addr) {
+                line = &cache->line[i];
+                break;
+            }
+            if (line->valid && (!cache->line[i].valid || cache->line[i].stamp < line->stamp)) {
+                line = &cache->line[i];
+            }
+        }
+        if (i < SFUD_READ_CACHE_LINE_NUM) {
+            cache->hits++;
+        } else if (!sequential) {
+            result = read_data(flash, addr, size, data);
+            break;
+        } else {
+            line_size = SFUD_READ_CACHE_LINE_SIZE;
+            if (line_addr + line_size > flash->chip.capacity) {
+                line_size = flash->chip.capacity - line_addr;
+            }
+            line->valid = false;
+            result = read_data(flash, line_addr, line_size, line->data);
+            if (result != SFUD_SUCCESS) {
+                break;
+            }
+            line->valid = true;
+            line->addr = line_addr;
+            cache->misses++;
+        }
+        line->stamp = ++cache->stamp;
+
+        offset = addr - line_addr;
+        copy_size = SFUD_READ_CACHE_LINE_SIZE - offset;
+        if (copy_size > size) {
+            copy_size = size;
+        }
+        memcpy(data, line->data + offset, copy_size);
+        addr += copy_size;
+        data += copy_size;
+        size -= copy_size;
+    }
+
     return result;
 }
 
+/**
+ * invalidate the read cache lines in the address range, it's invoked before write and erase
+ */
+static void read_cache_invalidate(const sfud_flash *flash, uint32_t addr, size_t size) {
+    sfud_read_cache *cache = (sfud_read_cache *) &flash->read_cache;
+    size_t i;
+
+    for (i = 0; i < SFUD_READ_CACHE_LINE_NUM; i++) {
+        if (cache->line[i].valid && cache->line[i].addr < addr + size
+                && addr < cache->line[i].addr + SFUD_READ_CACHE_LINE_SIZE) {
+            cache->line[i].valid = false;
+        }
+    }
+}
+
+/**
+ * Enable or disable the read-ahead cache. It's enabled by default after sfud_device_init().
+ *
+ * @param flash flash device
+ * @param enabled true: enable, false: disable
+ *
+ * @return result
+ */
+sfud_err sfud_read_cache_enable(sfud_flash *flash, bool enabled) {
+    const sfud_spi *spi = &flash->spi;
+    size_t i;
+
+    SFUD_ASSERT(flash);
+
+    /* lock SPI */
+    if (spi->lock) {
+        spi->lock(spi);
+    }
+    flash->read_cache.enabled = enabled;
+    for (i = 0; i < SFUD_READ_CACHE_LINE_NUM; i++) {
+        flash->read_cache.line[i].valid = false;
+    }
+    /* unlock SPI */
+    if (spi->unlock) {
+        spi->unlock(spi);
+    }
+
+    return SFUD_SUCCESS;
+}
+#endif /* SFUD_USING_READ_CACHE */
+
 /**
  * read flash data
  *
@@ -395,7 +589,6 @@ static sfud_err software_init(const sfud_flash *flash) {
 sfud_err sfud_read(const sfud_flash *flash, uint32_t addr, size_t size, uint8_t *data) {
     sfud_err result = SFUD_SUCCESS;
     const sfud_spi *spi = &flash->spi;
-    uint8_t cmd_data[5], cmd_size;
 
     SFUD_ASSERT(flash);
     SFUD_ASSERT(data);
@@ -411,20 +604,14 @@ sfud_err sfud_read(const sfud_flash *flash, uint32_t addr, size_t size, uint8_t
         spi->lock(spi);
     }
 
-    result = wait_busy(flash);
-
-    if (result == SFUD_SUCCESS) {
-#ifdef SFUD_USING_QSPI
-        if (flash->read_cmd_format.instruction != SFUD_CMD_READ_DATA) {
-            result = spi->qspi_read(spi, addr, (sfud_qspi_read_cmd_format *)&flash->read_cmd_format, data, size);
-        } else
+#ifdef SFUD_USING_READ_CACHE
+    /* the large read is read directly, the cache is never dirty */
+    if (flash->read_cache.enabled && size < SFUD_READ_CACHE_LINE_SIZE) {
+        result = read_cache_read(flash, addr, size, data);
+    } else
 #endif
-        {
-            cmd_data[0] = SFUD_CMD_READ_DATA;
-            make_adress_byte_array(flash, addr, &cmd_data[1]);
-            cmd_size = flash->addr_in_4_byte ? 5 : 4;
-            result = spi->wr(spi, cmd_data, cmd_size, data, size);
-        }
+    {
+        result = read_data(flash, addr, size, data);
     }
     /* unlock SPI */
     if (spi->unlock) {
@@ -460,6 +647,10 @@ sfud_err sfud_chip_erase(const sfud_flash *flash) {
         goto __exit;
     }
 
+#ifdef SFUD_USING_READ_CACHE
+    read_cache_invalidate(flash, 0, flash->chip.capacity);
+#endif
+
     cmd_data[0] = SFUD_CMD_ERASE_CHIP;
     /* dual-buffer write, like AT45DB series flash chip erase operate is different for other flash */
     if (flash->chip.write_mode & SFUD_WM_DUAL_BUFFER) {
@@ -547,6 +738,11 @@ sfud_err sfud_erase(const sfud_flash *flash, uint32_t addr, size_t size) {
             goto __exit;
         }
 
+#ifdef SFUD_USING_READ_CACHE
+        /* the whole block which contains the address is erased */
+        read_cache_invalidate(flash, addr - addr % cur_erase_size, cur_erase_size);
+#endif
+
         cmd_data[0] = cur_erase_cmd;
         make_adress_byte_array(flash, addr, &cmd_data[1]);
         cmd_size = flash->addr_in_4_byte ? 5 : 4;
@@ -622,6 +818,10 @@ static sfud_err page256_or_1_byte_write(const sfud_flash *flash, uint32_t addr,
         spi->lock(spi);
     }
 
+#ifdef SFUD_USING_READ_CACHE
+    read_cache_invalidate(flash, addr, size);
+#endif
+
     /* loop write operate. write unit is write granularity */
     while (size) {
         /* set the flash write enable */
@@ -705,6 +905,9 @@ static sfud_err aai_write(const sfud_flash *flash, uint32_t addr, size_t size, c
     if (spi->lock) {
         spi->lock(spi);
     }
+#ifdef SFUD_USING_READ_CACHE
+    read_cache_invalidate(flash, addr, size);
+#endif
     /* The address must be even for AAI write mode. So it must write one byte first when address is odd. */
     if (addr % 2 != 0) {
         result = page256_or_1_byte_write(flash, addr++, 1, 1, data++);
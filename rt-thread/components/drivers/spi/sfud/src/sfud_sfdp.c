@@ -330,6 +330,27 @@ static bool read_basic_table(sfud_flash *flash, sfdp_para_header *basic_header)
         }
     }
 
+    /* get fast read supported types and commands, the 1st DWORD has the supported bits, the 3rd and 4th DWORD
+     * have the wait states (bit4:0), mode clocks (bit7:5) and command of each type */
+    for (i = 0; i < SFUD_SFDP_FAST_READ_TYPE_MAX_NUM; i++) {
+        /* supported bit in 1st DWORD and the offset of parameter in table */
+        static const uint8_t fast_read_bit[] = { 16, 20, 22, 21 }, fast_read_para[] = { 12, 14, 10, 8 };
+#ifdef SFUD_DEBUG_MODE
+        static const char *fast_read_name[] = { "1-1-2", "1-2-2", "1-1-4", "1-4-4" };
+#endif
+        uint32_t table1_temp = ((long)table[3] << 24) | ((long)table[2] << 16) | ((long)table[1] << 8) | (long)table[0];
+
+        if (table1_temp & (1L << fast_read_bit[i])) {
+            sfdp->fast_read[i].cmd = table[fast_read_para[i] + 1];
+            sfdp->fast_read[i].dummy_cycles = (table[fast_read_para[i]] & 0x1F) + (table[fast_read_para[i]] >> 5);
+            SFUD_DEBUG("Flash device supports %s fast read. Command is 0x%02X, dummy cycles is %d.",
+                    fast_read_name[i], sfdp->fast_read[i].cmd, sfdp->fast_read[i].dummy_cycles);
+        } else {
+            sfdp->fast_read[i].cmd = 0x00;
+            sfdp->fast_read[i].dummy_cycles = 0;
+        }
+    }
+
     sfdp->available = true;
     return true;
 }
@@ -11,8 +11,10 @@
  * 2012-05-18     bernard      Changed SPI message to message list.
  *                             Added take/release SPI device/bus interface.
  * 2012-09-28     aozima       fixed rt_spi_release_bus assert error.
+ * 2026-10-17     RT-Thread    add asynchronous message queue.
  */
 
+#include <rthw.h>
 #include <drivers/spi.h>
 
 extern rt_err_t rt_spi_bus_device_init(struct rt_spi_bus *bus, const char *name);
@@ -37,6 +39,16 @@ rt_err_t rt_spi_bus_register(struct rt_spi_bus       *bus,
     /* set bus mode */
     bus->mode = RT_SPI_BUS_MODE_SPI;
 
+#ifdef RT_USING_SPI_ASYNC
+    /* the async thread is created at the first request */
+    rt_list_init(&(bus->async_queue));
+    rt_sem_init(&(bus->async_sem), name, 0, RT_IPC_FLAG_FIFO);
+    bus->async_thread  = RT_NULL;
+    bus->async_request = RT_NULL;
+    bus->async_message = RT_NULL;
+    rt_completion_init(&(bus->async_completion));
+#endif
+
     return RT_EOK;
 }
 
@@ -61,6 +73,9 @@ rt_err_t rt_spi_bus_attach_device(struct rt_spi_device *device,
 
         rt_memset(&device->config, 0, sizeof(device->config));
         device->parent.user_data = user_data;
+#ifdef RT_USING_SPI_ASYNC
+        device->priority = RT_SPI_PRIORITY_DEFAULT;
+#endif
 
         return RT_EOK;
     }
@@ -458,3 +473,240 @@ rt_err_t rt_spi_release(struct rt_spi_device *device)
 
     return result;
 }
+
+#ifdef RT_USING_SPI_ASYNC
+/**
+ * This function transfers the messages of current request from the async
+ * message of bus, until one message is started by xfer_start.
+ *
+ * @param bus the SPI bus
+ * @param in_isr it's invoked in ISR, where the messages can't be transferred
+ *        synchronously
+ *
+ * @return RT_TRUE if a message is in transfer, and rt_spi_bus_xfer_done will
+ *         continue the rest.
+ */
+static rt_bool_t _spi_async_next(struct rt_spi_bus *bus, rt_bool_t in_isr)
+{
+    struct rt_spi_request *request = bus->async_request;
+    struct rt_spi_message *message;
+
+    while ((message = bus->async_message) != RT_NULL)
+    {
+        if (bus->ops->xfer_start != RT_NULL &&
+                bus->ops->xfer_start(request->device, message) == RT_EOK)
+        {
+            return RT_TRUE;
+        }
+
+        /* the thread will transfer it synchronously */
+        if (in_isr) break;
+
+        if (bus->ops->xfer(request->device, message) == 0)
+        {
+            request->result = -RT_EIO;
+            request->failed = message;
+            bus->async_message = RT_NULL;
+            break;
+        }
+        bus->async_message = message->next;
+    }
+
+    return RT_FALSE;
+}
+
+/**
+ * This function is invoked by driver when the message started by xfer_start
+ * is done, the next message of the request is started at once.
+ *
+ * @param bus the SPI bus
+ * @param result RT_EOK on transferred successfully
+ */
+void rt_spi_bus_xfer_done(struct rt_spi_bus *bus, rt_err_t result)
+{
+    struct rt_spi_request *request = bus->async_request;
+    struct rt_spi_message *message = bus->async_message;
+
+    RT_ASSERT(request != RT_NULL && message != RT_NULL);
+
+    if (result != RT_EOK)
+    {
+        request->result = -RT_EIO;
+        request->failed = message;
+        bus->async_message = RT_NULL;
+    }
+    else
+    {
+        bus->async_message = message->next;
+    }
+
+    if (bus->async_message == RT_NULL || _spi_async_next(bus, RT_TRUE) == RT_FALSE)
+    {
+        /* the request is done, or the rest is transferred by thread */
+        rt_completion_done(&(bus->async_completion));
+    }
+}
+RTM_EXPORT(rt_spi_bus_xfer_done);
+
+/* get the request with the highest priority */
+static struct rt_spi_request *_spi_async_pop(struct rt_spi_bus *bus)
+{
+    struct rt_spi_request *request = RT_NULL;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(&(bus->async_queue)))
+    {
+        request = rt_list_entry(bus->async_queue.next, struct rt_spi_request, list);
+        rt_list_remove(&(request->list));
+    }
+    rt_hw_interrupt_enable(level);
+
+    return request;
+}
+
+/* start the request, it returns when the first message is in transfer */
+static rt_bool_t _spi_async_start(struct rt_spi_bus *bus, struct rt_spi_request *request)
+{
+    struct rt_spi_device *device = request->device;
+
+    bus->async_request = request;
+    bus->async_message = request->message;
+
+    if (bus->owner != device)
+    {
+        /* not the same owner as current, re-configure SPI bus */
+        if (bus->ops->configure(device, &device->config) != RT_EOK)
+        {
+            /* configure SPI bus failed */
+            request->result = -RT_EIO;
+            request->failed = request->message;
+            bus->async_message = RT_NULL;
+
+            return RT_FALSE;
+        }
+        bus->owner = device;
+    }
+
+    return _spi_async_next(bus, RT_FALSE);
+}
+
+static void _spi_async_entry(void *parameter)
+{
+    struct rt_spi_bus *bus = (struct rt_spi_bus *)parameter;
+    struct rt_spi_request *request, *last;
+    rt_bool_t busy;
+
+    while (1)
+    {
+        rt_sem_take(&(bus->async_sem), RT_WAITING_FOREVER);
+
+        rt_mutex_take(&(bus->lock), RT_WAITING_FOREVER);
+        last = RT_NULL;
+        while ((request = _spi_async_pop(bus)) != RT_NULL)
+        {
+            busy = _spi_async_start(bus, request);
+
+            /* the callback of last request runs while the bus is busy */
+            if (last && last->complete)
+                last->complete(last);
+
+            while (busy)
+            {
+                rt_completion_wait(&(bus->async_completion), RT_WAITING_FOREVER);
+                busy = _spi_async_next(bus, RT_FALSE);
+            }
+            last = request;
+        }
+        bus->async_request = RT_NULL;
+        rt_mutex_release(&(bus->lock));
+
+        if (last && last->complete)
+            last->complete(last);
+    }
+}
+
+/**
+ * This function sets the priority of SPI device in the asynchronous message
+ * queue of bus.
+ *
+ * @param device the SPI device attached to SPI bus
+ * @param priority the priority, the lower number is the higher priority
+ */
+void rt_spi_set_priority(struct rt_spi_device *device, rt_uint8_t priority)
+{
+    RT_ASSERT(device != RT_NULL);
+
+    device->priority = priority;
+}
+RTM_EXPORT(rt_spi_set_priority);
+
+/**
+ * This function submits a message list to the asynchronous message queue of
+ * SPI bus. The requests are transferred by the async thread of bus in the
+ * priority of device, and FIFO in the same priority. The messages started by
+ * xfer_start of driver are chained in ISR, and the next request is started
+ * before the completion callback of last request.
+ *
+ * @note the completion callback runs in the async thread with the bus lock
+ *       held, it may submit the requests, but it shall not transfer
+ *       synchronously on the same bus. See struct rt_spi_request.
+ *
+ * @param device the SPI device attached to SPI bus
+ * @param request the request with the message list and completion callback,
+ *        it must be kept until the callback is invoked.
+ *
+ * @return RT_EOK on submitted successfully, -RT_ENOMEM on failed to create
+ *         the async thread.
+ */
+rt_err_t rt_spi_transfer_message_async(struct rt_spi_device  *device,
+                                       struct rt_spi_request *request)
+{
+    struct rt_spi_bus *bus;
+    struct rt_spi_request *index;
+    rt_list_t *node;
+    rt_base_t level;
+
+    RT_ASSERT(device != RT_NULL);
+    RT_ASSERT(device->bus != RT_NULL);
+    RT_ASSERT(request != RT_NULL && request->message != RT_NULL);
+
+    bus = device->bus;
+    if (bus->async_thread == RT_NULL)
+    {
+        rt_mutex_take(&(bus->lock), RT_WAITING_FOREVER);
+        if (bus->async_thread == RT_NULL)
+        {
+            bus->async_thread = rt_thread_create(bus->parent.parent.name, _spi_async_entry, bus,
+                                                 RT_SPI_ASYNC_THREAD_STACK_SIZE,
+                                                 RT_SPI_ASYNC_THREAD_PRIORITY, 10);
+            if (bus->async_thread != RT_NULL)
+                rt_thread_startup(bus->async_thread);
+        }
+        rt_mutex_release(&(bus->lock));
+
+        if (bus->async_thread == RT_NULL)
+            return -RT_ENOMEM;
+    }
+
+    request->device = device;
+    request->result = RT_EOK;
+    request->failed = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+    /* insert before the first request in lower priority */
+    for (node = bus->async_queue.next; node != &(bus->async_queue); node = node->next)
+    {
+        index = rt_list_entry(node, struct rt_spi_request, list);
+        if (index->device->priority > device->priority)
+            break;
+    }
+    rt_list_insert_before(node, &(request->list));
+    rt_hw_interrupt_enable(level);
+
+    rt_sem_release(&(bus->async_sem));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_spi_transfer_message_async);
+#endif /* RT_USING_SPI_ASYNC */
@@ -321,6 +321,292 @@ void rt_ringbuffer_reset(struct rt_ringbuffer *rb)
 }
 RTM_EXPORT(rt_ringbuffer_reset);
 
+/*
+ * The memory barrier between the access of buffer data and the update of
+ * index in SPSC ring buffer.
+ */
+#if defined(__CC_ARM)
+#define RB_SPSC_BARRIER()       __dmb(0xF)
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+#define RB_SPSC_BARRIER()       __DMB()
+#elif defined(__GNUC__) || defined(__CLANG_ARM)
+#define RB_SPSC_BARRIER()       __sync_synchronize()
+#else
+#define RB_SPSC_BARRIER()
+#endif
+
+rt_inline rt_uint32_t rt_ringbuffer_spsc_offset(struct rt_ringbuffer_spsc *rb,
+                                                rt_uint32_t index)
+{
+    return index < rb->buffer_size ? index : index - rb->buffer_size;
+}
+
+rt_inline rt_uint32_t rt_ringbuffer_spsc_advance(struct rt_ringbuffer_spsc *rb,
+                                                 rt_uint32_t index,
+                                                 rt_uint32_t length)
+{
+    index += length;
+    if (index >= 2 * rb->buffer_size)
+        index -= 2 * rb->buffer_size;
+
+    return index;
+}
+
+rt_inline rt_uint32_t rt_ringbuffer_spsc_len(struct rt_ringbuffer_spsc *rb,
+                                             rt_uint32_t write_index,
+                                             rt_uint32_t read_index)
+{
+    if (write_index >= read_index)
+        return write_index - read_index;
+
+    return 2 * rb->buffer_size - (read_index - write_index);
+}
+
+/**
+ * initialize a single-producer/single-consumer ring buffer
+ */
+void rt_ringbuffer_spsc_init(struct rt_ringbuffer_spsc *rb,
+                             rt_uint8_t                *pool,
+                             rt_uint32_t                size)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(size > 0 && size < 0x80000000UL);
+
+    rb->buffer_ptr  = pool;
+    rb->buffer_size = size;
+    rb->write_index = 0;
+    rb->read_index  = 0;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_init);
+
+/**
+ * empty the rb, it shall not be invoked with the producer or consumer
+ * running at the same time.
+ */
+void rt_ringbuffer_spsc_reset(struct rt_ringbuffer_spsc *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    rb->write_index = 0;
+    rb->read_index  = 0;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_reset);
+
+/**
+ * get the size of data in rb
+ */
+rt_size_t rt_ringbuffer_spsc_data_len(struct rt_ringbuffer_spsc *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    return rt_ringbuffer_spsc_len(rb, rb->write_index, rb->read_index);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_data_len);
+
+/**
+ * get the size of empty space in rb
+ */
+rt_size_t rt_ringbuffer_spsc_space_len(struct rt_ringbuffer_spsc *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    return rb->buffer_size - rt_ringbuffer_spsc_len(rb, rb->write_index, rb->read_index);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_space_len);
+
+/**
+ * get the contiguous empty space of rb for producer, the data written in the
+ * space will be put into rb by rt_ringbuffer_spsc_commit.
+ *
+ * @param rb the ring buffer
+ * @param ptr the start address of empty space
+ *
+ * @return the size of contiguous empty space
+ */
+rt_size_t rt_ringbuffer_spsc_reserve(struct rt_ringbuffer_spsc *rb, rt_uint8_t **ptr)
+{
+    rt_uint32_t write_index, read_index, offset, space;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(ptr != RT_NULL);
+
+    write_index = rb->write_index;
+    read_index  = rb->read_index;
+    /* the space is not written before the read_index is loaded */
+    RB_SPSC_BARRIER();
+
+    space  = rb->buffer_size - rt_ringbuffer_spsc_len(rb, write_index, read_index);
+    offset = rt_ringbuffer_spsc_offset(rb, write_index);
+    if (space > rb->buffer_size - offset)
+        space = rb->buffer_size - offset;
+
+    *ptr = &rb->buffer_ptr[offset];
+
+    return space;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_reserve);
+
+/**
+ * put the data written in the reserved space into rb
+ *
+ * @param rb the ring buffer
+ * @param length the length of data, which shall not be larger than the
+ *        reserved space
+ */
+void rt_ringbuffer_spsc_commit(struct rt_ringbuffer_spsc *rb, rt_size_t length)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(length <= rb->buffer_size - rt_ringbuffer_spsc_data_len(rb));
+
+    /* the data shall be visible before the write_index */
+    RB_SPSC_BARRIER();
+    rb->write_index = rt_ringbuffer_spsc_advance(rb, rb->write_index, length);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_commit);
+
+/**
+ * get the contiguous data of rb for consumer, the data will be removed from
+ * rb by rt_ringbuffer_spsc_consume.
+ *
+ * @param rb the ring buffer
+ * @param ptr the start address of data
+ *
+ * @return the size of contiguous data
+ */
+rt_size_t rt_ringbuffer_spsc_peek(struct rt_ringbuffer_spsc *rb, rt_uint8_t **ptr)
+{
+    rt_uint32_t write_index, read_index, offset, length;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(ptr != RT_NULL);
+
+    read_index  = rb->read_index;
+    write_index = rb->write_index;
+    /* the data is not read before the write_index is loaded */
+    RB_SPSC_BARRIER();
+
+    length = rt_ringbuffer_spsc_len(rb, write_index, read_index);
+    offset = rt_ringbuffer_spsc_offset(rb, read_index);
+    if (length > rb->buffer_size - offset)
+        length = rb->buffer_size - offset;
+
+    *ptr = &rb->buffer_ptr[offset];
+
+    return length;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_peek);
+
+/**
+ * remove the data peeked from rb
+ *
+ * @param rb the ring buffer
+ * @param length the length of data, which shall not be larger than the
+ *        peeked data
+ */
+void rt_ringbuffer_spsc_consume(struct rt_ringbuffer_spsc *rb, rt_size_t length)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(length <= rt_ringbuffer_spsc_data_len(rb));
+
+    /* the data shall be read out before the read_index is changed */
+    RB_SPSC_BARRIER();
+    rb->read_index = rt_ringbuffer_spsc_advance(rb, rb->read_index, length);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_consume);
+
+/**
+ * put a block of data into rb, it shall be invoked by producer only.
+ */
+rt_size_t rt_ringbuffer_spsc_put(struct rt_ringbuffer_spsc *rb,
+                                 const rt_uint8_t          *ptr,
+                                 rt_size_t                  length)
+{
+    rt_uint8_t *space;
+    rt_size_t size, put = 0;
+
+    /* the empty space may wrap around the end of buffer */
+    while (put < length)
+    {
+        size = rt_ringbuffer_spsc_reserve(rb, &space);
+        if (size == 0)
+            break;
+
+        if (size > length - put)
+            size = length - put;
+
+        memcpy(space, &ptr[put], size);
+        rt_ringbuffer_spsc_commit(rb, size);
+        put += size;
+    }
+
+    return put;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_put);
+
+/**
+ * put a character into rb, it shall be invoked by producer only.
+ */
+rt_size_t rt_ringbuffer_spsc_putchar(struct rt_ringbuffer_spsc *rb, const rt_uint8_t ch)
+{
+    rt_uint8_t *space;
+
+    if (rt_ringbuffer_spsc_reserve(rb, &space) == 0)
+        return 0;
+
+    *space = ch;
+    rt_ringbuffer_spsc_commit(rb, 1);
+
+    return 1;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_putchar);
+
+/**
+ * get data from rb, it shall be invoked by consumer only.
+ */
+rt_size_t rt_ringbuffer_spsc_get(struct rt_ringbuffer_spsc *rb,
+                                 rt_uint8_t                *ptr,
+                                 rt_size_t                  length)
+{
+    rt_uint8_t *data;
+    rt_size_t size, get = 0;
+
+    /* the data may wrap around the end of buffer */
+    while (get < length)
+    {
+        size = rt_ringbuffer_spsc_peek(rb, &data);
+        if (size == 0)
+            break;
+
+        if (size > length - get)
+            size = length - get;
+
+        memcpy(&ptr[get], data, size);
+        rt_ringbuffer_spsc_consume(rb, size);
+        get += size;
+    }
+
+    return get;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_get);
+
+/**
+ * get a character from rb, it shall be invoked by consumer only.
+ */
+rt_size_t rt_ringbuffer_spsc_getchar(struct rt_ringbuffer_spsc *rb, rt_uint8_t *ch)
+{
+    rt_uint8_t *data;
+
+    if (rt_ringbuffer_spsc_peek(rb, &data) == 0)
+        return 0;
+
+    *ch = *data;
+    rt_ringbuffer_spsc_consume(rb, 1);
+
+    return 1;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_getchar);
+
 #ifdef RT_USING_HEAP
 
 struct rt_ringbuffer* rt_ringbuffer_create(rt_uint16_t size)
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2017-02-27     bernard      fix the re-work issue.
+ * 2026-10-17     RT-Thread    check the pool of work on cancel
  */
 
 #include <rthw.h>
@@ -395,7 +396,408 @@ void rt_delayed_work_init(struct rt_delayed_work *work, void (*work_func)(struct
     work->work.type = RT_WORK_TYPE_DELAYED;
 }
 
+#ifdef RT_USING_WORKQUEUE_POOL
+static void _pool_delayed_work_timeout_handler(void *parameter);
+
+/* take the first work of the highest priority lane, it shall be invoked with interrupt disabled */
+static struct rt_work *_workqueue_pool_take(struct rt_workqueue_pool *pool)
+{
+    struct rt_workqueue_lane_stat *stat;
+    struct rt_work *work;
+    rt_uint32_t latency;
+    int lane;
+
+    for (lane = 0; lane < RT_WORK_LANE_NUM; lane ++)
+    {
+        if (rt_list_isempty(&(pool->lanes[lane])))
+            continue;
+
+        work = rt_list_entry(pool->lanes[lane].next, struct rt_work, list);
+        rt_list_remove(&(work->list));
+        work->flags &= ~RT_WORK_STATE_PENDING;
+
+        stat = &(pool->stats[lane]);
+        latency = rt_tick_get() - work->submit_tick;
+        stat->depth --;
+        stat->started ++;
+        stat->total_latency += latency;
+        if (latency > stat->max_latency)
+            stat->max_latency = latency;
+
+        return work;
+    }
+
+    return RT_NULL;
+}
+
+static void _workqueue_pool_thread_entry(void *parameter)
+{
+    rt_base_t level;
+    struct rt_work *work;
+    struct rt_workqueue_worker *worker;
+    struct rt_workqueue_pool *pool;
+    rt_uint8_t priority;
+
+    worker = (struct rt_workqueue_worker *) parameter;
+    RT_ASSERT(worker != RT_NULL);
+    pool = worker->pool;
+
+    while (1)
+    {
+        /* the semaphore is released once for each queued work */
+        rt_sem_take(&(pool->sem), RT_WAITING_FOREVER);
+
+        level = rt_hw_interrupt_disable();
+        work = _workqueue_pool_take(pool);
+        if (work == RT_NULL)
+        {
+            /* the work has been cancelled */
+            rt_hw_interrupt_enable(level);
+            continue;
+        }
+        worker->work_current = work;
+        rt_hw_interrupt_enable(level);
+
+        /* run the work at the priority of its lane */
+        priority = pool->priorities[work->lane];
+        if (worker->thread->current_priority != priority)
+            rt_thread_control(worker->thread, RT_THREAD_CTRL_CHANGE_PRIORITY, &priority);
+
+        /* do work */
+        work->work_func(work, work->work_data);
+
+        level = rt_hw_interrupt_disable();
+        /* clean current work */
+        worker->work_current = RT_NULL;
+        rt_hw_interrupt_enable(level);
+    }
+}
+
+/* whether the work is running in a worker, it shall be invoked with interrupt disabled */
+static rt_bool_t _workqueue_pool_running(struct rt_workqueue_pool *pool, struct rt_work *work)
+{
+    int index;
+
+    for (index = 0; index < pool->worker_num; index ++)
+    {
+        if (pool->workers[index].work_current == work)
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+static rt_err_t _workqueue_pool_submit_work(struct rt_workqueue_pool *pool, struct rt_work *work,
+                                            rt_uint8_t lane)
+{
+    rt_base_t level;
+    struct rt_workqueue_lane_stat *stat;
+
+    level = rt_hw_interrupt_disable();
+    if ((work->flags & RT_WORK_STATE_PENDING) || _workqueue_pool_running(pool, work))
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EBUSY;
+    }
+
+    /* NOTE: the work MUST be initialized firstly */
+    rt_list_remove(&(work->list));
+    rt_list_insert_before(&(pool->lanes[lane]), &(work->list));
+    work->flags |= RT_WORK_STATE_PENDING;
+    work->pool = pool;
+    work->lane = lane;
+    work->submit_tick = rt_tick_get();
+
+    stat = &(pool->stats[lane]);
+    stat->submitted ++;
+    stat->depth ++;
+    if (stat->depth > stat->max_depth)
+        stat->max_depth = stat->depth;
+    rt_hw_interrupt_enable(level);
+
+    /* wake up an idle worker */
+    rt_sem_release(&(pool->sem));
+
+    return RT_EOK;
+}
+
+static void _pool_delayed_work_timeout_handler(void *parameter)
+{
+    struct rt_delayed_work *delayed_work;
+    rt_base_t level;
+
+    delayed_work = (struct rt_delayed_work *)parameter;
+    level = rt_hw_interrupt_disable();
+    rt_timer_stop(&(delayed_work->timer));
+    rt_timer_detach(&(delayed_work->timer));
+    delayed_work->work.flags &= ~RT_WORK_STATE_SUBMITTING;
+    rt_hw_interrupt_enable(level);
+    _workqueue_pool_submit_work(delayed_work->work.pool, &(delayed_work->work), delayed_work->work.lane);
+}
+
+/**
+ * This function will create a workqueue pool. The works are queued in the
+ * priority lanes, and dispatched to any idle worker thread in the order of
+ * lanes. A worker runs the work of high, normal and low lane at the priority
+ * of (priority - 1), priority and (priority + 1).
+ *
+ * @param name the name of worker threads
+ * @param worker_num the number of worker threads
+ * @param stack_size the stack size of worker thread
+ * @param priority the priority of normal lane
+ *
+ * @return the created pool, RT_NULL on error happen
+ */
+struct rt_workqueue_pool *rt_workqueue_pool_create(const char *name, rt_uint8_t worker_num,
+                                                   rt_uint16_t stack_size, rt_uint8_t priority)
+{
+    struct rt_workqueue_pool *pool;
+    int index, lane_priority;
+
+    RT_ASSERT(worker_num > 0);
+
+    pool = (struct rt_workqueue_pool *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue_pool) +
+                                                        sizeof(struct rt_workqueue_worker) * worker_num);
+    if (pool == RT_NULL)
+        return RT_NULL;
+
+    rt_memset(pool, 0, sizeof(struct rt_workqueue_pool));
+    for (index = 0; index < RT_WORK_LANE_NUM; index ++)
+    {
+        rt_list_init(&(pool->lanes[index]));
+
+        /* the lowest priority is reserved for idle thread */
+        lane_priority = priority + index - RT_WORK_LANE_NORMAL;
+        if (lane_priority < 0)
+            lane_priority = 0;
+        if (lane_priority > RT_THREAD_PRIORITY_MAX - 2)
+            lane_priority = RT_THREAD_PRIORITY_MAX - 2;
+        pool->priorities[index] = lane_priority;
+    }
+    rt_sem_init(&(pool->sem), "wqpool", 0, RT_IPC_FLAG_FIFO);
+
+    pool->workers = (struct rt_workqueue_worker *)(pool + 1);
+    for (index = 0; index < worker_num; index ++)
+    {
+        pool->workers[index].pool = pool;
+        pool->workers[index].work_current = RT_NULL;
+        pool->workers[index].thread = rt_thread_create(name, _workqueue_pool_thread_entry,
+                                                       &(pool->workers[index]), stack_size,
+                                                       pool->priorities[RT_WORK_LANE_NORMAL], 10);
+        if (pool->workers[index].thread == RT_NULL)
+        {
+            rt_workqueue_pool_destroy(pool);
+            return RT_NULL;
+        }
+        pool->worker_num ++;
+    }
+
+    for (index = 0; index < pool->worker_num; index ++)
+        rt_thread_startup(pool->workers[index].thread);
+
+    return pool;
+}
+
+/**
+ * This function will destroy a workqueue pool, the pending works are dropped.
+ *
+ * @param pool the workqueue pool
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_workqueue_pool_destroy(struct rt_workqueue_pool *pool)
+{
+    int index;
+
+    RT_ASSERT(pool != RT_NULL);
+
+    for (index = 0; index < pool->worker_num; index ++)
+        rt_thread_delete(pool->workers[index].thread);
+    rt_sem_detach(&(pool->sem));
+    RT_KERNEL_FREE(pool);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will submit a work to a lane of workqueue pool.
+ *
+ * @param pool the workqueue pool
+ * @param work the work, the delayed work is submitted after the ticks
+ * @param lane the priority lane, RT_WORK_LANE_HIGH, NORMAL or LOW
+ * @param time the ticks to delay for delayed work
+ *
+ * @return RT_EOK on successful, -RT_EBUSY if the work is pending or running,
+ *         -RT_EINVAL if the work is pending or delayed in other pool.
+ */
+rt_err_t rt_workqueue_pool_submit(struct rt_workqueue_pool *pool, struct rt_work *work,
+                                  rt_uint8_t lane, rt_tick_t time)
+{
+    struct rt_delayed_work *delayed_work;
+    rt_base_t level;
+    rt_err_t result;
+
+    RT_ASSERT(pool != RT_NULL);
+    RT_ASSERT(work != RT_NULL);
+    RT_ASSERT(lane < RT_WORK_LANE_NUM);
+
+    if (work->type & RT_WORK_TYPE_DELAYED)
+    {
+        /* cancel if work has been submitted, the timer shall not submit it again */
+        result = rt_workqueue_pool_cancel(pool, work);
+        if (result != RT_EOK)
+            return result;
+    }
+
+    if (!(work->type & RT_WORK_TYPE_DELAYED) || time == 0)
+    {
+        return _workqueue_pool_submit_work(pool, work, lane);
+    }
+
+    delayed_work = (struct rt_delayed_work *)work;
+
+    level = rt_hw_interrupt_disable();
+    work->pool = pool;
+    work->lane = lane;
+    work->flags |= RT_WORK_STATE_SUBMITTING;
+    rt_timer_init(&(delayed_work->timer), "work", _pool_delayed_work_timeout_handler, delayed_work,
+                  time, RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_SOFT_TIMER);
+    rt_hw_interrupt_enable(level);
+    rt_timer_start(&(delayed_work->timer));
+
+    return RT_EOK;
+}
+
+/**
+ * This function will cancel a pending or delayed work of workqueue pool.
+ *
+ * @param pool the workqueue pool
+ * @param work the work
+ *
+ * @return RT_EOK on successful, -RT_EBUSY if the work is running, -RT_EINVAL
+ *         if the work is pending or delayed in other pool.
+ */
+rt_err_t rt_workqueue_pool_cancel(struct rt_workqueue_pool *pool, struct rt_work *work)
+{
+    struct rt_delayed_work *delayed_work;
+    rt_base_t level;
+
+    RT_ASSERT(pool != RT_NULL);
+    RT_ASSERT(work != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    /* work cannot be active in multiple pools */
+    if ((work->flags & (RT_WORK_STATE_PENDING | RT_WORK_STATE_SUBMITTING)) && work->pool != pool)
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EINVAL;
+    }
+
+    if (_workqueue_pool_running(pool, work))
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EBUSY;
+    }
+
+    if (work->flags & RT_WORK_STATE_PENDING)
+    {
+        /* the semaphore is left released, the worker will find nothing */
+        rt_list_remove(&(work->list));
+        work->flags &= ~RT_WORK_STATE_PENDING;
+        pool->stats[work->lane].depth --;
+    }
+    else if (work->flags & RT_WORK_STATE_SUBMITTING)
+    {
+        delayed_work = (struct rt_delayed_work *)work;
+        rt_timer_stop(&(delayed_work->timer));
+        rt_timer_detach(&(delayed_work->timer));
+        work->flags &= ~RT_WORK_STATE_SUBMITTING;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will get the statistics of a lane of workqueue pool.
+ *
+ * @param pool the workqueue pool
+ * @param lane the priority lane
+ * @param stat the buffer to store statistics
+ */
+void rt_workqueue_pool_stat(struct rt_workqueue_pool *pool, rt_uint8_t lane,
+                            struct rt_workqueue_lane_stat *stat)
+{
+    rt_base_t level;
+
+    RT_ASSERT(pool != RT_NULL);
+    RT_ASSERT(lane < RT_WORK_LANE_NUM);
+    RT_ASSERT(stat != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    *stat = pool->stats[lane];
+    rt_hw_interrupt_enable(level);
+}
+#endif /* RT_USING_WORKQUEUE_POOL */
+
 #ifdef RT_USING_SYSTEM_WORKQUEUE
+#ifdef RT_USING_WORKQUEUE_POOL
+#ifndef RT_SYSTEM_WORKQUEUE_WORKERS
+#define RT_SYSTEM_WORKQUEUE_WORKERS     2
+#endif
+
+static struct rt_workqueue_pool *sys_workq;
+
+rt_err_t rt_work_submit_lane(struct rt_work *work, rt_uint8_t lane, rt_tick_t time)
+{
+    return rt_workqueue_pool_submit(sys_workq, work, lane, time);
+}
+
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t time)
+{
+    return rt_workqueue_pool_submit(sys_workq, work, RT_WORK_LANE_NORMAL, time);
+}
+
+rt_err_t rt_work_cancel(struct rt_work *work)
+{
+    return rt_workqueue_pool_cancel(sys_workq, work);
+}
+
+static int rt_work_sys_workqueue_init(void)
+{
+    sys_workq = rt_workqueue_pool_create("sys_work", RT_SYSTEM_WORKQUEUE_WORKERS,
+                                         RT_SYSTEM_WORKQUEUE_STACKSIZE,
+                                         RT_SYSTEM_WORKQUEUE_PRIORITY);
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void list_workqueue(void)
+{
+    static const char *lane_names[RT_WORK_LANE_NUM] = {"high", "normal", "low"};
+    struct rt_workqueue_lane_stat stat;
+    int lane;
+
+    if (sys_workq == RT_NULL)
+        return;
+
+    rt_kprintf("lane   pri submitted  depth max_depth avg_latency max_latency\n");
+    rt_kprintf("------ --- ---------- ----- --------- ----------- -----------\n");
+    for (lane = 0; lane < RT_WORK_LANE_NUM; lane ++)
+    {
+        rt_workqueue_pool_stat(sys_workq, lane, &stat);
+        rt_kprintf("%-6s %3d %-10d %-5d %-9d %-11d %-11d\n", lane_names[lane],
+                   sys_workq->priorities[lane], stat.submitted, stat.depth, stat.max_depth,
+                   stat.started ? stat.total_latency / stat.started : 0, stat.max_latency);
+    }
+    rt_kprintf("latency in ticks, %d workers\n", sys_workq->worker_num);
+}
+MSH_CMD_EXPORT(list_workqueue, list the statistics of system workqueue lanes);
+#endif /* RT_USING_FINSH */
+#else
 static struct rt_workqueue *sys_workq;
 
 rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t time)
@@ -415,6 +817,7 @@ static int rt_work_sys_workqueue_init(void)
 
     return RT_EOK;
 }
+#endif /* RT_USING_WORKQUEUE_POOL */
 
 INIT_DEVICE_EXPORT(rt_work_sys_workqueue_init);
 #endif
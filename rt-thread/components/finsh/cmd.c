@@ -607,8 +607,13 @@ long list_memheap(void)
 
     maxlen = RT_NAME_MAX;
 
+#ifdef RT_USING_MEMHEAP_CLASS
+    rt_kprintf("%-*.s  pool size  max used size available size class  alloc      fail\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(      " ---------- ------------- -------------- ----- ---------- ----------\n");
+#else
     rt_kprintf("%-*.s  pool size  max used size available size\n", maxlen, item_title); object_split(maxlen);
     rt_kprintf(      " ---------- ------------- --------------\n");
+#endif
     do
     {
         next = list_get_next(next, &find_arg);
@@ -631,12 +636,26 @@ long list_memheap(void)
 
                 mh = (struct rt_memheap *)obj;
 
+#ifdef RT_USING_MEMHEAP_CLASS
+                rt_kprintf("%-*.*s %-010d %-013d %-014d %c%c%c   %10d %10d\n",
+                        maxlen, RT_NAME_MAX,
+                        mh->parent.name,
+                        mh->pool_size,
+                        mh->max_used_size,
+                        mh->available_size,
+                        (mh->heap_class & RT_MEMHEAP_CLASS_FAST) ? 'F' : '-',
+                        (mh->heap_class & RT_MEMHEAP_CLASS_DMA)  ? 'D' : '-',
+                        (mh->heap_class & RT_MEMHEAP_CLASS_BULK) ? 'B' : '-',
+                        mh->alloc_count,
+                        mh->fail_count);
+#else
                 rt_kprintf("%-*.*s %-010d %-013d %-05d\n",
                         maxlen, RT_NAME_MAX,
                         mh->parent.name,
                         mh->pool_size,
                         mh->max_used_size,
                         mh->available_size);
+#endif
 
             }
         }
@@ -778,6 +797,86 @@ long list_timer(void)
 FINSH_FUNCTION_EXPORT(list_timer, list timer in system);
 MSH_CMD_EXPORT(list_timer, list timer in system);
 
+#ifdef RT_USING_PERIODIC_THREAD
+#ifdef RT_USING_CPU_USAGE
+#include <rtdevice.h> /* for clock_cpu_microsecond */
+#endif
+
+long list_periodic(void)
+{
+    rt_ubase_t level;
+    list_get_next_t find_arg;
+    rt_list_t *obj_list[LIST_FIND_OBJ_NR];
+    rt_list_t *next = (rt_list_t*)RT_NULL;
+
+    int maxlen;
+    const char *item_title = "thread";
+
+    list_find_init(&find_arg, RT_Object_Class_Thread, obj_list, sizeof(obj_list)/sizeof(obj_list[0]));
+
+    maxlen = RT_NAME_MAX;
+
+#ifdef RT_USING_CPU_USAGE
+    rt_kprintf("%-*.s pri  period   deadline    jobs     missed     late      wcrt     slack   wcet(us)\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " --- -------- -------- ---------- ---------- ---------- -------- -------- ----------\n");
+#else
+    rt_kprintf("%-*.s pri  period   deadline    jobs     missed     late      wcrt     slack\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " --- -------- -------- ---------- ---------- ---------- -------- --------\n");
+#endif
+    do {
+        next = list_get_next(next, &find_arg);
+        {
+            int i;
+            for (i = 0; i < find_arg.nr_out; i++)
+            {
+                struct rt_object *obj;
+                struct rt_thread *thread;
+                struct rt_thread_periodic periodic;
+                rt_uint8_t priority;
+
+                obj = rt_list_entry(obj_list[i], struct rt_object, list);
+                level = rt_hw_interrupt_disable();
+                if ((obj->type & ~RT_Object_Class_Static) != find_arg.type)
+                {
+                    rt_hw_interrupt_enable(level);
+                    continue;
+                }
+
+                thread = (struct rt_thread *)obj;
+                /* copy info */
+                memcpy(&periodic, &(thread->periodic), sizeof periodic);
+                priority = thread->current_priority;
+                rt_hw_interrupt_enable(level);
+
+                if (periodic.period == 0)
+                    continue;
+
+                rt_kprintf("%-*.*s %3d %8d %8d %10d %10d %10d %8d %8d",
+                        maxlen, RT_NAME_MAX,
+                        thread->name,
+                        priority,
+                        periodic.period,
+                        periodic.deadline,
+                        periodic.jobs,
+                        periodic.missed,
+                        periodic.late,
+                        periodic.wcrt,
+                        (rt_int32_t)(periodic.deadline - periodic.wcrt));
+#ifdef RT_USING_CPU_USAGE
+                rt_kprintf(" %10d", clock_cpu_microsecond(periodic.wcet));
+#endif
+                rt_kprintf("\n");
+            }
+        }
+    }
+    while (next != (rt_list_t*)RT_NULL);
+
+    return 0;
+}
+FINSH_FUNCTION_EXPORT(list_periodic, list periodic thread in system);
+MSH_CMD_EXPORT(list_periodic, list periodic thread in system);
+#endif
+
 #ifdef RT_USING_DEVICE
 static char *const device_type_str[] =
 {
@@ -7,12 +7,16 @@
  * Date           Author       Notes
  * 2018-03-30     chenyong     first version
  * 2018-08-17     chenyong     multiple client support
+ * 2026-10-17     RT-Thread    parse in place of serial DMA receive fifo
  */
 
 #ifndef __AT_H__
 #define __AT_H__
 
 #include <rtthread.h>
+#ifdef RT_SERIAL_USING_DMA
+#include <rtdevice.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -173,6 +177,13 @@ struct at_client
     rt_size_t recv_bufsz;
     rt_sem_t rx_notice;
     rt_mutex_t lock;
+#ifdef RT_SERIAL_USING_DMA
+    /* the received data parsed in place of DMA receive fifo */
+    struct rt_serial_rx_span rx_span;
+    rt_size_t rx_span_pos;
+    /* skip to the next line after the fifo is overrun */
+    rt_bool_t rx_resync;
+#endif
 
     at_response_t resp;
     rt_sem_t resp_notice;
@@ -8,6 +8,8 @@
  * 2018-03-30     chenyong     first version
  * 2018-04-12     chenyong     add client implement
  * 2018-08-17     chenyong     multiple client support
+ * 2026-10-17     RT-Thread    parse in place of serial DMA receive fifo
+ * 2026-10-17     RT-Thread    resync to the next line on the fifo overrun
  */
 
 #include <at.h>
@@ -430,10 +432,84 @@ rt_size_t at_client_obj_send(at_client_t client, const char *buf, rt_size_t size
     return rt_device_write(client->device, 0, buf, size);
 }
 
+#ifdef RT_SERIAL_USING_DMA
+/*
+ * get a character in place of the spans of DMA receive fifo. If the fifo is
+ * overrun, the characters got since the last acquire may be overwritten, so
+ * the data is skipped to the end of next line, and -RT_EFULL is returned to
+ * discard the partial line.
+ */
+static rt_err_t at_client_getchar_span(at_client_t client, char *ch, rt_int32_t timeout)
+{
+    struct rt_serial_rx_span *span = &client->rx_span;
+    rt_err_t result = RT_EOK;
+    char last_ch = 0;
+
+    while (1)
+    {
+        while (client->rx_span_pos >= span->size[0] + span->size[1])
+        {
+            /* release the consumed data, then acquire the new one */
+            if (rt_serial_rx_release(client->device, span, client->rx_span_pos) != RT_EOK)
+            {
+                LOG_W("AT client receive buffer overrun, discard the line.");
+                client->rx_resync = RT_TRUE;
+            }
+            client->rx_span_pos = 0;
+
+            if (rt_serial_rx_acquire(client->device, span) > 0)
+            {
+                break;
+            }
+
+            rt_sem_control(client->rx_notice, RT_IPC_CMD_RESET, RT_NULL);
+
+            result = rt_sem_take(client->rx_notice, rt_tick_from_millisecond(timeout));
+            if (result != RT_EOK)
+            {
+                return result;
+            }
+        }
+
+        if (client->rx_span_pos < span->size[0])
+        {
+            *ch = (char) span->data[0][client->rx_span_pos];
+        }
+        else
+        {
+            *ch = (char) span->data[1][client->rx_span_pos - span->size[0]];
+        }
+        client->rx_span_pos++;
+
+        if (client->rx_resync == RT_FALSE)
+        {
+            return RT_EOK;
+        }
+
+        /* skip to the end of next line */
+        if (*ch == '\n' && last_ch == '\r')
+        {
+            client->rx_resync = RT_FALSE;
+            return -RT_EFULL;
+        }
+        last_ch = *ch;
+    }
+}
+#endif /* RT_SERIAL_USING_DMA */
+
 static rt_err_t at_client_getchar(at_client_t client, char *ch, rt_int32_t timeout)
 {
     rt_err_t result = RT_EOK;
 
+#ifdef RT_SERIAL_USING_DMA
+    /* parse in place of DMA receive fifo without copy */
+    if ((client->device->open_flag & RT_DEVICE_FLAG_DMA_RX) &&
+            ((struct rt_serial_device *) client->device)->config.bufsz)
+    {
+        return at_client_getchar_span(client, ch, timeout);
+    }
+#endif
+
     while (rt_device_read(client->device, 0, ch, 1) == 0)
     {
         rt_sem_control(client->rx_notice, RT_IPC_CMD_RESET, RT_NULL);
@@ -674,7 +750,13 @@ static int at_recv_readline(at_client_t client)
 
     while (1)
     {
-        at_client_getchar(client, &ch, RT_WAITING_FOREVER);
+        if (at_client_getchar(client, &ch, RT_WAITING_FOREVER) == -RT_EFULL)
+        {
+            /* the receive fifo is overrun, the line is lost */
+            rt_memset(client->recv_line_buf, 0x00, client->recv_bufsz);
+            client->recv_line_len = 0;
+            return -RT_EFULL;
+        }
 
         if (read_len < client->recv_bufsz)
         {
@@ -808,6 +890,11 @@ static int at_client_para_init(at_client_t client)
     client->status = AT_STATUS_UNINITIALIZED;
 
     client->recv_line_len = 0;
+#ifdef RT_SERIAL_USING_DMA
+    rt_memset(&client->rx_span, 0x00, sizeof(client->rx_span));
+    client->rx_span_pos = 0;
+    client->rx_resync = RT_FALSE;
+#endif
     client->recv_line_buf = (char *) rt_calloc(1, client->recv_bufsz);
     if (client->recv_line_buf == RT_NULL)
     {
@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Memory allocation profiler.
+ *
+ * It's built on the malloc/free hooks of system heap. Each live block is
+ * recorded in a fixed hash table with its size and owner, so the release of
+ * block is accounted to the thread which allocated it. All of the records are
+ * kept in static RAM, no memory is allocated in the hooks.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "memprof.h"
+
+#ifndef MEMPROF_TRACK_NUM
+#define MEMPROF_TRACK_NUM       256
+#endif
+
+#ifndef MEMPROF_THREAD_NUM
+#define MEMPROF_THREAD_NUM      16
+#endif
+
+#if (MEMPROF_TRACK_NUM & (MEMPROF_TRACK_NUM - 1)) != 0
+#error "MEMPROF_TRACK_NUM shall be a power of 2"
+#endif
+
+/* the owners of thread, interrupt and the threads out of table */
+#define MEMPROF_OWNER_ISR       MEMPROF_THREAD_NUM
+#define MEMPROF_OWNER_OTHER     (MEMPROF_THREAD_NUM + 1)
+#define MEMPROF_OWNER_NUM       (MEMPROF_THREAD_NUM + 2)
+
+#define MEMPROF_TRACK_MASK      (MEMPROF_TRACK_NUM - 1)
+#define MEMPROF_HASH(ptr)       ((((rt_ubase_t)(ptr) >> 2) * 2654435761UL) & MEMPROF_TRACK_MASK)
+
+struct memprof_track
+{
+    void *ptr;
+    rt_uint32_t size;
+    rt_uint16_t owner;
+};
+
+struct memprof_data
+{
+    struct memprof_header header;
+    struct memprof_bucket buckets[MEMPROF_SIZE_BUCKETS];
+    struct memprof_owner owners[MEMPROF_OWNER_NUM];
+
+    rt_thread_t tids[MEMPROF_THREAD_NUM];
+    rt_uint16_t thread_num;
+    rt_uint16_t last_owner;
+
+    rt_tick_t start_tick;
+    rt_tick_t window_tick;
+    rt_uint32_t window_count;
+    rt_bool_t running;
+};
+
+static struct memprof_data memprof;
+static struct memprof_track memprof_tracks[MEMPROF_TRACK_NUM];
+
+rt_inline int memprof_bucket(rt_size_t size)
+{
+    int index = 0;
+
+    while (index < MEMPROF_SIZE_BUCKETS - 1 &&
+           size > ((rt_size_t)1 << (MEMPROF_SIZE_MIN_SHIFT + index)))
+    {
+        index ++;
+    }
+
+    return index;
+}
+
+/* get the owner index of current context */
+static rt_uint16_t memprof_owner(void)
+{
+    rt_thread_t tid;
+    rt_uint16_t index;
+
+    if (rt_interrupt_get_nest() != 0)
+        return MEMPROF_OWNER_ISR;
+
+    tid = rt_thread_self();
+    if (tid == RT_NULL)
+        return MEMPROF_OWNER_OTHER;
+
+    /* most of allocations come from the same thread continuously */
+    index = memprof.last_owner;
+    if (index < memprof.thread_num && memprof.tids[index] == tid &&
+        rt_strncmp(memprof.owners[index].name, tid->name, RT_NAME_MAX) == 0)
+    {
+        return index;
+    }
+
+    for (index = 0; index < memprof.thread_num; index ++)
+    {
+        /* the thread object may be reused by another thread */
+        if (memprof.tids[index] == tid &&
+            rt_strncmp(memprof.owners[index].name, tid->name, RT_NAME_MAX) == 0)
+        {
+            break;
+        }
+    }
+
+    if (index == memprof.thread_num)
+    {
+        if (index == MEMPROF_THREAD_NUM)
+            return MEMPROF_OWNER_OTHER;
+
+        memprof.tids[index] = tid;
+        rt_strncpy(memprof.owners[index].name, tid->name, RT_NAME_MAX);
+        memprof.thread_num ++;
+    }
+    memprof.last_owner = index;
+
+    return index;
+}
+
+static void memprof_track_insert(void *ptr, rt_uint32_t size, rt_uint16_t owner)
+{
+    rt_uint32_t index, count;
+
+    index = MEMPROF_HASH(ptr);
+    for (count = 0; count < MEMPROF_TRACK_NUM; count ++)
+    {
+        if (memprof_tracks[index].ptr == RT_NULL)
+        {
+            memprof_tracks[index].ptr   = ptr;
+            memprof_tracks[index].size  = size;
+            memprof_tracks[index].owner = owner;
+            return;
+        }
+        index = (index + 1) & MEMPROF_TRACK_MASK;
+    }
+
+    memprof.header.untracked ++;
+}
+
+static struct memprof_track *memprof_track_find(void *ptr)
+{
+    rt_uint32_t index, count;
+
+    index = MEMPROF_HASH(ptr);
+    for (count = 0; count < MEMPROF_TRACK_NUM; count ++)
+    {
+        if (memprof_tracks[index].ptr == ptr)
+            return &memprof_tracks[index];
+        if (memprof_tracks[index].ptr == RT_NULL)
+            break;
+        index = (index + 1) & MEMPROF_TRACK_MASK;
+    }
+
+    return RT_NULL;
+}
+
+/* remove the track and shift the following tracks back to keep probing chain */
+static void memprof_track_remove(struct memprof_track *track)
+{
+    rt_uint32_t hole, index, home;
+
+    hole  = track - memprof_tracks;
+    index = hole;
+    while (1)
+    {
+        index = (index + 1) & MEMPROF_TRACK_MASK;
+        if (memprof_tracks[index].ptr == RT_NULL)
+            break;
+
+        /* the track can be moved if the hole is between its home and itself */
+        home = MEMPROF_HASH(memprof_tracks[index].ptr);
+        if (((index - home) & MEMPROF_TRACK_MASK) >= ((index - hole) & MEMPROF_TRACK_MASK))
+        {
+            memprof_tracks[hole] = memprof_tracks[index];
+            hole = index;
+        }
+    }
+
+    memprof_tracks[hole].ptr = RT_NULL;
+}
+
+static void memprof_malloc_hook(void *ptr, rt_size_t size)
+{
+    register rt_base_t level;
+    struct memprof_owner *owner;
+    struct memprof_bucket *bucket;
+    rt_uint16_t index;
+    rt_tick_t tick;
+
+    level = rt_hw_interrupt_disable();
+    if (memprof.running)
+    {
+        index  = memprof_owner();
+        owner  = &memprof.owners[index];
+        bucket = &memprof.buckets[memprof_bucket(size)];
+
+        owner->alloc_count ++;
+        owner->alloc_bytes += size;
+        owner->live_bytes  += size;
+        bucket->count ++;
+        bucket->bytes += size;
+
+        memprof.header.alloc_count ++;
+        memprof.header.alloc_bytes += size;
+        memprof.header.live_bytes  += size;
+        if (memprof.header.live_bytes > memprof.header.peak_live_bytes)
+            memprof.header.peak_live_bytes = memprof.header.live_bytes;
+
+        /* count the allocations in each second */
+        tick = rt_tick_get();
+        if (tick - memprof.window_tick >= RT_TICK_PER_SECOND)
+        {
+            memprof.window_tick  = tick;
+            memprof.window_count = 0;
+        }
+        memprof.window_count ++;
+        if (memprof.window_count > memprof.header.peak_rate)
+            memprof.header.peak_rate = memprof.window_count;
+
+        memprof_track_insert(ptr, size, index);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+static void memprof_free_hook(void *ptr)
+{
+    register rt_base_t level;
+    struct memprof_owner *owner;
+    struct memprof_track *track;
+
+    level = rt_hw_interrupt_disable();
+    /* the blocks allocated before starting are not tracked */
+    track = memprof.running ? memprof_track_find(ptr) : RT_NULL;
+    if (track != RT_NULL)
+    {
+        owner = &memprof.owners[track->owner];
+        owner->free_count ++;
+        owner->live_bytes -= track->size;
+
+        memprof.header.free_count ++;
+        memprof.header.live_bytes -= track->size;
+
+        memprof_track_remove(track);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will clean all of the records of profiler.
+ */
+void memprof_reset(void)
+{
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(&memprof.header, 0, sizeof(memprof.header));
+    rt_memset(memprof.buckets, 0, sizeof(memprof.buckets));
+    rt_memset(memprof.owners, 0, sizeof(memprof.owners));
+    rt_memset(memprof_tracks, 0, sizeof(memprof_tracks));
+    rt_strncpy(memprof.owners[MEMPROF_OWNER_ISR].name, "(isr)", RT_NAME_MAX);
+    rt_strncpy(memprof.owners[MEMPROF_OWNER_OTHER].name, "(other)", RT_NAME_MAX);
+
+    memprof.thread_num   = 0;
+    memprof.last_owner   = 0;
+    memprof.start_tick   = rt_tick_get();
+    memprof.window_tick  = memprof.start_tick;
+    memprof.window_count = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will start the profiler. It takes over the malloc and free
+ * hooks of system heap.
+ */
+void memprof_start(void)
+{
+    if (memprof.running)
+        return;
+
+    memprof_reset();
+    rt_malloc_sethook(memprof_malloc_hook);
+    rt_free_sethook(memprof_free_hook);
+    memprof.running = RT_TRUE;
+}
+
+/**
+ * This function will stop the profiler, and the records are kept.
+ */
+void memprof_stop(void)
+{
+    register rt_base_t level;
+
+    if (!memprof.running)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    memprof.running = RT_FALSE;
+    memprof.header.elapsed_tick = rt_tick_get() - memprof.start_tick;
+    rt_hw_interrupt_enable(level);
+
+    rt_malloc_sethook(RT_NULL);
+    rt_free_sethook(RT_NULL);
+}
+
+/**
+ * This function will export the records in binary, which is described in
+ * memprof.h.
+ *
+ * @param buffer the buffer to store records, or RT_NULL to get the size
+ * @param size the size of buffer
+ *
+ * @return the size of records, or 0 if the buffer is too small
+ */
+rt_size_t memprof_export(void *buffer, rt_size_t size)
+{
+    register rt_base_t level;
+    struct memprof_header *header;
+    rt_uint8_t *ptr;
+    rt_size_t length;
+
+    length = sizeof(struct memprof_header) +
+             sizeof(memprof.buckets) +
+             sizeof(struct memprof_owner) * MEMPROF_OWNER_NUM;
+    if (buffer == RT_NULL)
+        return length;
+    if (size < length)
+        return 0;
+
+    ptr = (rt_uint8_t *)buffer;
+    header = (struct memprof_header *)ptr;
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(header, &memprof.header, sizeof(struct memprof_header));
+    if (memprof.running)
+        header->elapsed_tick = rt_tick_get() - memprof.start_tick;
+    ptr += sizeof(struct memprof_header);
+
+    rt_memcpy(ptr, memprof.buckets, sizeof(memprof.buckets));
+    ptr += sizeof(memprof.buckets);
+
+    /* the recorded threads followed by "(isr)" and "(other)" */
+    rt_memcpy(ptr, memprof.owners, sizeof(struct memprof_owner) * memprof.thread_num);
+    ptr += sizeof(struct memprof_owner) * memprof.thread_num;
+    rt_memcpy(ptr, &memprof.owners[MEMPROF_OWNER_ISR], sizeof(struct memprof_owner) * 2);
+    ptr += sizeof(struct memprof_owner) * 2;
+    rt_hw_interrupt_enable(level);
+
+    header->magic           = MEMPROF_MAGIC;
+    header->version         = MEMPROF_VERSION;
+    header->tick_per_second = RT_TICK_PER_SECOND;
+    header->bucket_num      = MEMPROF_SIZE_BUCKETS;
+    header->owner_num       = memprof.thread_num + 2;
+    header->name_size       = RT_NAME_MAX;
+
+    return ptr - (rt_uint8_t *)buffer;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void memprof_show(struct memprof_header *header, struct memprof_bucket *buckets,
+                         struct memprof_owner *owners, rt_bool_t csv)
+{
+    rt_uint32_t index, rate;
+
+    rate = 0;
+    if (header->elapsed_tick)
+        rate = (rt_uint64_t)header->alloc_count * header->tick_per_second / header->elapsed_tick;
+
+    if (csv)
+    {
+        rt_kprintf("summary,tick,alloc,free,alloc_bytes,live_bytes,peak_live_bytes,rate,peak_rate,untracked\n");
+        rt_kprintf("summary,%d,%d,%d,%d,%d,%d,%d,%d,%d\n", header->elapsed_tick,
+                   header->alloc_count, header->free_count, header->alloc_bytes,
+                   header->live_bytes, header->peak_live_bytes, rate, header->peak_rate,
+                   header->untracked);
+
+        rt_kprintf("size,max_size,count,bytes\n");
+        for (index = 0; index < header->bucket_num; index ++)
+        {
+            rt_kprintf("size,%d,%d,%d\n", index == header->bucket_num - 1 ? -1 :
+                       1 << (MEMPROF_SIZE_MIN_SHIFT + index),
+                       buckets[index].count, buckets[index].bytes);
+        }
+
+        rt_kprintf("owner,name,alloc,free,alloc_bytes,live_bytes\n");
+        for (index = 0; index < header->owner_num; index ++)
+        {
+            rt_kprintf("owner,%.*s,%d,%d,%d,%d\n", RT_NAME_MAX, owners[index].name,
+                       owners[index].alloc_count, owners[index].free_count,
+                       owners[index].alloc_bytes, owners[index].live_bytes);
+        }
+
+        return;
+    }
+
+    rt_kprintf("elapsed: %d ticks, alloc: %d, free: %d, untracked: %d\n",
+               header->elapsed_tick, header->alloc_count, header->free_count,
+               header->untracked);
+    rt_kprintf("bytes allocated: %d, live: %d, peak live: %d\n",
+               header->alloc_bytes, header->live_bytes, header->peak_live_bytes);
+    rt_kprintf("allocation rate: %d/s, peak rate: %d/s\n\n", rate, header->peak_rate);
+
+    rt_kprintf("size     count      bytes\n");
+    rt_kprintf("-------- ---------- ----------\n");
+    for (index = 0; index < header->bucket_num; index ++)
+    {
+        if (buckets[index].count == 0)
+            continue;
+
+        if (index == header->bucket_num - 1)
+            rt_kprintf(">%-7d ", 1 << (MEMPROF_SIZE_MIN_SHIFT + index - 1));
+        else
+            rt_kprintf("<=%-6d ", 1 << (MEMPROF_SIZE_MIN_SHIFT + index));
+        rt_kprintf("%-10d %-10d\n", buckets[index].count, buckets[index].bytes);
+    }
+
+    rt_kprintf("\n%-*.*s alloc      free       bytes      live\n", RT_NAME_MAX, RT_NAME_MAX, "owner");
+    for (index = 0; index < RT_NAME_MAX; index ++) rt_kprintf("-");
+    rt_kprintf(" ---------- ---------- ---------- ----------\n");
+    for (index = 0; index < header->owner_num; index ++)
+    {
+        if (owners[index].alloc_count == 0 && owners[index].free_count == 0)
+            continue;
+
+        rt_kprintf("%-*.*s %-10d %-10d %-10d %-10d\n", RT_NAME_MAX, RT_NAME_MAX, owners[index].name,
+                   owners[index].alloc_count, owners[index].free_count,
+                   owners[index].alloc_bytes, owners[index].live_bytes);
+    }
+}
+
+static void memprof_dump_hex(rt_uint8_t *data, rt_size_t length)
+{
+    rt_size_t index;
+
+    for (index = 0; index < length; index ++)
+    {
+        rt_kprintf("%02x", data[index]);
+        if ((index & 0x1f) == 0x1f || index == length - 1)
+            rt_kprintf("\n");
+    }
+}
+
+static int memprof_cmd(int argc, char **argv)
+{
+    rt_uint8_t *buffer;
+    rt_size_t length;
+
+    if (argc < 2)
+    {
+        rt_kprintf("Usage: memprof start|stop|reset|show|csv|bin\n");
+        return 0;
+    }
+
+    if (rt_strcmp(argv[1], "start") == 0)
+    {
+        memprof_start();
+        return 0;
+    }
+    else if (rt_strcmp(argv[1], "stop") == 0)
+    {
+        memprof_stop();
+        return 0;
+    }
+    else if (rt_strcmp(argv[1], "reset") == 0)
+    {
+        memprof_reset();
+        return 0;
+    }
+
+    /* take a snapshot before printing, it's allocated after the snapshot size is known */
+    length = memprof_export(RT_NULL, 0);
+    buffer = (rt_uint8_t *)rt_malloc(length);
+    if (buffer == RT_NULL)
+    {
+        rt_kprintf("no memory for snapshot\n");
+        return -RT_ENOMEM;
+    }
+    length = memprof_export(buffer, length);
+
+    if (rt_strcmp(argv[1], "bin") == 0)
+    {
+        memprof_dump_hex(buffer, length);
+    }
+    else
+    {
+        struct memprof_header *header = (struct memprof_header *)buffer;
+        struct memprof_bucket *buckets = (struct memprof_bucket *)(header + 1);
+        struct memprof_owner *owners = (struct memprof_owner *)(buckets + header->bucket_num);
+
+        memprof_show(header, buckets, owners, rt_strcmp(argv[1], "csv") == 0);
+    }
+
+    rt_free(buffer);
+
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(memprof_cmd, memprof, memory allocation profiler. Usage: memprof start|stop|reset|show|csv|bin);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __MEMPROF_H__
+#define __MEMPROF_H__
+
+#include <rtthread.h>
+
+#define MEMPROF_MAGIC           0x4650524D      /* "MPRF" */
+#define MEMPROF_VERSION         1
+
+/* the size histogram buckets: <=8, <=16, ... <=8192 and >8192 bytes */
+#define MEMPROF_SIZE_MIN_SHIFT  3
+#define MEMPROF_SIZE_BUCKETS    12
+
+/*
+ * The layout of exported binary data, all of the fields are 32 bits words in
+ * the CPU byte order:
+ *
+ * struct memprof_header
+ * struct memprof_bucket  buckets[bucket_num]
+ * struct memprof_owner   owners[owner_num]
+ */
+struct memprof_header
+{
+    rt_uint32_t magic;
+    rt_uint32_t version;
+    rt_uint32_t tick_per_second;
+    rt_uint32_t elapsed_tick;                   /**< ticks of profiling */
+
+    rt_uint32_t alloc_count;
+    rt_uint32_t free_count;
+    rt_uint32_t alloc_bytes;
+    rt_uint32_t live_bytes;
+    rt_uint32_t peak_live_bytes;
+    rt_uint32_t peak_rate;                      /**< the maximal allocations in one second */
+    rt_uint32_t untracked;                      /**< blocks not tracked for the table is full */
+
+    rt_uint32_t bucket_num;
+    rt_uint32_t owner_num;
+    rt_uint32_t name_size;                      /**< the size of owner name */
+};
+
+struct memprof_bucket
+{
+    rt_uint32_t count;
+    rt_uint32_t bytes;
+};
+
+struct memprof_owner
+{
+    char name[RT_NAME_MAX];                     /**< thread name, "(isr)" or "(other)" */
+
+    rt_uint32_t alloc_count;
+    rt_uint32_t free_count;
+    rt_uint32_t alloc_bytes;
+    rt_uint32_t live_bytes;
+};
+
+void memprof_start(void);
+void memprof_stop(void);
+void memprof_reset(void);
+rt_size_t memprof_export(void *buffer, rt_size_t size);
+
+#endif
@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    exclude memprof and store the full pointers
+ */
+
+/*
+ * Binary trace recorder.
+ *
+ * The scheduler, interrupt, IPC object, thread suspend/resume, timer and heap
+ * hooks of kernel are taken over to record the events into a RAM ring, the
+ * oldest event is overwritten when the ring is full. Each event is stamped
+ * with the CPU time counter when RT_USING_CPUTIME is enabled, otherwise with
+ * the OS tick.
+ *
+ * The records are dumped with the names of kernel objects, and converted to
+ * Chrome trace JSON by tools/trace2json.py on host.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "trace.h"
+
+#ifdef RT_USING_CPUTIME
+#include <rtdevice.h>
+#endif
+
+#ifndef TRACE_EVENT_NUM
+#define TRACE_EVENT_NUM         512
+#endif
+
+#if (TRACE_EVENT_NUM & (TRACE_EVENT_NUM - 1)) != 0
+#error "TRACE_EVENT_NUM shall be a power of 2"
+#endif
+
+#define TRACE_EVENT_MASK        (TRACE_EVENT_NUM - 1)
+
+/* the malloc/free hooks have only one slot */
+#ifdef RT_USING_MEMPROF
+#error "trace recorder can not be used with memory allocation profiler"
+#endif
+
+#define TRACE_PTR(ptr)          ((rt_ubase_t)(ptr))
+
+struct trace_data
+{
+    rt_uint32_t mask;
+    rt_uint32_t written;                        /**< the events written since start */
+    rt_uint32_t frequency;
+    rt_bool_t cputime;                          /**< stamped with CPU time */
+    rt_bool_t running;
+};
+
+static struct trace_data trace;
+static struct trace_event trace_events[TRACE_EVENT_NUM];
+
+/* the classes of object whose name is dumped */
+static const rt_uint8_t trace_classes[] =
+{
+    RT_Object_Class_Thread,
+#ifdef RT_USING_SEMAPHORE
+    RT_Object_Class_Semaphore,
+#endif
+#ifdef RT_USING_MUTEX
+    RT_Object_Class_Mutex,
+#endif
+#ifdef RT_USING_EVENT
+    RT_Object_Class_Event,
+#endif
+#ifdef RT_USING_MAILBOX
+    RT_Object_Class_MailBox,
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    RT_Object_Class_MessageQueue,
+#endif
+    RT_Object_Class_Timer,
+};
+
+rt_inline rt_uint32_t trace_timestamp(void)
+{
+#ifdef RT_USING_CPUTIME
+    if (trace.cputime)
+        return clock_cpu_gettime();
+#endif
+
+    return rt_tick_get();
+}
+
+static void trace_record(rt_uint8_t type, rt_uint16_t data, rt_ubase_t arg0, rt_ubase_t arg1)
+{
+    register rt_base_t level;
+    struct trace_event *event;
+
+    if (!(trace.mask & TRACE_MASK(type)))
+        return;
+
+    level = rt_hw_interrupt_disable();
+    if (trace.running)
+    {
+        event = &trace_events[trace.written & TRACE_EVENT_MASK];
+        event->timestamp = trace_timestamp();
+        event->type      = type;
+#ifdef RT_USING_SMP
+        event->cpu       = rt_hw_cpu_id();
+#else
+        event->cpu       = 0;
+#endif
+        event->data      = data;
+        event->arg0      = arg0;
+        event->arg1      = arg1;
+        trace.written ++;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+static void trace_switch_hook(struct rt_thread *from, struct rt_thread *to)
+{
+    trace_record(TRACE_EVENT_SWITCH, 0, TRACE_PTR(from), TRACE_PTR(to));
+}
+
+static void trace_irq_enter_hook(void)
+{
+    trace_record(TRACE_EVENT_IRQ_ENTER, rt_interrupt_get_nest(), 0, 0);
+}
+
+static void trace_irq_leave_hook(void)
+{
+    trace_record(TRACE_EVENT_IRQ_LEAVE, rt_interrupt_get_nest(), 0, 0);
+}
+
+static void trace_object_trytake_hook(struct rt_object *object)
+{
+    trace_record(TRACE_EVENT_OBJ_TRYTAKE, object->type & ~RT_Object_Class_Static,
+                 TRACE_PTR(object), TRACE_PTR(rt_thread_self()));
+}
+
+static void trace_object_take_hook(struct rt_object *object)
+{
+    trace_record(TRACE_EVENT_OBJ_TAKE, object->type & ~RT_Object_Class_Static,
+                 TRACE_PTR(object), TRACE_PTR(rt_thread_self()));
+}
+
+static void trace_object_put_hook(struct rt_object *object)
+{
+    trace_record(TRACE_EVENT_OBJ_PUT, object->type & ~RT_Object_Class_Static,
+                 TRACE_PTR(object), TRACE_PTR(rt_thread_self()));
+}
+
+static void trace_thread_suspend_hook(rt_thread_t thread)
+{
+    trace_record(TRACE_EVENT_THREAD_SUSPEND, 0, TRACE_PTR(thread), TRACE_PTR(rt_thread_self()));
+}
+
+static void trace_thread_resume_hook(rt_thread_t thread)
+{
+    trace_record(TRACE_EVENT_THREAD_RESUME, 0, TRACE_PTR(thread), TRACE_PTR(rt_thread_self()));
+}
+
+static void trace_timer_enter_hook(struct rt_timer *timer)
+{
+    trace_record(TRACE_EVENT_TIMER_ENTER, 0, TRACE_PTR(timer), TRACE_PTR(timer->timeout_func));
+}
+
+static void trace_timer_exit_hook(struct rt_timer *timer)
+{
+    trace_record(TRACE_EVENT_TIMER_EXIT, 0, TRACE_PTR(timer), TRACE_PTR(timer->timeout_func));
+}
+
+#ifdef RT_USING_HEAP
+static void trace_malloc_hook(void *ptr, rt_size_t size)
+{
+    trace_record(TRACE_EVENT_MALLOC, 0, TRACE_PTR(ptr), size);
+}
+
+static void trace_free_hook(void *ptr)
+{
+    trace_record(TRACE_EVENT_FREE, 0, TRACE_PTR(ptr), 0);
+}
+#endif
+
+/**
+ * This function will record a user event, such as the stages of a packet
+ * passed through the protocol stack and the driver.
+ *
+ * @param id the identifier of user event
+ * @param value the value of user event
+ */
+void trace_user(rt_uint16_t id, rt_uint32_t value)
+{
+    trace_record(TRACE_EVENT_USER, id, value, TRACE_PTR(rt_thread_self()));
+}
+RTM_EXPORT(trace_user);
+
+/**
+ * This function will start the recorder and clean the recorded events. It
+ * takes over the hooks of scheduler, interrupt, object, thread suspend/resume,
+ * timer and heap.
+ *
+ * @param mask the mask of event types to be recorded, TRACE_MASK_ALL for all
+ */
+void trace_start(rt_uint32_t mask)
+{
+    register rt_base_t level;
+
+    trace_stop();
+
+    trace.frequency = RT_TICK_PER_SECOND;
+    trace.cputime   = RT_FALSE;
+#ifdef RT_USING_CPUTIME
+    if (clock_cpu_getres() > 0)
+    {
+        trace.frequency = (rt_uint32_t)(1000000000.0f / clock_cpu_getres());
+        trace.cputime   = RT_TRUE;
+    }
+#endif
+
+    rt_scheduler_sethook(trace_switch_hook);
+    rt_interrupt_enter_sethook(trace_irq_enter_hook);
+    rt_interrupt_leave_sethook(trace_irq_leave_hook);
+    rt_object_trytake_sethook(trace_object_trytake_hook);
+    rt_object_take_sethook(trace_object_take_hook);
+    rt_object_put_sethook(trace_object_put_hook);
+    rt_thread_suspend_sethook(trace_thread_suspend_hook);
+    rt_thread_resume_sethook(trace_thread_resume_hook);
+    rt_timer_enter_sethook(trace_timer_enter_hook);
+    rt_timer_exit_sethook(trace_timer_exit_hook);
+#ifdef RT_USING_HEAP
+    rt_malloc_sethook(trace_malloc_hook);
+    rt_free_sethook(trace_free_hook);
+#endif
+
+    level = rt_hw_interrupt_disable();
+    trace.mask    = mask;
+    trace.written = 0;
+    trace.running = RT_TRUE;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(trace_start);
+
+/**
+ * This function will stop the recorder and release the hooks, the recorded
+ * events are kept until the next start.
+ */
+void trace_stop(void)
+{
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (!trace.running)
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+    trace.running = RT_FALSE;
+    rt_hw_interrupt_enable(level);
+
+    rt_scheduler_sethook(RT_NULL);
+    rt_interrupt_enter_sethook(RT_NULL);
+    rt_interrupt_leave_sethook(RT_NULL);
+    rt_object_trytake_sethook(RT_NULL);
+    rt_object_take_sethook(RT_NULL);
+    rt_object_put_sethook(RT_NULL);
+    rt_thread_suspend_sethook(RT_NULL);
+    rt_thread_resume_sethook(RT_NULL);
+    rt_timer_enter_sethook(RT_NULL);
+    rt_timer_exit_sethook(RT_NULL);
+#ifdef RT_USING_HEAP
+    rt_malloc_sethook(RT_NULL);
+    rt_free_sethook(RT_NULL);
+#endif
+}
+RTM_EXPORT(trace_stop);
+
+/* fill the names of objects, return the number of objects */
+static rt_uint32_t trace_names(struct trace_name *names, rt_uint32_t num)
+{
+    register rt_base_t level;
+    struct rt_object_information *information;
+    struct rt_object *object;
+    struct rt_list_node *node;
+    rt_uint32_t index, count;
+
+    count = 0;
+    for (index = 0; index < sizeof(trace_classes) / sizeof(trace_classes[0]); index ++)
+    {
+        information = rt_object_get_information((enum rt_object_class_type)trace_classes[index]);
+        if (information == RT_NULL)
+            continue;
+
+        level = rt_hw_interrupt_disable();
+        for (node  = information->object_list.next;
+             node != &(information->object_list);
+             node  = node->next)
+        {
+            object = rt_list_entry(node, struct rt_object, list);
+            if (count < num)
+            {
+                names[count].object = TRACE_PTR(object);
+                names[count].type   = object->type & ~RT_Object_Class_Static;
+                names[count].reserved[0] = names[count].reserved[1] = names[count].reserved[2] = 0;
+                rt_strncpy(names[count].name, object->name, RT_NAME_MAX);
+            }
+            count ++;
+        }
+        rt_hw_interrupt_enable(level);
+    }
+
+    return count;
+}
+
+static void trace_header(struct trace_header *header, rt_uint32_t name_num)
+{
+    header->magic      = TRACE_MAGIC;
+    header->version    = TRACE_VERSION;
+    header->event_size = sizeof(struct trace_event);
+    header->frequency  = trace.frequency;
+    header->event_num  = trace.written < TRACE_EVENT_NUM ? trace.written : TRACE_EVENT_NUM;
+    header->name_num   = name_num;
+    header->name_size  = RT_NAME_MAX;
+    header->ptr_size   = sizeof(rt_ubase_t);
+    header->lost       = trace.written - header->event_num;
+}
+
+/**
+ * This function will export the recorded events in binary, which is described
+ * in trace.h. The names of objects are truncated if the buffer is not enough.
+ *
+ * @param buffer the buffer to store events, or RT_NULL to get the size
+ * @param size the size of buffer
+ *
+ * @return the size of exported data, or 0 if the buffer is too small
+ */
+rt_size_t trace_export(void *buffer, rt_size_t size)
+{
+    register rt_base_t level;
+    struct trace_header *header;
+    struct trace_event *events;
+    rt_uint32_t name_num, index, first;
+    rt_size_t length;
+
+    level = rt_hw_interrupt_disable();
+    index = trace.written < TRACE_EVENT_NUM ? trace.written : TRACE_EVENT_NUM;
+    rt_hw_interrupt_enable(level);
+
+    length = sizeof(struct trace_header) + sizeof(struct trace_event) * index;
+    if (buffer == RT_NULL)
+        return length + sizeof(struct trace_name) * trace_names(RT_NULL, 0);
+    if (size < length)
+        return 0;
+
+    header = (struct trace_header *)buffer;
+    events = (struct trace_event *)(header + 1);
+
+    level = rt_hw_interrupt_disable();
+    trace_header(header, 0);
+    if (header->event_num > index)
+    {
+        /* some events have been recorded since the size is got */
+        header->lost += header->event_num - index;
+        header->event_num = index;
+    }
+    first = trace.written - header->event_num;
+    for (index = 0; index < header->event_num; index ++)
+        events[index] = trace_events[(first + index) & TRACE_EVENT_MASK];
+    rt_hw_interrupt_enable(level);
+
+    length = sizeof(struct trace_header) + sizeof(struct trace_event) * header->event_num;
+    name_num = trace_names((struct trace_name *)(events + header->event_num),
+                           (size - length) / sizeof(struct trace_name));
+    if (name_num > (size - length) / sizeof(struct trace_name))
+        name_num = (size - length) / sizeof(struct trace_name);
+    header->name_num = name_num;
+
+    return length + sizeof(struct trace_name) * name_num;
+}
+RTM_EXPORT(trace_export);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static const char *trace_event_names[] =
+{
+    "none", "switch", "irq_enter", "irq_leave", "trytake", "take", "put",
+    "suspend", "resume", "timer_enter", "timer_exit", "malloc", "free", "user"
+};
+
+static rt_uint32_t trace_dump_column;
+
+static void trace_dump_hex(const void *data, rt_size_t length)
+{
+    const rt_uint8_t *ptr = (const rt_uint8_t *)data;
+
+    while (length --)
+    {
+        rt_kprintf("%02x", *ptr ++);
+        if (++ trace_dump_column == 32)
+        {
+            rt_kprintf("\n");
+            trace_dump_column = 0;
+        }
+    }
+}
+
+/* dump the events in hex directly from the ring, the recorder shall be stopped */
+static int trace_dump(void)
+{
+    struct trace_header header;
+    struct trace_name *names;
+    rt_uint32_t name_num, index, first;
+
+    name_num = trace_names(RT_NULL, 0);
+    names = (struct trace_name *)rt_malloc(sizeof(struct trace_name) * name_num);
+    if (names == RT_NULL && name_num)
+    {
+        rt_kprintf("no memory for object names\n");
+        return -RT_ENOMEM;
+    }
+    name_num = trace_names(names, name_num);
+    trace_header(&header, name_num);
+
+    trace_dump_column = 0;
+    rt_kprintf("-----BEGIN TRACE-----\n");
+    trace_dump_hex(&header, sizeof(header));
+    first = trace.written - header.event_num;
+    for (index = 0; index < header.event_num; index ++)
+        trace_dump_hex(&trace_events[(first + index) & TRACE_EVENT_MASK], sizeof(struct trace_event));
+    trace_dump_hex(names, sizeof(struct trace_name) * name_num);
+    if (trace_dump_column)
+        rt_kprintf("\n");
+    rt_kprintf("-----END TRACE-----\n");
+
+    rt_free(names);
+
+    return 0;
+}
+
+static int trace_cmd(int argc, char **argv)
+{
+    rt_uint32_t mask, index;
+
+    if (argc < 2)
+    {
+        rt_kprintf("Usage: trace start [event...]|stop|status|dump\n");
+        rt_kprintf("events:");
+        for (index = TRACE_EVENT_SWITCH; index < TRACE_EVENT_MAX; index ++)
+            rt_kprintf(" %s", trace_event_names[index]);
+        rt_kprintf("\n");
+        return 0;
+    }
+
+    if (rt_strcmp(argv[1], "start") == 0)
+    {
+        mask = argc > 2 ? 0 : TRACE_MASK_ALL;
+        for (argc -= 2, argv += 2; argc > 0; argc --, argv ++)
+        {
+            for (index = TRACE_EVENT_SWITCH; index < TRACE_EVENT_MAX; index ++)
+            {
+                if (rt_strcmp(argv[0], trace_event_names[index]) == 0)
+                    break;
+            }
+            if (index == TRACE_EVENT_MAX)
+            {
+                rt_kprintf("unknown event: %s\n", argv[0]);
+                return -RT_EINVAL;
+            }
+            mask |= TRACE_MASK(index);
+        }
+
+        trace_start(mask);
+    }
+    else if (rt_strcmp(argv[1], "stop") == 0)
+    {
+        trace_stop();
+    }
+    else if (rt_strcmp(argv[1], "status") == 0)
+    {
+        rt_kprintf("%s, %d events recorded, %d overwritten, timestamp %d Hz\n",
+                   trace.running ? "running" : "stopped",
+                   trace.written < TRACE_EVENT_NUM ? trace.written : TRACE_EVENT_NUM,
+                   trace.written > TRACE_EVENT_NUM ? trace.written - TRACE_EVENT_NUM : 0,
+                   trace.frequency);
+    }
+    else if (rt_strcmp(argv[1], "dump") == 0)
+    {
+        /* the output of console shall not be recorded */
+        trace_stop();
+        return trace_dump();
+    }
+    else
+    {
+        rt_kprintf("Usage: trace start [event...]|stop|status|dump\n");
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(trace_cmd, trace, scheduler and IPC trace recorder. Usage: trace start|stop|status|dump);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    store the full pointers in records
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <rtthread.h>
+
+#define TRACE_MAGIC             0x52545452      /* "RTTR" */
+#define TRACE_VERSION           2
+
+/* the type of trace event */
+enum trace_event_type
+{
+    TRACE_EVENT_NONE = 0,
+    TRACE_EVENT_SWITCH,                         /**< arg0: from thread, arg1: to thread */
+    TRACE_EVENT_IRQ_ENTER,                      /**< data: interrupt nest */
+    TRACE_EVENT_IRQ_LEAVE,                      /**< data: interrupt nest */
+    TRACE_EVENT_OBJ_TRYTAKE,                    /**< arg0: object, arg1: thread, data: object type */
+    TRACE_EVENT_OBJ_TAKE,                       /**< arg0: object, arg1: thread, data: object type */
+    TRACE_EVENT_OBJ_PUT,                        /**< arg0: object, arg1: thread, data: object type */
+    TRACE_EVENT_THREAD_SUSPEND,                 /**< arg0: suspended thread, arg1: current thread */
+    TRACE_EVENT_THREAD_RESUME,                  /**< arg0: resumed thread, arg1: current thread */
+    TRACE_EVENT_TIMER_ENTER,                    /**< arg0: timer, arg1: timeout function */
+    TRACE_EVENT_TIMER_EXIT,                     /**< arg0: timer, arg1: timeout function */
+    TRACE_EVENT_MALLOC,                         /**< arg0: memory, arg1: size */
+    TRACE_EVENT_FREE,                           /**< arg0: memory */
+    TRACE_EVENT_USER,                           /**< arg0: value, arg1: thread, data: user id */
+    TRACE_EVENT_MAX
+};
+
+#define TRACE_MASK(type)        (1UL << (type))
+#define TRACE_MASK_ALL          (TRACE_MASK(TRACE_EVENT_MAX) - 2)
+
+struct trace_event
+{
+    rt_uint32_t timestamp;
+    rt_uint8_t  type;
+    rt_uint8_t  cpu;
+    rt_uint16_t data;
+    rt_ubase_t  arg0;
+    rt_ubase_t  arg1;
+};
+
+/*
+ * The layout of dumped binary data, all of the fields are in the CPU byte
+ * order:
+ *
+ * struct trace_header
+ * struct trace_event     events[event_num], the oldest one is the first
+ * struct trace_name      names[name_num]
+ */
+struct trace_header
+{
+    rt_uint32_t magic;
+    rt_uint16_t version;
+    rt_uint16_t event_size;
+    rt_uint32_t frequency;                      /**< the frequency of timestamp in Hz */
+    rt_uint32_t event_num;
+    rt_uint32_t name_num;
+    rt_uint16_t name_size;
+    rt_uint16_t ptr_size;                       /**< the size of pointer in events and names */
+    rt_uint32_t lost;                           /**< the events overwritten */
+};
+
+struct trace_name
+{
+    rt_ubase_t  object;
+    rt_uint8_t  type;                           /**< object type */
+    rt_uint8_t  reserved[3];
+    char        name[RT_NAME_MAX];
+};
+
+void trace_start(rt_uint32_t mask);
+void trace_stop(void);
+void trace_user(rt_uint16_t id, rt_uint32_t value);
+rt_size_t trace_export(void *buffer, rt_size_t size);
+
+#endif
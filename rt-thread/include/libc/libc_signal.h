@@ -54,6 +54,7 @@ struct siginfo
 typedef struct siginfo siginfo_t;
 #endif
 
+#ifndef HAVE_SIGINFO
 #define SI_USER     0x01    /* Signal sent by kill(). */
 #define SI_QUEUE    0x02    /* Signal sent by sigqueue(). */
 #define SI_TIMER    0x03    /* Signal generated by expiration of a 
@@ -62,6 +63,7 @@ typedef struct siginfo siginfo_t;
                                asynchronous I/O request. */
 #define SI_MESGQ    0x05    /* Signal generated by arrival of a 
                                message on an empty message queue. */
+#endif
 
 #ifdef RT_USING_NEWLIB
 #include <sys/signal.h>
@@ -247,6 +247,10 @@ typedef int (*init_fn_t)(void);
 #define RT_MM_PAGE_BITS                 12
 
 /* kernel malloc definitions */
+#ifdef RT_MEMHEAP_KERNEL_IN_FAST
+#define RT_KERNEL_MALLOC(sz)            rt_malloc_in(RT_MEMHEAP_CLASS_FAST, sz)
+#endif
+
 #ifndef RT_KERNEL_MALLOC
 #define RT_KERNEL_MALLOC(sz)            rt_malloc(sz)
 #endif
@@ -349,6 +353,9 @@ struct rt_object
     void      *module_id;                               /**< id of application module */
 #endif
     rt_list_t  list;                                    /**< list node of kernel object */
+#ifdef RT_USING_OBJECT_HASH
+    rt_slist_t hash_node;                               /**< node of name hash index */
+#endif
 };
 typedef struct rt_object *rt_object_t;                  /**< Type for kernel objects. */
 
@@ -387,6 +394,12 @@ enum rt_object_class_type
     RT_Object_Class_Static = 0x80                       /**< The object is a static object. */
 };
 
+#ifdef RT_USING_OBJECT_HASH
+#ifndef RT_OBJECT_HASH_SIZE
+#define RT_OBJECT_HASH_SIZE             16
+#endif
+#endif
+
 /**
  * The information of the kernel object
  */
@@ -395,6 +408,9 @@ struct rt_object_information
     enum rt_object_class_type type;                     /**< object class type */
     rt_list_t                 object_list;              /**< object list */
     rt_size_t                 object_size;              /**< object size */
+#ifdef RT_USING_OBJECT_HASH
+    rt_slist_t                hash_table[RT_OBJECT_HASH_SIZE]; /**< name hash index */
+#endif
 };
 
 /**
@@ -542,6 +558,27 @@ struct rt_cpu
 
 #endif
 
+#ifdef RT_USING_PERIODIC_THREAD
+/**
+ * Periodic thread, the jobs are released at absolute ticks
+ */
+struct rt_thread_periodic
+{
+    rt_tick_t   period;                                 /**< period in tick, 0 for non-periodic */
+    rt_tick_t   deadline;                               /**< relative deadline in tick */
+    rt_tick_t   release;                                /**< release tick of current job */
+
+    rt_uint32_t jobs;                                   /**< the completed jobs */
+    rt_uint32_t missed;                                 /**< the jobs miss deadline or skipped */
+    rt_uint32_t late;                                   /**< the releases later than release tick */
+    rt_tick_t   wcrt;                                   /**< worst-case response time in tick */
+#ifdef RT_USING_CPU_USAGE
+    rt_uint64_t exec_start;                             /**< CPU time at the release of current job */
+    rt_uint32_t wcet;                                   /**< worst-case execution time in CPU time tick */
+#endif
+};
+#endif
+
 /**
  * Thread structure
  */
@@ -557,6 +594,9 @@ struct rt_thread
 #endif
 
     rt_list_t   list;                                   /**< the object list */
+#ifdef RT_USING_OBJECT_HASH
+    rt_slist_t  hash_node;                              /**< node of name hash index */
+#endif
     rt_list_t   tlist;                                  /**< the thread list */
 
     /* stack point and entry */
@@ -617,6 +657,18 @@ struct rt_thread
     void        *lwp;
 #endif
 
+#ifdef RT_USING_MEMCACHE
+    void        *mem_cache;                             /**< cache of small memory blocks */
+#endif
+
+#ifdef RT_USING_CPU_USAGE
+    rt_uint64_t  cpu_time;                              /**< consumed CPU time */
+#endif
+
+#ifdef RT_USING_PERIODIC_THREAD
+    struct rt_thread_periodic periodic;                 /**< periodic release and statistics */
+#endif
+
     rt_uint32_t user_data;                             /**< private user data beyond this thread */
 };
 typedef struct rt_thread *rt_thread_t;
@@ -649,7 +701,27 @@ struct rt_ipc_object
     struct rt_object parent;                            /**< inherit from rt_object */
 
     rt_list_t        suspend_thread;                    /**< threads pended on this resource */
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_list_t        wait_list;                         /**< threads waiting on multiple objects */
+#endif
+};
+
+#ifdef RT_USING_IPC_STATS
+/**
+ * Contention statistics of semaphore and mutex, the time is in the tick of
+ * rt_ipc_stats_clock()
+ */
+struct rt_ipc_stats
+{
+    rt_uint32_t take;                                   /**< the attempts to take */
+    rt_uint32_t contended;                              /**< the attempts suspended on the object */
+    rt_uint64_t wait_total;                             /**< the total waiting time */
+    rt_uint32_t wait_max;                               /**< the maximal waiting time */
+    rt_uint32_t hold_max;                               /**< the maximal holding time of mutex */
+    rt_uint32_t hold_start;                             /**< the time the mutex is taken */
+    char        contender[RT_NAME_MAX];                 /**< the name of last contending thread */
 };
+#endif
 
 #ifdef RT_USING_SEMAPHORE
 /**
@@ -660,7 +732,11 @@ struct rt_semaphore
     struct rt_ipc_object parent;                        /**< inherit from ipc_object */
 
     rt_uint16_t          value;                         /**< value of semaphore. */
-    rt_uint16_t          reserved;                      /**< reserved field */
+    rt_uint16_t          reserved;                      /**< reserved field, contention mark of fast path */
+
+#ifdef RT_USING_IPC_STATS
+    struct rt_ipc_stats  stats;                         /**< contention statistics */
+#endif
 };
 typedef struct rt_semaphore *rt_sem_t;
 #endif
@@ -679,6 +755,10 @@ struct rt_mutex
     rt_uint8_t           hold;                          /**< numbers of thread hold the mutex */
 
     struct rt_thread    *owner;                         /**< current owner of mutex */
+
+#ifdef RT_USING_IPC_STATS
+    struct rt_ipc_stats  stats;                         /**< contention statistics */
+#endif
 };
 typedef struct rt_mutex *rt_mutex_t;
 #endif
@@ -760,6 +840,16 @@ typedef struct rt_messagequeue *rt_mq_t;
  */
 
 #ifdef RT_USING_MEMHEAP
+#ifdef RT_USING_MEMHEAP_CLASS
+/**
+ * placement classes of memory heap
+ */
+#define RT_MEMHEAP_CLASS_FAST           0x01            /**< fast memory not accessible by DMA, such as CCM */
+#define RT_MEMHEAP_CLASS_DMA            0x02            /**< DMA-capable memory */
+#define RT_MEMHEAP_CLASS_BULK           0x04            /**< large and slow memory */
+#define RT_MEMHEAP_CLASS_DEFAULT        (RT_MEMHEAP_CLASS_DMA | RT_MEMHEAP_CLASS_BULK)
+#endif
+
 /**
  * memory item on the heap
  */
@@ -794,6 +884,12 @@ struct rt_memheap
     struct rt_memheap_item  free_header;                /**< free block list header */
 
     struct rt_semaphore     lock;                       /**< semaphore lock */
+
+#ifdef RT_USING_MEMHEAP_CLASS
+    rt_uint8_t              heap_class;                 /**< placement classes of memory */
+    rt_uint32_t             alloc_count;                /**< allocations served by rt_malloc */
+    rt_uint32_t             fail_count;                 /**< allocations not fit in rt_malloc */
+#endif
 };
 #endif
 
@@ -12,6 +12,7 @@
  * 2017-10-17     Hichard      add some micros
  * 2018-11-17     Jesven       add rt_hw_spinlock_t
  *                             add smp support
+ * 2026-10-17     RT-Thread    add rt_hw_tickless_compensate
  */
 
 #ifndef __RT_HW_H__
@@ -104,6 +105,15 @@ void rt_hw_local_irq_enable(rt_base_t level);
 #else
 rt_base_t rt_hw_interrupt_disable(void);
 void rt_hw_interrupt_enable(rt_base_t level);
+
+#ifdef RT_USING_IRQ_LATENCY
+/* measure the interrupt-disabled sections with the call sites */
+rt_base_t rt_irq_latency_disable(const char *func, int line);
+void rt_irq_latency_enable(rt_base_t level);
+
+#define rt_hw_interrupt_disable()       rt_irq_latency_disable(__FUNCTION__, __LINE__)
+#define rt_hw_interrupt_enable(level)   rt_irq_latency_enable(level)
+#endif
 #endif /*RT_USING_SMP*/
 
 /*
@@ -134,6 +144,71 @@ void rt_hw_exception_install(rt_err_t (*exception_handle)(void *context));
  */
 void rt_hw_us_delay(rt_uint32_t us);
 
+#ifdef RT_USING_TICKLESS
+/*
+ * tickless interfaces
+ */
+rt_tick_t rt_hw_tickless_sleep(rt_tick_t timeout_tick);
+
+/**
+ * This function computes the ticks passed in a tickless sleep on a down
+ * counting timer, which is started with `reload` counts to the timeout tick,
+ * and it's reloaded with the same counts on expiry.
+ *
+ * @param cycles_per_tick the timer counts of one tick
+ * @param timeout_tick the ticks of sleep, the last one is at the expiry
+ * @param reload the timer counts from the start of sleep to the expiry
+ * @param counter the timer counts left on wakeup
+ * @param expired RT_TRUE if the timer has expired, and its pending interrupt
+ *        will count the last tick
+ * @param remain the timer counts to the next tick boundary, it's 2 at least
+ *        so the timer can be programmed with (remain - 1)
+ *
+ * @return the complete ticks passed in sleeping, not including the one which
+ *         is counted by the pending interrupt of timer.
+ */
+rt_inline rt_tick_t rt_hw_tickless_compensate(rt_uint32_t cycles_per_tick, rt_tick_t timeout_tick,
+                                              rt_uint32_t reload, rt_uint32_t counter,
+                                              rt_bool_t expired, rt_uint32_t *remain)
+{
+    rt_uint32_t passed;
+    rt_tick_t complete_tick;
+
+    if (expired)
+    {
+        /* the counts passed after the expiry at the boundary of last tick */
+        passed = reload - counter;
+        complete_tick = timeout_tick - 1;
+        *remain = passed < cycles_per_tick ? cycles_per_tick - passed : cycles_per_tick;
+    }
+    else
+    {
+        /* the counts passed from the beginning of the tick before sleep, the
+           reload is the rest counts of that tick and (timeout_tick - 1) ticks */
+        passed = cycles_per_tick * timeout_tick - counter;
+        complete_tick = passed / cycles_per_tick;
+        *remain = (complete_tick + 1) * cycles_per_tick - passed;
+    }
+
+    /* the boundary is too close to be programmed, count that tick now */
+    if (*remain < 2)
+    {
+        complete_tick ++;
+        *remain += cycles_per_tick;
+    }
+
+    return complete_tick;
+}
+#endif
+
+#ifdef RT_USING_IPC_FASTPATH
+/*
+ * atomic interfaces, store the new value to the word only if it equals to
+ * the old value, and return RT_TRUE if it's stored.
+ */
+rt_bool_t rt_hw_atomic_cas(volatile rt_uint32_t *ptr, rt_uint32_t oldval, rt_uint32_t newval);
+#endif
+
 #ifdef RT_USING_SMP
 typedef union {
     unsigned long slock;
@@ -51,6 +51,10 @@ void rt_object_delete(rt_object_t object);
 rt_bool_t rt_object_is_systemobject(rt_object_t object);
 rt_uint8_t rt_object_get_type(rt_object_t object);
 rt_object_t rt_object_find(const char *name, rt_uint8_t type);
+#ifdef RT_USING_OBJECT_HASH
+rt_object_t rt_object_hash_find(struct rt_object_information *information,
+                                const char *name);
+#endif
 
 #ifdef RT_USING_HOOK
 void rt_object_attach_sethook(void (*hook)(struct rt_object *object));
@@ -138,12 +142,19 @@ rt_err_t rt_thread_delete(rt_thread_t thread);
 
 rt_err_t rt_thread_yield(void);
 rt_err_t rt_thread_delay(rt_tick_t tick);
+rt_err_t rt_thread_delay_until(rt_tick_t *tick, rt_tick_t inc_tick);
 rt_err_t rt_thread_mdelay(rt_int32_t ms);
 rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg);
 rt_err_t rt_thread_suspend(rt_thread_t thread);
 rt_err_t rt_thread_resume(rt_thread_t thread);
 void rt_thread_timeout(void *parameter);
 
+#ifdef RT_USING_PERIODIC_THREAD
+rt_err_t rt_thread_set_periodic(rt_thread_t thread, rt_tick_t period, rt_tick_t deadline);
+rt_err_t rt_thread_wait_period(void);
+int rt_thread_periodic_assign_priority(rt_uint8_t highest);
+#endif
+
 #ifdef RT_USING_SIGNALS
 void rt_thread_alloc_sig(rt_thread_t tid);
 void rt_thread_free_sig(rt_thread_t tid);
@@ -167,6 +178,15 @@ rt_err_t rt_thread_idle_delhook(void (*hook)(void));
 void rt_thread_idle_excute(void);
 rt_thread_t rt_thread_idle_gethandler(void);
 
+/*
+ * CPU usage interface
+ */
+#ifdef RT_USING_CPU_USAGE
+void rt_cpu_usage_account(void);
+rt_uint64_t rt_thread_cpu_time(rt_thread_t thread);
+rt_uint64_t rt_interrupt_cpu_time(void);
+#endif
+
 /*
  * schedule service
  */
@@ -266,6 +286,16 @@ void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
 void rt_free_sethook(void (*hook)(void *ptr));
 #endif
 
+#ifdef RT_USING_MEMCACHE
+void *rt_heap_malloc(rt_size_t nbytes);
+void rt_heap_free(void *ptr);
+void *rt_heap_realloc(void *ptr, rt_size_t nbytes);
+void *rt_heap_calloc(rt_size_t count, rt_size_t size);
+
+void rt_mem_cache_thread_release(rt_thread_t thread);
+void rt_mem_cache_reclaim(void);
+#endif
+
 #endif
 
 #ifdef RT_USING_MEMHEAP
@@ -280,6 +310,11 @@ rt_err_t rt_memheap_detach(struct rt_memheap *heap);
 void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size);
 void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize);
 void rt_memheap_free(void *ptr);
+
+#ifdef RT_USING_MEMHEAP_CLASS
+rt_err_t rt_memheap_set_class(struct rt_memheap *heap, rt_uint8_t heap_class);
+void *rt_malloc_in(rt_uint8_t heap_class, rt_size_t size);
+#endif
 #endif
 
 /**@}*/
@@ -290,6 +325,14 @@ void rt_memheap_free(void *ptr);
 
 /**@{*/
 
+#ifdef RT_USING_IPC_STATS
+/*
+ * contention statistics interface
+ */
+rt_uint32_t rt_ipc_stats_clock(void);
+float rt_ipc_stats_clock_getres(void);
+#endif
+
 #ifdef RT_USING_SEMAPHORE
 /*
  * semaphore interface
@@ -385,6 +428,16 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                     rt_size_t  size,
                     rt_int32_t timeout);
 rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg);
+
+void *rt_mq_reserve(rt_mq_t mq);
+rt_err_t rt_mq_commit(rt_mq_t mq, void *buffer);
+rt_size_t rt_mq_send_burst(rt_mq_t mq, const void *buffer, rt_size_t size, rt_size_t count);
+rt_err_t rt_mq_peek(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer);
+#endif
+
+#ifdef RT_USING_IPC_WAIT_ANY
+rt_int32_t rt_wait_any(rt_object_t objects[], rt_uint8_t count, rt_int32_t timeout);
 #endif
 
 /**@}*/
@@ -444,6 +497,31 @@ rt_err_t  rt_device_control(rt_device_t dev, int cmd, void *arg);
 void rt_interrupt_enter(void);
 void rt_interrupt_leave(void);
 
+#ifdef RT_USING_SOFTIRQ
+/*
+ * softirq interface
+ */
+void rt_system_softirq_init(void);
+rt_err_t rt_softirq_register(rt_uint8_t nr, const char *name,
+                             void (*handler)(void *parameter), void *parameter,
+                             rt_uint16_t budget);
+void rt_softirq_unregister(rt_uint8_t nr);
+void rt_softirq_raise(rt_uint8_t nr);
+void rt_softirq_leave(void);
+#endif
+
+#ifdef RT_USING_IRQ_LATENCY
+/* measure the interrupt service routines with the function names */
+void rt_irq_latency_isr_enter(const char *func);
+void rt_irq_latency_isr_leave(void);
+void rt_irq_latency_reset(void);
+rt_uint32_t rt_irq_latency_get(rt_bool_t isr, rt_uint32_t *max);
+rt_uint32_t rt_irq_latency_get_func(const char *func, rt_uint32_t *max);
+
+#define rt_interrupt_enter()    rt_irq_latency_isr_enter(__FUNCTION__)
+#define rt_interrupt_leave()    rt_irq_latency_isr_leave()
+#endif
+
 #ifdef RT_USING_SMP
 
 /*
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    make the CAS inline for the cpuport.c to wrap
+ */
+
+/*
+ * The atomic compare and swap by the exclusive access instructions of
+ * ARMv7-M. The cpuport.c of Cortex-M3, M4 and M7 includes it, and defines
+ * rt_hw_atomic_cas by rt_hw_ldrex_cas.
+ */
+
+#ifndef __ATOMIC_LDREX_H__
+#define __ATOMIC_LDREX_H__
+
+#include <rtthread.h>
+
+#ifdef RT_USING_IPC_FASTPATH
+/**
+ * This function stores the new value to the word only if it equals to the old
+ * value, with the exclusive access instructions LDREX and STREX. The exclusive
+ * monitor is cleared on exception entry and return, then the store fails if
+ * it's interrupted between LDREX and STREX.
+ *
+ * @return RT_TRUE if the new value is stored.
+ */
+#if defined(__CC_ARM)
+rt_inline rt_bool_t rt_hw_ldrex_cas(volatile rt_uint32_t *ptr, rt_uint32_t oldval, rt_uint32_t newval)
+{
+    do
+    {
+        if (__ldrex(ptr) != oldval)
+        {
+            __clrex();
+            return RT_FALSE;
+        }
+    } while (__strex(newval, ptr) != 0);
+
+    return RT_TRUE;
+}
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+
+rt_inline rt_bool_t rt_hw_ldrex_cas(volatile rt_uint32_t *ptr, rt_uint32_t oldval, rt_uint32_t newval)
+{
+    do
+    {
+        if (__LDREX((unsigned long *)ptr) != oldval)
+        {
+            __CLREX();
+            return RT_FALSE;
+        }
+    } while (__STREX(newval, (unsigned long *)ptr) != 0);
+
+    return RT_TRUE;
+}
+#elif defined(__CLANG_ARM) || defined(__GNUC__)
+rt_inline rt_bool_t rt_hw_ldrex_cas(volatile rt_uint32_t *ptr, rt_uint32_t oldval, rt_uint32_t newval)
+{
+    rt_uint32_t value, status;
+
+    do
+    {
+        __asm volatile ("LDREX %0, [%1]" : "=r"(value) : "r"(ptr) : "memory");
+        if (value != oldval)
+        {
+            __asm volatile ("CLREX" : : : "memory");
+            return RT_FALSE;
+        }
+        __asm volatile ("STREX %0, %2, [%1]" : "=&r"(status) : "r"(ptr), "r"(newval) : "memory");
+    } while (status != 0);
+
+    return RT_TRUE;
+}
+#endif
+
+#endif /* RT_USING_IPC_FASTPATH */
+
+#endif
@@ -12,9 +12,12 @@
  * 2012-12-29   Bernard     Add exception hook.
  * 2013-07-09   aozima      enhancement hard fault exception handler.
  * 2019-07-03   yangjie     add __rt_ffs() for armclang.
+ * 2026-10-17   RT-Thread   move rt_hw_atomic_cas to atomic_ldrex.h
+ * 2026-10-17   RT-Thread   define rt_hw_atomic_cas by the inline one
  */
 
 #include <rtthread.h>
+#include "atomic_ldrex.h"
 
 struct exception_stack_frame
 {
@@ -359,6 +362,19 @@ RT_WEAK void rt_hw_cpu_reset(void)
     SCB_AIRCR = SCB_RESET_VALUE;
 }
 
+#ifdef RT_USING_IPC_FASTPATH
+/**
+ * This function stores the new value to the word only if it equals to the old
+ * value.
+ *
+ * @return RT_TRUE if the new value is stored.
+ */
+rt_bool_t rt_hw_atomic_cas(volatile rt_uint32_t *ptr, rt_uint32_t oldval, rt_uint32_t newval)
+{
+    return rt_hw_ldrex_cas(ptr, oldval, newval);
+}
+#endif
+
 #ifdef RT_USING_CPU_FFS
 /**
  * This function finds the first bit set (beginning with the least significant bit)
@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    fix the build with RT_USING_IRQ_LATENCY
+ */
+
+/*
+ * The CPU porting of RT-Thread as a single POSIX process.
+ *
+ * Each thread of RT-Thread runs on a host thread, and only the host thread of
+ * the running thread is allowed to go. A context switch posts the semaphore
+ * of the next host thread and waits on its own one. The context of host
+ * thread is kept at the top of the stack of thread, then the sp of thread is
+ * always in its stack for the stack checking of scheduler.
+ *
+ * The interrupt disabling is a flag instead of the signal mask, which is much
+ * cheaper. The host threads of peripherals, such as the tick timer and the
+ * console, raise an interrupt by rt_hw_interrupt_trigger(), which marks the
+ * interrupt pending and sends a signal to the host thread of the running
+ * thread. The ISRs run in the signal handler if interrupt is enabled, or when
+ * interrupt is enabled again. A context switch requested in ISR is performed
+ * at the end of signal handler, as PendSV of Cortex-M.
+ *
+ * The code of RT-Thread shall not invoke the host library which holds locks,
+ * such as stdio and malloc, while interrupt is enabled, because the thread
+ * may be switched out with the lock held.
+ */
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "cpuport.h"
+
+#ifdef RT_USING_IRQ_LATENCY
+/* the functions are redirected by macros for measurement */
+#undef rt_hw_interrupt_disable
+#undef rt_hw_interrupt_enable
+#endif
+
+/* the signal of interrupt */
+#define POSIX_IRQ_SIGNAL            SIGUSR1
+
+#ifndef RT_HW_INTERRUPT_NUM
+#define RT_HW_INTERRUPT_NUM         32
+#endif
+#ifndef RT_HW_PTHREAD_STACK_SIZE
+#define RT_HW_PTHREAD_STACK_SIZE    (256 * 1024)
+#endif
+
+/* the context of a thread, at the top of its stack */
+struct posix_context
+{
+    void (*entry)(void *parameter);
+    void *parameter;
+    void (*exit)(void);
+
+    pthread_t pthread;
+    sem_t     sem;
+};
+
+static struct rt_irq_desc _irq_desc[RT_HW_INTERRUPT_NUM];
+static volatile rt_uint32_t _irq_pending;
+static volatile rt_uint32_t _irq_mask;
+static volatile rt_base_t _irq_disabled = 1;
+
+/* the context switch requested in ISR */
+static volatile rt_ubase_t _switch_from;
+static volatile rt_ubase_t _switch_to;
+static volatile int _switch_pending;
+
+static struct posix_context * volatile _current;
+
+#define posix_barrier()             __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+static void _irq_dispatch(void);
+
+/**
+ * This function will disable interrupt.
+ *
+ * @return the interrupt status before disabling
+ */
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    rt_base_t level = _irq_disabled;
+
+    _irq_disabled = 1;
+    posix_barrier();
+
+    return level;
+}
+
+/**
+ * This function will restore the interrupt status, and run the pending ISRs
+ * if interrupt is enabled.
+ *
+ * @param level the interrupt status
+ */
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    posix_barrier();
+    _irq_disabled = level;
+    posix_barrier();
+
+    if (level == 0 && (_irq_pending & ~_irq_mask))
+        _irq_dispatch();
+}
+
+static void _switch(rt_ubase_t from, rt_ubase_t to)
+{
+    struct posix_context *from_ctx = *(struct posix_context **)from;
+    struct posix_context *to_ctx   = *(struct posix_context **)to;
+    struct rt_thread *thread = rt_container_of((void *)from, struct rt_thread, sp);
+    sigset_t set, old;
+    int closed;
+
+    if (from_ctx == to_ctx)
+        return;
+
+    /* only the running thread receives the signal of interrupt */
+    sigemptyset(&set);
+    sigaddset(&set, POSIX_IRQ_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &set, &old);
+
+    /* the thread may be freed once the next thread runs */
+    closed = (thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_CLOSE;
+
+    _current = to_ctx;
+    sem_post(&to_ctx->sem);
+
+    /* the thread has exited, release its host thread */
+    if (closed)
+        pthread_exit(RT_NULL);
+
+    while (sem_wait(&from_ctx->sem) != 0 && errno == EINTR);
+
+    pthread_sigmask(SIG_SETMASK, &old, RT_NULL);
+}
+
+/* run the pending ISRs and the context switch requested in ISR */
+static void _irq_dispatch(void)
+{
+    rt_uint32_t pending;
+    int vector;
+
+    while (1)
+    {
+        _irq_disabled = 1;
+        posix_barrier();
+
+        pending = __atomic_fetch_and(&_irq_pending, _irq_mask, __ATOMIC_SEQ_CST) & ~_irq_mask;
+        while (pending)
+        {
+            vector = __builtin_ctz(pending);
+            pending &= ~(1UL << vector);
+
+            if (_irq_desc[vector].handler != RT_NULL)
+            {
+                _irq_desc[vector].handler(vector, _irq_desc[vector].param);
+#ifdef RT_USING_INTERRUPT_INFO
+                _irq_desc[vector].counter ++;
+#endif
+            }
+        }
+
+        if (_switch_pending)
+        {
+            _switch_pending = 0;
+            _switch(_switch_from, _switch_to);
+        }
+
+        posix_barrier();
+        _irq_disabled = 0;
+        posix_barrier();
+
+        /* the interrupt raised after the dispatching */
+        if ((_irq_pending & ~_irq_mask) == 0)
+            break;
+    }
+}
+
+static void _irq_signal_handler(int signo)
+{
+    int error = errno;
+
+    /* the pending ISRs run when interrupt is enabled */
+    if (!_irq_disabled)
+        _irq_dispatch();
+
+    errno = error;
+}
+
+static void *_thread_entry(void *parameter)
+{
+    struct posix_context *ctx = (struct posix_context *)parameter;
+    sigset_t set;
+
+    /* wait for the first switching to the thread */
+    while (sem_wait(&ctx->sem) != 0 && errno == EINTR);
+
+    sigemptyset(&set);
+    sigaddset(&set, POSIX_IRQ_SIGNAL);
+    pthread_sigmask(SIG_UNBLOCK, &set, RT_NULL);
+
+    /* the thread starts with interrupt enabled */
+    rt_hw_interrupt_enable(0);
+
+    ctx->entry(ctx->parameter);
+    ctx->exit();
+
+    return RT_NULL;
+}
+
+/**
+ * This function will initialize the context of thread, and create the host
+ * thread which waits for the first switching to the thread.
+ *
+ * @param tentry the entry of thread
+ * @param parameter the parameter of entry
+ * @param stack_addr the beginning stack address
+ * @param texit the function will be called when thread exit
+ *
+ * @return the context of thread as stack pointer
+ */
+rt_uint8_t *rt_hw_stack_init(void       *tentry,
+                             void       *parameter,
+                             rt_uint8_t *stack_addr,
+                             void       *texit)
+{
+    struct posix_context *ctx;
+    pthread_attr_t attr;
+    sigset_t set, old;
+    rt_base_t level;
+
+    ctx = (struct posix_context *)RT_ALIGN_DOWN((rt_ubase_t)stack_addr - sizeof(struct posix_context), 16);
+    ctx->entry     = (void (*)(void *))tentry;
+    ctx->parameter = parameter;
+    ctx->exit      = (void (*)(void))texit;
+    sem_init(&ctx->sem, 0, 0);
+
+    /* the host library may hold lock in pthread_create */
+    level = rt_hw_interrupt_disable();
+
+    sigfillset(&set);
+    pthread_sigmask(SIG_BLOCK, &set, &old);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_attr_setstacksize(&attr, RT_HW_PTHREAD_STACK_SIZE);
+    if (pthread_create(&ctx->pthread, &attr, _thread_entry, ctx) != 0)
+    {
+        rt_kprintf("create host thread failed\n");
+        RT_ASSERT(0);
+    }
+    pthread_attr_destroy(&attr);
+
+    pthread_sigmask(SIG_SETMASK, &old, RT_NULL);
+    rt_hw_interrupt_enable(level);
+
+    return (rt_uint8_t *)ctx;
+}
+
+/**
+ * This function will switch the context from a thread to another one. It's
+ * invoked with interrupt disabled.
+ *
+ * @param from the address of sp of the thread to switch from
+ * @param to the address of sp of the thread to switch to
+ */
+void rt_hw_context_switch(rt_ubase_t from, rt_ubase_t to)
+{
+    _switch(from, to);
+}
+
+/**
+ * This function will request a context switch in ISR, which is performed
+ * after all of the pending ISRs.
+ *
+ * @param from the address of sp of the thread to switch from
+ * @param to the address of sp of the thread to switch to
+ */
+void rt_hw_context_switch_interrupt(rt_ubase_t from, rt_ubase_t to)
+{
+    if (!_switch_pending)
+    {
+        _switch_pending = 1;
+        _switch_from = from;
+    }
+    _switch_to = to;
+}
+
+/**
+ * This function will switch to the first thread, and the host thread of
+ * caller is kept waiting for ever.
+ *
+ * @param to the address of sp of the thread to switch to
+ */
+void rt_hw_context_switch_to(rt_ubase_t to)
+{
+    struct posix_context *to_ctx = *(struct posix_context **)to;
+    sigset_t set;
+
+    sigemptyset(&set);
+    sigaddset(&set, POSIX_IRQ_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &set, RT_NULL);
+
+    _current = to_ctx;
+    sem_post(&to_ctx->sem);
+
+    while (1)
+        pause();
+}
+
+/**
+ * This function will initialize the interrupt of host process.
+ */
+void rt_hw_interrupt_init(void)
+{
+    struct sigaction action;
+    sigset_t set;
+
+    rt_memset(_irq_desc, 0, sizeof(_irq_desc));
+    _irq_mask = 0;
+
+    /* the host thread of startup never handles interrupt */
+    sigemptyset(&set);
+    sigaddset(&set, POSIX_IRQ_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &set, RT_NULL);
+
+    rt_memset(&action, 0, sizeof(action));
+    action.sa_handler = _irq_signal_handler;
+    sigfillset(&action.sa_mask);
+    sigaction(POSIX_IRQ_SIGNAL, &action, RT_NULL);
+}
+
+/**
+ * This function will mask an interrupt.
+ *
+ * @param vector the interrupt number
+ */
+void rt_hw_interrupt_mask(int vector)
+{
+    RT_ASSERT(vector >= 0 && vector < RT_HW_INTERRUPT_NUM);
+
+    __atomic_fetch_or(&_irq_mask, 1UL << vector, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * This function will un-mask an interrupt.
+ *
+ * @param vector the interrupt number
+ */
+void rt_hw_interrupt_umask(int vector)
+{
+    RT_ASSERT(vector >= 0 && vector < RT_HW_INTERRUPT_NUM);
+
+    __atomic_fetch_and(&_irq_mask, ~(1UL << vector), __ATOMIC_SEQ_CST);
+    if (_current != RT_NULL && (_irq_pending & (1UL << vector)))
+        pthread_kill(_current->pthread, POSIX_IRQ_SIGNAL);
+}
+
+/**
+ * This function will install an interrupt service routine to an interrupt.
+ *
+ * @param vector the interrupt number
+ * @param handler the interrupt service routine
+ * @param param the parameter of interrupt service routine
+ * @param name the name of interrupt
+ *
+ * @return the old handler
+ */
+rt_isr_handler_t rt_hw_interrupt_install(int              vector,
+                                         rt_isr_handler_t handler,
+                                         void            *param,
+                                         const char      *name)
+{
+    rt_isr_handler_t old_handler = RT_NULL;
+    rt_base_t level;
+
+    if (vector >= 0 && vector < RT_HW_INTERRUPT_NUM)
+    {
+        level = rt_hw_interrupt_disable();
+        old_handler = _irq_desc[vector].handler;
+        _irq_desc[vector].handler = handler;
+        _irq_desc[vector].param   = param;
+#ifdef RT_USING_INTERRUPT_INFO
+        rt_strncpy(_irq_desc[vector].name, name, RT_NAME_MAX);
+        _irq_desc[vector].counter = 0;
+#endif
+        rt_hw_interrupt_enable(level);
+    }
+
+    return old_handler;
+}
+
+/**
+ * This function will raise an interrupt. It's invoked by the host threads
+ * which emulate the peripherals.
+ *
+ * @param vector the interrupt number
+ */
+void rt_hw_interrupt_trigger(int vector)
+{
+    struct posix_context *ctx;
+
+    RT_ASSERT(vector >= 0 && vector < RT_HW_INTERRUPT_NUM);
+
+    __atomic_fetch_or(&_irq_pending, 1UL << vector, __ATOMIC_SEQ_CST);
+
+    /* the interrupt is pending until the scheduler is started */
+    ctx = _current;
+    if (ctx != RT_NULL && !(_irq_mask & (1UL << vector)))
+        pthread_kill(ctx->pthread, POSIX_IRQ_SIGNAL);
+}
+
+/**
+ * This function will put the host thread into sleep until an interrupt is
+ * raised. It's invoked in the idle hook, instead of the busy loop of idle.
+ */
+void rt_hw_cpu_idle(void)
+{
+    sigset_t set, old;
+
+    sigemptyset(&set);
+    sigaddset(&set, POSIX_IRQ_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &set, &old);
+
+    /* the signal of interrupt raised before is kept pending */
+    if ((_irq_pending & ~_irq_mask) == 0)
+        sigsuspend(&old);
+
+    pthread_sigmask(SIG_SETMASK, &old, RT_NULL);
+}
+
+/**
+ * This function will shut down the host process.
+ */
+void rt_hw_cpu_shutdown(void)
+{
+    /* no thread is switched in while the host process exits */
+    rt_hw_interrupt_disable();
+    rt_kprintf("shutdown...\n");
+
+    exit(0);
+}
+
+/**
+ * This function will reset the CPU, that's to exit the host process with
+ * failure.
+ */
+void rt_hw_cpu_reset(void)
+{
+    rt_hw_interrupt_disable();
+
+    exit(EXIT_FAILURE);
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __CPUPORT_H__
+#define __CPUPORT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* raise an interrupt from the host thread of peripheral */
+void rt_hw_interrupt_trigger(int vector);
+/* sleep until an interrupt is raised */
+void rt_hw_cpu_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
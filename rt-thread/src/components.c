@@ -240,6 +240,11 @@ int rtthread_startup(void)
     /* timer thread initialization */
     rt_system_timer_thread_init();
 
+#ifdef RT_USING_SOFTIRQ
+    /* softirq thread initialization */
+    rt_system_softirq_init();
+#endif
+
     /* idle thread initialization */
     rt_thread_idle_init();
 
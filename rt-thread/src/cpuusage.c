@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    skip the accounting before the clock is set
+ */
+
+/*
+ * CPU time accounting of threads.
+ *
+ * The CPU time elapsed since the last accounting is charged to the current
+ * thread, or to interrupt if it's in interrupt service routine. It's
+ * accounted at each context switch and at the entry and exit of interrupt,
+ * with the CPU time counter of components/drivers/cputime. Nothing is
+ * accounted before the ops of CPU time is set, and the errno of thread is
+ * kept untouched.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h> /* for clock_cpu_getops */
+
+extern volatile rt_uint8_t rt_interrupt_nest;
+extern struct rt_thread *rt_current_thread;
+
+static rt_uint32_t _cpu_usage_stamp;
+static rt_bool_t _cpu_usage_started;
+static rt_uint64_t _cpu_usage_irq_time;
+
+/**
+ * This function will charge the CPU time elapsed since the last accounting to
+ * the current thread or interrupt.
+ *
+ * @note please don't invoke this routine in application, it shall be invoked
+ *       with interrupt disabled.
+ */
+void rt_cpu_usage_account(void)
+{
+    const struct rt_clock_cputime_ops *ops;
+    rt_uint32_t stamp, elapsed;
+
+    /* clock_cpu_gettime() sets errno of the current thread without the ops */
+    ops = clock_cpu_getops();
+    if (ops == RT_NULL)
+        return;
+
+    stamp   = ops->cputime_gettime();
+    elapsed = _cpu_usage_started ? stamp - _cpu_usage_stamp : 0;
+    _cpu_usage_stamp   = stamp;
+    _cpu_usage_started = RT_TRUE;
+
+    if (rt_interrupt_nest)
+        _cpu_usage_irq_time += elapsed;
+    else if (rt_current_thread != RT_NULL)
+        rt_current_thread->cpu_time += elapsed;
+}
+
+/**
+ * This function will return the CPU time consumed by a thread.
+ *
+ * @param thread the thread
+ *
+ * @return the CPU time in the tick of clock_cpu_gettime()
+ */
+rt_uint64_t rt_thread_cpu_time(rt_thread_t thread)
+{
+    register rt_base_t level;
+    rt_uint64_t time;
+
+    RT_ASSERT(thread != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    rt_cpu_usage_account();
+    time = thread->cpu_time;
+    rt_hw_interrupt_enable(level);
+
+    return time;
+}
+RTM_EXPORT(rt_thread_cpu_time);
+
+/**
+ * This function will return the CPU time consumed by interrupt service
+ * routines.
+ *
+ * @return the CPU time in the tick of clock_cpu_gettime()
+ */
+rt_uint64_t rt_interrupt_cpu_time(void)
+{
+    register rt_base_t level;
+    rt_uint64_t time;
+
+    level = rt_hw_interrupt_disable();
+    rt_cpu_usage_account();
+    time = _cpu_usage_irq_time;
+    rt_hw_interrupt_enable(level);
+
+    return time;
+}
+RTM_EXPORT(rt_interrupt_cpu_time);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+#include <stdlib.h>
+
+struct cpu_usage_sample
+{
+    rt_thread_t thread;
+    rt_uint64_t time;
+    rt_uint64_t delta;
+    char name[RT_NAME_MAX];
+    rt_uint8_t priority;
+    rt_uint8_t stat;
+};
+
+/* take the CPU time of all threads, return the number of samples */
+static int cpu_usage_sample(struct cpu_usage_sample *samples, int num, rt_uint64_t *irq_time)
+{
+    register rt_base_t level;
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_thread *thread;
+    int count = 0;
+
+    information = rt_object_get_information(RT_Object_Class_Thread);
+
+    level = rt_hw_interrupt_disable();
+    rt_cpu_usage_account();
+    *irq_time = _cpu_usage_irq_time;
+    for (node  = information->object_list.next;
+         node != &(information->object_list) && count < num;
+         node  = node->next)
+    {
+        thread = rt_list_entry(node, struct rt_thread, list);
+
+        samples[count].thread   = thread;
+        samples[count].time     = thread->cpu_time;
+        samples[count].delta    = thread->cpu_time;
+        samples[count].priority = thread->current_priority;
+        samples[count].stat     = thread->stat & RT_THREAD_STAT_MASK;
+        rt_strncpy(samples[count].name, thread->name, RT_NAME_MAX);
+        count ++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return count;
+}
+
+rt_inline void cpu_usage_percent(const char *prefix, rt_uint64_t delta, rt_uint64_t total)
+{
+    rt_uint32_t permille = total ? (rt_uint32_t)(delta * 1000 / total) : 0;
+
+    rt_kprintf("%s%3d.%d%%", prefix, permille / 10, permille % 10);
+}
+
+static void cpu_usage_show(struct cpu_usage_sample *samples, int count,
+                           rt_uint64_t irq_delta, rt_uint32_t window)
+{
+    rt_thread_t idle = rt_thread_idle_gethandler();
+    rt_uint64_t total, idle_delta;
+    float resolution = clock_cpu_getres();
+    struct cpu_usage_sample sample;
+    int index, prev;
+
+    total = irq_delta;
+    idle_delta = 0;
+    for (index = 0; index < count; index ++)
+    {
+        total += samples[index].delta;
+        if (samples[index].thread == idle)
+            idle_delta = samples[index].delta;
+    }
+
+    /* sort by the CPU time in window */
+    for (index = 1; index < count; index ++)
+    {
+        sample = samples[index];
+        for (prev = index - 1; prev >= 0 && samples[prev].delta < sample.delta; prev --)
+            samples[prev + 1] = samples[prev];
+        samples[prev + 1] = sample;
+    }
+
+    rt_kprintf("\nwindow %d ms,", window);
+    cpu_usage_percent(" used", total - idle_delta - irq_delta, total);
+    cpu_usage_percent(", irq", irq_delta, total);
+    cpu_usage_percent(", idle", idle_delta, total);
+    rt_kprintf("\n\n%-*.*s pri  status      cpu   time(ms)\n", RT_NAME_MAX, RT_NAME_MAX, "thread");
+    for (index = 0; index < RT_NAME_MAX; index ++) rt_kprintf("-");
+    rt_kprintf(" ---  ------- ------ ----------\n");
+    for (index = 0; index < count; index ++)
+    {
+        rt_kprintf("%-*.*s %3d ", RT_NAME_MAX, RT_NAME_MAX, samples[index].name, samples[index].priority);
+        if (samples[index].stat == RT_THREAD_READY)        rt_kprintf(" ready  ");
+        else if (samples[index].stat == RT_THREAD_SUSPEND) rt_kprintf(" suspend");
+        else if (samples[index].stat == RT_THREAD_INIT)    rt_kprintf(" init   ");
+        else if (samples[index].stat == RT_THREAD_CLOSE)   rt_kprintf(" close  ");
+        else if (samples[index].stat == RT_THREAD_RUNNING) rt_kprintf(" running");
+        cpu_usage_percent(" ", samples[index].delta, total);
+        rt_kprintf(" %10d\n", (rt_uint32_t)(samples[index].time * resolution / 1000000));
+    }
+}
+
+static int top(int argc, char **argv)
+{
+    struct cpu_usage_sample *first, *second;
+    rt_uint64_t first_irq, second_irq;
+    int window = 1000, loop = 1;
+    int num, first_count, second_count;
+    int index, prev;
+
+    if (argc > 1) window = atoi(argv[1]);
+    if (argc > 2) loop   = atoi(argv[2]);
+    if (window <= 0 || loop <= 0)
+    {
+        rt_kprintf("Usage: top [window_ms] [count]\n");
+        return -RT_EINVAL;
+    }
+    if (clock_cpu_getops() == RT_NULL)
+    {
+        rt_kprintf("no CPU time clock\n");
+        return -RT_ENOSYS;
+    }
+
+    /* leave some room for the threads created in window */
+    num = rt_list_len(&rt_object_get_information(RT_Object_Class_Thread)->object_list) + 8;
+    first  = (struct cpu_usage_sample *)rt_malloc(sizeof(struct cpu_usage_sample) * num);
+    second = (struct cpu_usage_sample *)rt_malloc(sizeof(struct cpu_usage_sample) * num);
+    if (first == RT_NULL || second == RT_NULL)
+    {
+        rt_kprintf("no memory for samples\n");
+        rt_free(first);
+        rt_free(second);
+        return -RT_ENOMEM;
+    }
+
+    first_count = cpu_usage_sample(first, num, &first_irq);
+    while (loop --)
+    {
+        rt_thread_mdelay(window);
+        second_count = cpu_usage_sample(second, num, &second_irq);
+
+        /* the CPU time in window, a thread created in window has no sample before */
+        for (index = 0; index < second_count; index ++)
+        {
+            for (prev = 0; prev < first_count; prev ++)
+            {
+                if (first[prev].thread == second[index].thread &&
+                    first[prev].time <= second[index].time)
+                {
+                    second[index].delta = second[index].time - first[prev].time;
+                    break;
+                }
+            }
+        }
+
+        /* the samples are sorted in place, keep the order of object list for next window */
+        rt_memcpy(first, second, sizeof(struct cpu_usage_sample) * second_count);
+        first_count = second_count;
+        cpu_usage_show(second, second_count, second_irq - first_irq, window);
+        first_irq = second_irq;
+    }
+
+    rt_free(first);
+    rt_free(second);
+
+    return 0;
+}
+MSH_CMD_EXPORT(top, show the CPU usage of threads. Usage: top [window_ms] [count]);
+#endif /* RT_USING_FINSH */
@@ -112,7 +112,9 @@ rt_err_t rt_device_init_all(void)
 rt_device_t rt_device_find(const char *name)
 {
     struct rt_object *object;
+#ifndef RT_USING_OBJECT_HASH
     struct rt_list_node *node;
+#endif
     struct rt_object_information *information;
 
     /* enter critical */
@@ -122,6 +124,15 @@ rt_device_t rt_device_find(const char *name)
     /* try to find device object */
     information = rt_object_get_information(RT_Object_Class_Device);
     RT_ASSERT(information != RT_NULL);
+#ifdef RT_USING_OBJECT_HASH
+    object = rt_object_hash_find(information, name);
+
+    /* leave critical */
+    if (rt_thread_self() != RT_NULL)
+        rt_exit_critical();
+
+    return (rt_device_t)object;
+#else
     for (node  = information->object_list.next;
          node != &(information->object_list);
          node  = node->next)
@@ -143,6 +154,7 @@ rt_device_t rt_device_find(const char *name)
 
     /* not found */
     return RT_NULL;
+#endif
 }
 RTM_EXPORT(rt_device_find);
 
@@ -148,6 +148,11 @@ rt_inline int _has_defunct_thread(void)
  */
 void rt_thread_idle_excute(void)
 {
+#ifdef RT_USING_MEMCACHE
+    /* give back the memory blocks cached by the closed threads */
+    rt_mem_cache_reclaim();
+#endif
+
     /* Loop until there is no dead thread. So one call to rt_thread_idle_excute
      * will do all the cleanups. */
     while (_has_defunct_thread())
@@ -228,6 +233,47 @@ void rt_thread_idle_excute(void)
     }
 }
 
+#ifdef RT_USING_TICKLESS
+#ifndef RT_TICKLESS_THRESH
+#define RT_TICKLESS_THRESH      2
+#endif
+
+/*
+ * This function will stop the periodic system tick when the next timer is far
+ * enough, and let the BSP sleep until that timer or any other interrupt. The
+ * ticks passed in sleeping are compensated to the system tick on wakeup.
+ */
+static void rt_thread_idle_tickless(void)
+{
+    rt_base_t level;
+    rt_tick_t timeout_tick;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    timeout_tick = rt_timer_next_timeout_tick();
+    if (timeout_tick != RT_TICK_MAX)
+    {
+        timeout_tick = timeout_tick - rt_tick_get();
+        /* the timer has been timeout but not handled yet */
+        if (timeout_tick >= RT_TICK_MAX / 2)
+            timeout_tick = 0;
+    }
+
+    if (timeout_tick >= RT_TICKLESS_THRESH)
+    {
+        /*
+         * The BSP returns the complete ticks passed in sleeping which are not
+         * counted by the tick interrupt.
+         */
+        rt_tick_set(rt_tick_get() + rt_hw_tickless_sleep(timeout_tick));
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+}
+#endif
+
 extern void rt_system_power_manager(void);
 static void rt_thread_idle_entry(void *parameter)
 {
@@ -258,6 +304,9 @@ static void rt_thread_idle_entry(void *parameter)
         rt_thread_idle_excute();
 #ifdef RT_USING_PM        
         rt_system_power_manager();
+#endif
+#ifdef RT_USING_TICKLESS
+        rt_thread_idle_tickless();
 #endif
     }
 }
@@ -33,6 +33,9 @@
  * 2011-12-18     Bernard      add more parameter checking in message queue
  * 2013-09-14     Grissiom     add an option check in rt_event_recv
  * 2018-10-02     Bernard      add 64bit support for mailbox
+ * 2026-10-17     RT-Thread    read the word of fast path by its fields
+ * 2026-10-17     RT-Thread    count the attempts to take at the entry of path
+ * 2026-10-17     RT-Thread    return error from rt_wait_any if its waiter is detached
  */
 
 #include <rtthread.h>
@@ -61,6 +64,9 @@ rt_inline rt_err_t rt_ipc_object_init(struct rt_ipc_object *ipc)
 {
     /* init ipc object */
     rt_list_init(&(ipc->suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_list_init(&(ipc->wait_list));
+#endif
 
     return RT_EOK;
 }
@@ -183,6 +189,244 @@ rt_inline rt_err_t rt_ipc_list_resume_all(rt_list_t *list)
     return RT_EOK;
 }
 
+#ifdef RT_USING_IPC_WAIT_ANY
+#ifndef RT_IPC_WAIT_ANY_MAX
+#define RT_IPC_WAIT_ANY_MAX     8
+#endif
+
+/* the node of a thread waiting on multiple objects, one for each object */
+struct rt_ipc_waiter
+{
+    rt_list_t         list;
+    struct rt_thread *thread;
+};
+
+/**
+ * This function will resume the threads waiting on multiple objects when the
+ * IPC object is ready. It shall be invoked with interrupt disabled.
+ *
+ * @param ipc the IPC object
+ *
+ * @return RT_TRUE if any thread is resumed
+ */
+rt_inline rt_bool_t rt_ipc_waiter_wakeup(struct rt_ipc_object *ipc)
+{
+    struct rt_list_node *n;
+    struct rt_ipc_waiter *waiter;
+    rt_bool_t resumed = RT_FALSE;
+
+    for (n = ipc->wait_list.next; n != &(ipc->wait_list); n = n->next)
+    {
+        waiter = rt_list_entry(n, struct rt_ipc_waiter, list);
+
+        /* the thread may be resumed by another object */
+        if ((waiter->thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+        {
+            rt_thread_resume(waiter->thread);
+            resumed = RT_TRUE;
+        }
+    }
+
+    return resumed;
+}
+
+/**
+ * This function will resume all of the threads waiting on multiple objects
+ * with error, and remove them from the IPC object to be detached or deleted.
+ * The thread resumed by another object before finds its waiter removed, and
+ * returns with error too.
+ *
+ * @param ipc the IPC object
+ */
+rt_inline void rt_ipc_waiter_detach(struct rt_ipc_object *ipc)
+{
+    struct rt_ipc_waiter *waiter;
+    register rt_ubase_t temp;
+
+    temp = rt_hw_interrupt_disable();
+    while (!rt_list_isempty(&(ipc->wait_list)))
+    {
+        waiter = rt_list_entry(ipc->wait_list.next, struct rt_ipc_waiter, list);
+        rt_list_remove(&(waiter->list));
+
+        if ((waiter->thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+        {
+            waiter->thread->error = -RT_ERROR;
+            rt_thread_resume(waiter->thread);
+        }
+    }
+    rt_hw_interrupt_enable(temp);
+}
+#endif
+
+#ifdef RT_USING_IPC_FASTPATH
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#endif
+
+/**
+ * This function is the generic atomic compare and swap for the architecture
+ * which has no implementation in libcpu. It uses the C11 atomic operation if
+ * it's lock free, otherwise the interrupt is disabled.
+ *
+ * @return RT_TRUE if the new value is stored.
+ */
+RT_WEAK rt_bool_t rt_hw_atomic_cas(volatile rt_uint32_t *ptr, rt_uint32_t oldval, rt_uint32_t newval)
+{
+#if defined(ATOMIC_INT_LOCK_FREE) && (ATOMIC_INT_LOCK_FREE == 2)
+    return atomic_compare_exchange_strong((volatile _Atomic rt_uint32_t *)ptr, &oldval, newval) ?
+           RT_TRUE : RT_FALSE;
+#else
+    register rt_base_t level;
+    rt_bool_t result = RT_FALSE;
+
+    level = rt_hw_interrupt_disable();
+    if (*ptr == oldval)
+    {
+        *ptr = newval;
+        result = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return result;
+#endif
+}
+
+/*
+ * The fast path takes and releases an uncontended semaphore or mutex by the
+ * atomic compare and swap of the word at its value field, without disabling
+ * interrupt. The slow path, which runs with interrupt disabled, marks the
+ * contention in the same word when a thread is suspended on the object, then
+ * the release of a contended object always falls into the slow path to resume
+ * the thread. The mark may be stale after the suspended thread is timeout,
+ * which only makes the next release go through the slow path to clear it.
+ */
+union rt_ipc_word
+{
+    rt_uint32_t word;
+    struct
+    {
+        rt_uint16_t value;
+        rt_uint16_t contended;                  /* the reserved field */
+    } sem;
+    struct
+    {
+        rt_uint16_t value;
+        rt_uint8_t  original_priority;
+        rt_uint8_t  hold;
+    } mutex;
+};
+
+/*
+ * The address of the word at the value field. It's only accessed by the
+ * rt_hw_atomic_cas, the word is read by its fields to the union, so there is
+ * no access by the type punned pointer in C. The torn read of the fields is
+ * found by the compare and swap, which fails on it.
+ */
+#define RT_IPC_WORD(value)          ((volatile rt_uint32_t *)&(value))
+
+/* the flag in the value of mutex, there is thread suspended on the mutex */
+#define RT_MUTEX_CONTENDED          0x8000
+
+/**
+ * This function will check whether there is any thread suspended on the IPC
+ * object. It shall be invoked with interrupt disabled.
+ *
+ * @param ipc the IPC object
+ *
+ * @return RT_TRUE if there is thread suspended on the IPC object
+ */
+rt_inline rt_bool_t rt_ipc_contended(struct rt_ipc_object *ipc)
+{
+    if (!rt_list_isempty(&(ipc->suspend_thread)))
+        return RT_TRUE;
+#ifdef RT_USING_IPC_WAIT_ANY
+    if (!rt_list_isempty(&(ipc->wait_list)))
+        return RT_TRUE;
+#endif
+
+    return RT_FALSE;
+}
+#else
+#define RT_MUTEX_CONTENDED          0
+#endif
+
+#ifdef RT_USING_IPC_STATS
+/*
+ * The contention statistics of semaphore and mutex are updated with interrupt
+ * disabled, even if the object is taken in fast path. Each attempt to take is
+ * counted once at the entry of fast path or slow path, and it's counted as
+ * contended if it suspends, so the contended attempts never exceed the
+ * attempts. The waiting time and holding time are the difference of
+ * rt_ipc_stats_clock(), which shall not wrap around during a wait or a hold.
+ */
+
+/**
+ * This function returns the clock of contention statistics. It's the OS tick
+ * by default, and the CPU time counter overrides it with RT_USING_CPUTIME.
+ *
+ * @return the current clock
+ */
+RT_WEAK rt_uint32_t rt_ipc_stats_clock(void)
+{
+    return rt_tick_get();
+}
+
+/**
+ * This function returns the resolution of the clock of contention statistics.
+ *
+ * @return the resolution in nanosecond
+ */
+RT_WEAK float rt_ipc_stats_clock_getres(void)
+{
+    return 1000000000.0f / RT_TICK_PER_SECOND;
+}
+
+/* account an attempt taken in fast path, and start the holding time of mutex */
+rt_inline void rt_ipc_stats_take(struct rt_ipc_stats *stats)
+{
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    stats->take ++;
+    stats->hold_start = rt_ipc_stats_clock();
+    rt_hw_interrupt_enable(level);
+}
+
+/* account a contention, it's invoked with interrupt disabled */
+rt_inline rt_uint32_t rt_ipc_stats_wait(struct rt_ipc_stats *stats, struct rt_thread *thread)
+{
+    stats->contended ++;
+    rt_strncpy(stats->contender, thread->name, RT_NAME_MAX);
+
+    return rt_ipc_stats_clock();
+}
+
+/* account the waiting time from the start of contention */
+rt_inline void rt_ipc_stats_wakeup(struct rt_ipc_stats *stats, rt_uint32_t start)
+{
+    register rt_base_t level;
+    rt_uint32_t time;
+
+    level = rt_hw_interrupt_disable();
+    time = rt_ipc_stats_clock() - start;
+    stats->wait_total += time;
+    if (time > stats->wait_max)
+        stats->wait_max = time;
+    rt_hw_interrupt_enable(level);
+}
+
+/* account the holding time of mutex, it's invoked with interrupt disabled */
+rt_inline void rt_ipc_stats_release(struct rt_ipc_stats *stats, rt_uint32_t start)
+{
+    rt_uint32_t time;
+
+    time = rt_ipc_stats_clock() - start;
+    if (time > stats->hold_max)
+        stats->hold_max = time;
+}
+#endif
+
 #ifdef RT_USING_SEMAPHORE
 /**
  * This function will initialize a semaphore and put it under control of
@@ -211,6 +455,10 @@ rt_err_t rt_sem_init(rt_sem_t    sem,
 
     /* set init value */
     sem->value = (rt_uint16_t)value;
+    sem->reserved = 0;
+#ifdef RT_USING_IPC_STATS
+    rt_memset(&(sem->stats), 0, sizeof(sem->stats));
+#endif
 
     /* set parent */
     sem->parent.parent.flag = flag;
@@ -237,6 +485,9 @@ rt_err_t rt_sem_detach(rt_sem_t sem)
 
     /* wakeup all suspend threads */
     rt_ipc_list_resume_all(&(sem->parent.suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_ipc_waiter_detach(&(sem->parent));
+#endif
 
     /* detach semaphore object */
     rt_object_detach(&(sem->parent.parent));
@@ -274,6 +525,10 @@ rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
 
     /* set init value */
     sem->value = value;
+    sem->reserved = 0;
+#ifdef RT_USING_IPC_STATS
+    rt_memset(&(sem->stats), 0, sizeof(sem->stats));
+#endif
 
     /* set parent */
     sem->parent.parent.flag = flag;
@@ -302,6 +557,9 @@ rt_err_t rt_sem_delete(rt_sem_t sem)
 
     /* wakeup all suspend threads */
     rt_ipc_list_resume_all(&(sem->parent.suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_ipc_waiter_detach(&(sem->parent));
+#endif
 
     /* delete semaphore object */
     rt_object_delete(&(sem->parent.parent));
@@ -311,6 +569,46 @@ rt_err_t rt_sem_delete(rt_sem_t sem)
 RTM_EXPORT(rt_sem_delete);
 #endif
 
+#ifdef RT_USING_IPC_FASTPATH
+/* take the semaphore in fast path if it's available */
+rt_inline rt_bool_t rt_sem_fast_take(rt_sem_t sem)
+{
+    union rt_ipc_word prev, next;
+
+    do
+    {
+        prev.sem.value     = *(volatile rt_uint16_t *)&(sem->value);
+        prev.sem.contended = *(volatile rt_uint16_t *)&(sem->reserved);
+        if (prev.sem.value == 0)
+            return RT_FALSE;
+
+        next.word = prev.word;
+        next.sem.value --;
+    } while (rt_hw_atomic_cas(RT_IPC_WORD(sem->value), prev.word, next.word) == RT_FALSE);
+
+    return RT_TRUE;
+}
+
+/* release the semaphore in fast path if there is no thread suspended on it */
+rt_inline rt_bool_t rt_sem_fast_release(rt_sem_t sem)
+{
+    union rt_ipc_word prev, next;
+
+    do
+    {
+        prev.sem.value     = *(volatile rt_uint16_t *)&(sem->value);
+        prev.sem.contended = *(volatile rt_uint16_t *)&(sem->reserved);
+        if (prev.sem.contended)
+            return RT_FALSE;
+
+        next.word = prev.word;
+        next.sem.value ++;
+    } while (rt_hw_atomic_cas(RT_IPC_WORD(sem->value), prev.word, next.word) == RT_FALSE);
+
+    return RT_TRUE;
+}
+#endif
+
 /**
  * This function will take a semaphore, if the semaphore is unavailable, the
  * thread shall wait for a specified time.
@@ -324,6 +622,9 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
 {
     register rt_base_t temp;
     struct rt_thread *thread;
+#ifdef RT_USING_IPC_STATS
+    rt_uint32_t wait_start;
+#endif
 
     /* parameter check */
     RT_ASSERT(sem != RT_NULL);
@@ -331,9 +632,25 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
 
     RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(sem->parent.parent)));
 
+#ifdef RT_USING_IPC_FASTPATH
+    if (rt_sem_fast_take(sem) == RT_TRUE)
+    {
+#ifdef RT_USING_IPC_STATS
+        rt_ipc_stats_take(&(sem->stats));
+#endif
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(sem->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif
+
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_IPC_STATS
+    sem->stats.take ++;
+#endif
+
     RT_DEBUG_LOG(RT_DEBUG_IPC, ("thread %s take sem:%s, which value is: %d\n",
                                 rt_thread_self()->name,
                                 ((struct rt_object *)sem)->name,
@@ -371,6 +688,14 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
             RT_DEBUG_LOG(RT_DEBUG_IPC, ("sem take: suspend thread - %s\n",
                                         thread->name));
 
+#ifdef RT_USING_IPC_FASTPATH
+            /* mark the contention, the release goes through slow path */
+            sem->reserved = 1;
+#endif
+#ifdef RT_USING_IPC_STATS
+            wait_start = rt_ipc_stats_wait(&(sem->stats), thread);
+#endif
+
             /* suspend thread */
             rt_ipc_list_suspend(&(sem->parent.suspend_thread),
                                 thread,
@@ -395,6 +720,10 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
             /* do schedule */
             rt_schedule();
 
+#ifdef RT_USING_IPC_STATS
+            rt_ipc_stats_wakeup(&(sem->stats), wait_start);
+#endif
+
             if (thread->error != RT_EOK)
             {
                 return thread->error;
@@ -440,6 +769,11 @@ rt_err_t rt_sem_release(rt_sem_t sem)
 
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(sem->parent.parent)));
 
+#ifdef RT_USING_IPC_FASTPATH
+    if (rt_sem_fast_release(sem) == RT_TRUE)
+        return RT_EOK;
+#endif
+
     need_schedule = RT_FALSE;
 
     /* disable interrupt */
@@ -457,7 +791,16 @@ rt_err_t rt_sem_release(rt_sem_t sem)
         need_schedule = RT_TRUE;
     }
     else
+    {
         sem->value ++; /* increase value */
+#ifdef RT_USING_IPC_WAIT_ANY
+        need_schedule = rt_ipc_waiter_wakeup(&(sem->parent));
+#endif
+    }
+
+#ifdef RT_USING_IPC_FASTPATH
+    sem->reserved = rt_ipc_contended(&(sem->parent));
+#endif
 
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
@@ -501,6 +844,13 @@ rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
 
         /* set new value */
         sem->value = (rt_uint16_t)value;
+#ifdef RT_USING_IPC_WAIT_ANY
+        if (sem->value)
+            rt_ipc_waiter_wakeup(&(sem->parent));
+#endif
+#ifdef RT_USING_IPC_FASTPATH
+        sem->reserved = rt_ipc_contended(&(sem->parent));
+#endif
 
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
@@ -541,6 +891,9 @@ rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
     mutex->owner = RT_NULL;
     mutex->original_priority = 0xFF;
     mutex->hold  = 0;
+#ifdef RT_USING_IPC_STATS
+    rt_memset(&(mutex->stats), 0, sizeof(mutex->stats));
+#endif
 
     /* set flag */
     mutex->parent.parent.flag = flag;
@@ -604,6 +957,9 @@ rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
     mutex->owner              = RT_NULL;
     mutex->original_priority  = 0xFF;
     mutex->hold               = 0;
+#ifdef RT_USING_IPC_STATS
+    rt_memset(&(mutex->stats), 0, sizeof(mutex->stats));
+#endif
 
     /* set flag */
     mutex->parent.parent.flag = flag;
@@ -641,6 +997,86 @@ rt_err_t rt_mutex_delete(rt_mutex_t mutex)
 RTM_EXPORT(rt_mutex_delete);
 #endif
 
+#ifdef RT_USING_IPC_FASTPATH
+/**
+ * This function will raise the priority of the owner to the highest one of the
+ * threads suspended on mutex. It's for the threads suspended between the mutex
+ * is taken in fast path and the owner is set, which can't find the owner.
+ */
+static void rt_mutex_fast_inherit(rt_mutex_t mutex, struct rt_thread *owner)
+{
+    register rt_base_t temp;
+    struct rt_list_node *n;
+    struct rt_thread *thread;
+
+    temp = rt_hw_interrupt_disable();
+    for (n = mutex->parent.suspend_thread.next; n != &(mutex->parent.suspend_thread); n = n->next)
+    {
+        thread = rt_list_entry(n, struct rt_thread, tlist);
+        if (thread->current_priority < owner->current_priority)
+        {
+            rt_thread_control(owner,
+                              RT_THREAD_CTRL_CHANGE_PRIORITY,
+                              &thread->current_priority);
+        }
+    }
+    rt_hw_interrupt_enable(temp);
+}
+
+/* take the mutex in fast path if it's free */
+rt_inline rt_bool_t rt_mutex_fast_take(rt_mutex_t mutex, struct rt_thread *thread)
+{
+    union rt_ipc_word prev, next;
+
+    prev.mutex.value             = 1;
+    prev.mutex.original_priority = 0xFF;
+    prev.mutex.hold              = 0;
+
+    next.mutex.value             = 0;
+    next.mutex.original_priority = thread->current_priority;
+    next.mutex.hold              = 1;
+
+    if (rt_hw_atomic_cas(RT_IPC_WORD(mutex->value), prev.word, next.word) == RT_FALSE)
+        return RT_FALSE;
+
+    /* the owner is set after the mutex is taken */
+    mutex->owner = thread;
+    if (mutex->value & RT_MUTEX_CONTENDED)
+        rt_mutex_fast_inherit(mutex, thread);
+
+    return RT_TRUE;
+}
+
+/* release the mutex in fast path if it's held once and uncontended */
+rt_inline rt_bool_t rt_mutex_fast_release(rt_mutex_t mutex, struct rt_thread *thread)
+{
+    union rt_ipc_word prev, next;
+
+    if (mutex->owner != thread || mutex->hold != 1 ||
+        mutex->original_priority != thread->current_priority)
+        return RT_FALSE;
+
+    prev.mutex.value             = 0;
+    prev.mutex.original_priority = thread->current_priority;
+    prev.mutex.hold              = 1;
+
+    next.mutex.value             = 1;
+    next.mutex.original_priority = 0xFF;
+    next.mutex.hold              = 0;
+
+    /* clear the owner before the mutex is free, and restore it on failure */
+    mutex->owner = RT_NULL;
+    if (rt_hw_atomic_cas(RT_IPC_WORD(mutex->value), prev.word, next.word) == RT_FALSE)
+    {
+        mutex->owner = thread;
+
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+#endif
+
 /**
  * This function will take a mutex, if the mutex is unavailable, the
  * thread shall wait for a specified time.
@@ -654,6 +1090,9 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
 {
     register rt_base_t temp;
     struct rt_thread *thread;
+#ifdef RT_USING_IPC_STATS
+    rt_uint32_t wait_start;
+#endif
 
     /* this function must not be used in interrupt even if time = 0 */
     RT_DEBUG_IN_THREAD_CONTEXT;
@@ -665,11 +1104,30 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
     /* get current thread */
     thread = rt_thread_self();
 
+#ifdef RT_USING_IPC_FASTPATH
+    if (rt_mutex_fast_take(mutex, thread) == RT_TRUE)
+    {
+        thread->error = RT_EOK;
+#ifdef RT_USING_IPC_STATS
+        rt_ipc_stats_take(&(mutex->stats));
+#endif
+
+        RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif
+
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
     RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
 
+#ifdef RT_USING_IPC_STATS
+    mutex->stats.take ++;
+#endif
+
     RT_DEBUG_LOG(RT_DEBUG_IPC,
                  ("mutex_take: current thread %s, mutex value: %d, hold: %d\n",
                   thread->name, mutex->value, mutex->hold));
@@ -688,7 +1146,7 @@ __again:
         /* The value of mutex is 1 in initial status. Therefore, if the
          * value is great than 0, it indicates the mutex is avaible.
          */
-        if (mutex->value > 0)
+        if ((mutex->value & ~RT_MUTEX_CONTENDED) > 0)
         {
             /* mutex is available */
             mutex->value --;
@@ -697,6 +1155,10 @@ __again:
             mutex->owner             = thread;
             mutex->original_priority = thread->current_priority;
             mutex->hold ++;
+
+#ifdef RT_USING_IPC_STATS
+            mutex->stats.hold_start = rt_ipc_stats_clock();
+#endif
         }
         else
         {
@@ -717,8 +1179,10 @@ __again:
                 RT_DEBUG_LOG(RT_DEBUG_IPC, ("mutex_take: suspend thread: %s\n",
                                             thread->name));
 
-                /* change the owner thread priority of mutex */
-                if (thread->current_priority < mutex->owner->current_priority)
+                /* change the owner thread priority of mutex, the owner
+                 * is not set yet if the mutex is just taken in fast path */
+                if (mutex->owner != RT_NULL &&
+                    thread->current_priority < mutex->owner->current_priority)
                 {
                     /* change the owner thread priority */
                     rt_thread_control(mutex->owner,
@@ -726,6 +1190,14 @@ __again:
                                       &thread->current_priority);
                 }
 
+#ifdef RT_USING_IPC_FASTPATH
+                /* mark the contention, the release goes through slow path */
+                mutex->value |= RT_MUTEX_CONTENDED;
+#endif
+#ifdef RT_USING_IPC_STATS
+                wait_start = rt_ipc_stats_wait(&(mutex->stats), thread);
+#endif
+
                 /* suspend current thread */
                 rt_ipc_list_suspend(&(mutex->parent.suspend_thread),
                                     thread,
@@ -751,10 +1223,23 @@ __again:
                 /* do schedule */
                 rt_schedule();
 
+#ifdef RT_USING_IPC_STATS
+                rt_ipc_stats_wakeup(&(mutex->stats), wait_start);
+#endif
+
                 if (thread->error != RT_EOK)
                 {
                     /* interrupt by signal, try it again */
-                    if (thread->error == -RT_EINTR) goto __again;
+                    if (thread->error == -RT_EINTR)
+                    {
+#ifdef RT_USING_IPC_STATS
+                        /* the retry is another attempt */
+                        temp = rt_hw_interrupt_disable();
+                        mutex->stats.take ++;
+                        rt_hw_interrupt_enable(temp);
+#endif
+                        goto __again;
+                    }
 
                     /* return error */
                     return thread->error;
@@ -791,6 +1276,9 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     register rt_base_t temp;
     struct rt_thread *thread;
     rt_bool_t need_schedule;
+#if defined(RT_USING_IPC_STATS) && defined(RT_USING_IPC_FASTPATH)
+    rt_uint32_t hold_start;
+#endif
 
     /* parameter check */
     RT_ASSERT(mutex != RT_NULL);
@@ -804,6 +1292,24 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* get current thread */
     thread = rt_thread_self();
 
+#ifdef RT_USING_IPC_FASTPATH
+#ifdef RT_USING_IPC_STATS
+    /* it's stable if the mutex is held by current thread */
+    hold_start = mutex->stats.hold_start;
+#endif
+    if (rt_mutex_fast_release(mutex, thread) == RT_TRUE)
+    {
+#ifdef RT_USING_IPC_STATS
+        temp = rt_hw_interrupt_disable();
+        rt_ipc_stats_release(&(mutex->stats), hold_start);
+        rt_hw_interrupt_enable(temp);
+#endif
+        RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif
+
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
@@ -829,6 +1335,10 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* if no hold */
     if (mutex->hold == 0)
     {
+#ifdef RT_USING_IPC_STATS
+        rt_ipc_stats_release(&(mutex->stats), mutex->stats.hold_start);
+#endif
+
         /* change the owner thread to original priority */
         if (mutex->original_priority != mutex->owner->current_priority)
         {
@@ -853,15 +1363,25 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
             mutex->original_priority = thread->current_priority;
             mutex->hold ++;
 
+#ifdef RT_USING_IPC_STATS
+            /* the mutex is handed over to the suspended thread */
+            mutex->stats.hold_start = rt_ipc_stats_clock();
+#endif
+
             /* resume thread */
             rt_ipc_list_resume(&(mutex->parent.suspend_thread));
 
+#ifdef RT_USING_IPC_FASTPATH
+            if (rt_list_isempty(&mutex->parent.suspend_thread))
+                mutex->value &= ~RT_MUTEX_CONTENDED;
+#endif
+
             need_schedule = RT_TRUE;
         }
         else
         {
-            /* increase value */
-            mutex->value ++;
+            /* increase value, and clear the stale mark of contention */
+            mutex->value = (mutex->value & ~RT_MUTEX_CONTENDED) + 1;
 
             /* clear owner */
             mutex->owner             = RT_NULL;
@@ -948,6 +1468,9 @@ rt_err_t rt_event_detach(rt_event_t event)
 
     /* resume all suspended thread */
     rt_ipc_list_resume_all(&(event->parent.suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_ipc_waiter_detach(&(event->parent));
+#endif
 
     /* detach event object */
     rt_object_detach(&(event->parent.parent));
@@ -1007,6 +1530,9 @@ rt_err_t rt_event_delete(rt_event_t event)
 
     /* resume all suspended thread */
     rt_ipc_list_resume_all(&(event->parent.suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_ipc_waiter_detach(&(event->parent));
+#endif
 
     /* delete event object */
     rt_object_delete(&(event->parent.parent));
@@ -1099,6 +1625,12 @@ rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
         }
     }
 
+#ifdef RT_USING_IPC_WAIT_ANY
+    /* the event set is left after the suspended threads receive */
+    if (event->set && rt_ipc_waiter_wakeup(&(event->parent)))
+        need_schedule = RT_TRUE;
+#endif
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
@@ -1337,6 +1869,9 @@ rt_err_t rt_mb_detach(rt_mailbox_t mb)
 
     /* resume all suspended thread */
     rt_ipc_list_resume_all(&(mb->parent.suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_ipc_waiter_detach(&(mb->parent));
+#endif
     /* also resume all mailbox private suspended thread */
     rt_ipc_list_resume_all(&(mb->suspend_sender_thread));
 
@@ -1413,6 +1948,9 @@ rt_err_t rt_mb_delete(rt_mailbox_t mb)
 
     /* resume all suspended thread */
     rt_ipc_list_resume_all(&(mb->parent.suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_ipc_waiter_detach(&(mb->parent));
+#endif
 
     /* also resume all mailbox private suspended thread */
     rt_ipc_list_resume_all(&(mb->suspend_sender_thread));
@@ -1553,6 +2091,19 @@ rt_err_t rt_mb_send_wait(rt_mailbox_t mb,
         return RT_EOK;
     }
 
+#ifdef RT_USING_IPC_WAIT_ANY
+    /* wake up the threads waiting on multiple objects */
+    if (rt_ipc_waiter_wakeup(&(mb->parent)))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+#endif
+
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
 
@@ -1843,6 +2394,9 @@ rt_err_t rt_mq_detach(rt_mq_t mq)
 
     /* resume all suspended thread */
     rt_ipc_list_resume_all(&mq->parent.suspend_thread);
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_ipc_waiter_detach(&(mq->parent));
+#endif
 
     /* detach message queue object */
     rt_object_detach(&(mq->parent.parent));
@@ -1938,6 +2492,9 @@ rt_err_t rt_mq_delete(rt_mq_t mq)
 
     /* resume all suspended thread */
     rt_ipc_list_resume_all(&(mq->parent.suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_ipc_waiter_detach(&(mq->parent));
+#endif
 
     /* free message queue pool */
     RT_KERNEL_FREE(mq->msg_pool);
@@ -2032,10 +2589,23 @@ rt_err_t rt_mq_send(rt_mq_t mq, const void *buffer, rt_size_t size)
         return RT_EOK;
     }
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(temp);
-
-    return RT_EOK;
+#ifdef RT_USING_IPC_WAIT_ANY
+    /* wake up the threads waiting on multiple objects */
+    if (rt_ipc_waiter_wakeup(&(mq->parent)))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+#endif
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return RT_EOK;
 }
 RTM_EXPORT(rt_mq_send);
 
@@ -2116,6 +2686,19 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
         return RT_EOK;
     }
 
+#ifdef RT_USING_IPC_WAIT_ANY
+    /* wake up the threads waiting on multiple objects */
+    if (rt_ipc_waiter_wakeup(&(mq->parent)))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+#endif
+
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
 
@@ -2123,34 +2706,19 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
 }
 RTM_EXPORT(rt_mq_urgent);
 
-/**
- * This function will receive a message from message queue object, if there is
- * no message in message queue object, the thread shall wait for a specified
- * time.
- *
- * @param mq the message queue object
- * @param buffer the received message will be saved in
- * @param size the size of buffer
- * @param timeout the waiting time
- *
- * @return the error code
+/*
+ * take the message at the head of message queue, the thread shall wait for a
+ * specified time if there is no message.
  */
-rt_err_t rt_mq_recv(rt_mq_t    mq,
-                    void      *buffer,
-                    rt_size_t  size,
-                    rt_int32_t timeout)
+static rt_err_t _rt_mq_take(rt_mq_t                mq,
+                            struct rt_mq_message **message,
+                            rt_int32_t             timeout)
 {
     struct rt_thread *thread;
     register rt_ubase_t temp;
     struct rt_mq_message *msg;
     rt_uint32_t tick_delta;
 
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
     /* initialize delta tick */
     tick_delta = 0;
     /* get current thread */
@@ -2249,6 +2817,42 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
 
+    *message = msg;
+
+    return RT_EOK;
+}
+
+/**
+ * This function will receive a message from message queue object, if there is
+ * no message in message queue object, the thread shall wait for a specified
+ * time.
+ *
+ * @param mq the message queue object
+ * @param buffer the received message will be saved in
+ * @param size the size of buffer
+ * @param timeout the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_recv(rt_mq_t    mq,
+                    void      *buffer,
+                    rt_size_t  size,
+                    rt_int32_t timeout)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+    rt_err_t result;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    result = _rt_mq_take(mq, &msg, timeout);
+    if (result != RT_EOK)
+        return result;
+
     /* copy message */
     rt_memcpy(buffer, msg + 1, size > mq->msg_size ? mq->msg_size : size);
 
@@ -2266,6 +2870,264 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
 }
 RTM_EXPORT(rt_mq_recv);
 
+/*
+ * link a list of messages to the tail of message queue and wake up the
+ * suspended threads, it's invoked with interrupt disabled. The interrupt will
+ * be enabled when this function returns.
+ */
+static void _rt_mq_link(rt_mq_t               mq,
+                        struct rt_mq_message *first,
+                        struct rt_mq_message *last,
+                        rt_size_t             count,
+                        rt_ubase_t            level)
+{
+    rt_bool_t need_schedule = RT_FALSE;
+
+    /* link msg to message queue */
+    if (mq->msg_queue_tail != RT_NULL)
+    {
+        /* if the tail exists, */
+        ((struct rt_mq_message *)mq->msg_queue_tail)->next = first;
+    }
+
+    /* set new tail */
+    mq->msg_queue_tail = last;
+    /* if the head is empty, set head */
+    if (mq->msg_queue_head == RT_NULL)
+        mq->msg_queue_head = first;
+
+    /* increase message entry */
+    mq->entry += count;
+
+    /* resume suspended threads, one thread for each message */
+    while (count -- && !rt_list_isempty(&mq->parent.suspend_thread))
+    {
+        rt_ipc_list_resume(&(mq->parent.suspend_thread));
+        need_schedule = RT_TRUE;
+    }
+
+#ifdef RT_USING_IPC_WAIT_ANY
+    /* some messages are left after the suspended threads are resumed */
+    if (rt_list_isempty(&mq->parent.suspend_thread) && rt_ipc_waiter_wakeup(&(mq->parent)))
+        need_schedule = RT_TRUE;
+#endif
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    if (need_schedule == RT_TRUE)
+        rt_schedule();
+}
+
+/**
+ * This function will get a free message from message queue object, then the
+ * message can be filled in place and sent by rt_mq_commit.
+ *
+ * @param mq the message queue object
+ *
+ * @return the buffer of message with msg_size bytes, RT_NULL if the message
+ *         queue is full
+ */
+void *rt_mq_reserve(rt_mq_t mq)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* get a free list */
+    msg = (struct rt_mq_message *)mq->msg_queue_free;
+    if (msg != RT_NULL)
+    {
+        /* move free list pointer */
+        mq->msg_queue_free = msg->next;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    if (msg == RT_NULL)
+        return RT_NULL;
+
+    return msg + 1;
+}
+RTM_EXPORT(rt_mq_reserve);
+
+/**
+ * This function will send the message got by rt_mq_reserve to message queue
+ * object, if there are threads suspended on message queue object, it will be
+ * waked up.
+ *
+ * @param mq the message queue object
+ * @param buffer the buffer of message returned by rt_mq_reserve
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_commit(rt_mq_t mq, void *buffer)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    msg = (struct rt_mq_message *)buffer - 1;
+    RT_ASSERT((rt_uint8_t *)msg >= (rt_uint8_t *)mq->msg_pool);
+    RT_ASSERT((rt_uint8_t *)msg < (rt_uint8_t *)mq->msg_pool +
+              mq->max_msgs * (mq->msg_size + sizeof(struct rt_mq_message)));
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    /* the msg is the new tailer of list, the next shall be NULL */
+    msg->next = RT_NULL;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    _rt_mq_link(mq, msg, msg, 1, temp);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_commit);
+
+/**
+ * This function will send a burst of messages to message queue object. The
+ * free messages are got and linked to message queue in one interrupt disabled
+ * section respectively.
+ *
+ * @param mq the message queue object
+ * @param buffer the messages, which are placed one after another
+ * @param size the size of each message
+ * @param count the number of messages
+ *
+ * @return the number of messages sent
+ */
+rt_size_t rt_mq_send_burst(rt_mq_t mq, const void *buffer, rt_size_t size, rt_size_t count)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *first, *last, *msg;
+    rt_size_t index, number;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size || count == 0)
+        return 0;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* take the free messages as many as possible */
+    first = last = (struct rt_mq_message *)mq->msg_queue_free;
+    for (number = 0; number < count && mq->msg_queue_free != RT_NULL; number ++)
+    {
+        last = (struct rt_mq_message *)mq->msg_queue_free;
+        mq->msg_queue_free = last->next;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    if (number == 0)
+        return 0;
+
+    /* copy the messages, they are still linked as in free list */
+    for (index = 0, msg = first; index < number; index ++, msg = msg->next)
+    {
+        rt_memcpy(msg + 1, (const rt_uint8_t *)buffer + index * size, size);
+    }
+    last->next = RT_NULL;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    _rt_mq_link(mq, first, last, number, temp);
+
+    return number;
+}
+RTM_EXPORT(rt_mq_send_burst);
+
+/**
+ * This function will take a message from message queue object without
+ * copying, if there is no message in message queue object, the thread shall
+ * wait for a specified time. The message shall be given back by
+ * rt_mq_release after it's handled.
+ *
+ * @param mq the message queue object
+ * @param buffer the buffer of message with msg_size bytes
+ * @param timeout the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_peek(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t result;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    result = _rt_mq_take(mq, &msg, timeout);
+    if (result != RT_EOK)
+        return result;
+
+    *buffer = msg + 1;
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_peek);
+
+/**
+ * This function will give back the message got by rt_mq_peek, or the message
+ * got by rt_mq_reserve but not sent, to the free list of message queue object.
+ *
+ * @param mq the message queue object
+ * @param buffer the buffer of message
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    msg = (struct rt_mq_message *)buffer - 1;
+    RT_ASSERT((rt_uint8_t *)msg >= (rt_uint8_t *)mq->msg_pool);
+    RT_ASSERT((rt_uint8_t *)msg < (rt_uint8_t *)mq->msg_pool +
+              mq->max_msgs * (mq->msg_size + sizeof(struct rt_mq_message)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    /* put message to free list */
+    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
+    mq->msg_queue_free = msg;
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_release);
+
 /**
  * This function can get or set some extra attributions of a message queue
  * object.
@@ -2326,4 +3188,373 @@ rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg)
 RTM_EXPORT(rt_mq_control);
 #endif /* end of RT_USING_MESSAGEQUEUE */
 
+#ifdef RT_USING_IPC_WAIT_ANY
+/* get the index of the first ready object, it's invoked with interrupt disabled */
+static rt_int32_t _rt_wait_ready(rt_object_t objects[], rt_uint8_t count)
+{
+    rt_int32_t index;
+
+    for (index = 0; index < count; index ++)
+    {
+        switch (rt_object_get_type(objects[index]))
+        {
+#ifdef RT_USING_SEMAPHORE
+        case RT_Object_Class_Semaphore:
+            if (((rt_sem_t)objects[index])->value > 0)
+                return index;
+            break;
+#endif
+#ifdef RT_USING_EVENT
+        case RT_Object_Class_Event:
+            if (((rt_event_t)objects[index])->set != 0)
+                return index;
+            break;
+#endif
+#ifdef RT_USING_MAILBOX
+        case RT_Object_Class_MailBox:
+            if (((rt_mailbox_t)objects[index])->entry > 0)
+                return index;
+            break;
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+        case RT_Object_Class_MessageQueue:
+            if (((rt_mq_t)objects[index])->entry > 0)
+                return index;
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+
+    return -RT_ERROR;
+}
+
+/**
+ * This function will block the current thread on a set of semaphore, event,
+ * mailbox and message queue objects until one of them is ready, that's the
+ * value of semaphore is not zero, any event is set, or there is a message in
+ * mailbox or message queue.
+ *
+ * The ready object is not taken by this function. The thread shall take it
+ * without waiting, such as rt_sem_trytake(sem) or rt_mb_recv(mb, &value, 0),
+ * and wait again if it has been taken by other thread.
+ *
+ * @param objects the array of objects
+ * @param count the number of objects, RT_IPC_WAIT_ANY_MAX at most
+ * @param timeout the waiting time
+ *
+ * @return the index of the first ready object, -RT_ETIMEOUT on timeout,
+ *         or -RT_ERROR if any object is detached or deleted.
+ */
+rt_int32_t rt_wait_any(rt_object_t objects[], rt_uint8_t count, rt_int32_t timeout)
+{
+    struct rt_ipc_waiter waiters[RT_IPC_WAIT_ANY_MAX];
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    rt_uint32_t tick_delta;
+    rt_int32_t index, result;
+    rt_bool_t linked = RT_FALSE;
+
+    /* parameter check */
+    RT_ASSERT(objects != RT_NULL);
+    RT_ASSERT(count > 0 && count <= RT_IPC_WAIT_ANY_MAX);
+
+    thread = rt_thread_self();
+    for (index = 0; index < count; index ++)
+    {
+        RT_ASSERT(objects[index] != RT_NULL);
+        RT_ASSERT(rt_object_get_type(objects[index]) == RT_Object_Class_Semaphore ||
+                  rt_object_get_type(objects[index]) == RT_Object_Class_Event ||
+                  rt_object_get_type(objects[index]) == RT_Object_Class_MailBox ||
+                  rt_object_get_type(objects[index]) == RT_Object_Class_MessageQueue);
+
+        rt_list_init(&(waiters[index].list));
+        waiters[index].thread = thread;
+    }
+
+    /* initialize delta tick */
+    tick_delta = 0;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    while (1)
+    {
+        result = _rt_wait_ready(objects, count);
+        if (result >= 0)
+            break;
+
+        /* no waiting, return with timeout */
+        if (timeout == 0)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+
+        RT_DEBUG_IN_THREAD_CONTEXT;
+
+        /* the waiters are kept in the wait lists of objects until return */
+        if (!linked)
+        {
+            linked = RT_TRUE;
+            for (index = 0; index < count; index ++)
+            {
+                rt_list_insert_before(&(((struct rt_ipc_object *)objects[index])->wait_list),
+                                      &(waiters[index].list));
+#if defined(RT_USING_SEMAPHORE) && defined(RT_USING_IPC_FASTPATH)
+                /* mark the contention, the release goes through slow path */
+                if (rt_object_get_type(objects[index]) == RT_Object_Class_Semaphore)
+                    ((rt_sem_t)objects[index])->reserved = 1;
+#endif
+            }
+        }
+
+        /* reset the thread error number */
+        thread->error = RT_EOK;
+
+        RT_DEBUG_LOG(RT_DEBUG_IPC, ("wait any: suspend thread - %s\n", thread->name));
+
+        rt_thread_suspend(thread);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("set thread:%s to timer list\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* do schedule */
+        rt_schedule();
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /*
+         * the waiter is removed by the object detached or deleted, even if
+         * the thread has been resumed by another object before
+         */
+        for (index = 0; index < count; index ++)
+        {
+            if (rt_list_isempty(&(waiters[index].list)))
+                break;
+        }
+        if (index < count)
+        {
+            result = -RT_ERROR;
+            break;
+        }
+
+        if (thread->error == -RT_ETIMEOUT)
+        {
+            /* check the objects for the last time */
+            timeout = 0;
+        }
+        else if (thread->error != RT_EOK)
+        {
+            result = thread->error;
+            break;
+        }
+        else if (timeout > 0)
+        {
+            /* if it's not waiting forever, calculate the remaining time */
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    /* remove the waiters still linked in the objects */
+    for (index = 0; index < count; index ++)
+    {
+        if (!rt_list_isempty(&(waiters[index].list)))
+            rt_list_remove(&(waiters[index].list));
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return result;
+}
+RTM_EXPORT(rt_wait_any);
+#endif /* end of RT_USING_IPC_WAIT_ANY */
+
 /**@}*/
+
+#ifdef RT_USING_IPC_STATS
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+#include <stdlib.h>
+
+struct ipc_stats_entry
+{
+    char                name[RT_NAME_MAX];
+    rt_uint8_t          type;
+    struct rt_ipc_stats stats;
+};
+
+static struct rt_ipc_stats *ipc_stats_of(struct rt_object *object)
+{
+    rt_uint8_t type = object->type & ~RT_Object_Class_Static;
+
+#ifdef RT_USING_SEMAPHORE
+    if (type == RT_Object_Class_Semaphore)
+        return &(((struct rt_semaphore *)object)->stats);
+#endif
+#ifdef RT_USING_MUTEX
+    if (type == RT_Object_Class_Mutex)
+        return &(((struct rt_mutex *)object)->stats);
+#endif
+
+    return RT_NULL;
+}
+
+/*
+ * collect the statistics of one class of objects into the entries, which are
+ * sorted by the total waiting time, and return the number of entries.
+ */
+static int ipc_stats_collect(enum rt_object_class_type type,
+                             struct ipc_stats_entry *entries, int count, int num,
+                             rt_bool_t reset)
+{
+    struct rt_object_information *information;
+    struct ipc_stats_entry entry;
+    struct rt_ipc_stats *stats;
+    struct rt_list_node *node;
+    struct rt_object *object;
+    register rt_base_t level;
+    int prev;
+
+    information = rt_object_get_information(type);
+    if (information == RT_NULL)
+        return count;
+
+    rt_enter_critical();
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        stats = ipc_stats_of(object);
+        if (stats == RT_NULL)
+            continue;
+
+        level = rt_hw_interrupt_disable();
+        if (reset)
+        {
+            rt_uint32_t hold_start = stats->hold_start;
+
+            rt_memset(stats, 0, sizeof(struct rt_ipc_stats));
+            stats->hold_start = hold_start;
+            rt_hw_interrupt_enable(level);
+            continue;
+        }
+        entry.stats = *stats;
+        rt_hw_interrupt_enable(level);
+
+        if (entry.stats.take == 0 && entry.stats.contended == 0)
+            continue;
+        if (count == num && entries[num - 1].stats.wait_total >= entry.stats.wait_total)
+            continue;
+
+        rt_strncpy(entry.name, object->name, RT_NAME_MAX);
+        entry.type = object->type & ~RT_Object_Class_Static;
+
+        /* insert by the total waiting time */
+        if (count < num)
+            count ++;
+        for (prev = count - 2; prev >= 0 && entries[prev].stats.wait_total < entry.stats.wait_total; prev --)
+            entries[prev + 1] = entries[prev];
+        entries[prev + 1] = entry;
+    }
+    rt_exit_critical();
+
+    return count;
+}
+
+static void ipc_stats_show_time(rt_uint64_t time, float resolution)
+{
+    rt_uint64_t us = (rt_uint64_t)(time * resolution) / 1000;
+
+    rt_kprintf(" %10d", (rt_uint32_t)(us > RT_UINT32_MAX ? RT_UINT32_MAX : us));
+}
+
+static int list_lock_stats(int argc, char **argv)
+{
+    struct ipc_stats_entry *entries;
+    rt_bool_t reset = RT_FALSE;
+    float resolution;
+    int num = 10, count = 0, index;
+
+    if (argc > 1 && rt_strcmp(argv[1], "-r") == 0)
+        reset = RT_TRUE;
+    else if (argc > 1)
+        num = atoi(argv[1]);
+    if (num <= 0)
+    {
+        rt_kprintf("Usage: list_lock_stats [num]  show the top locks by total waiting time\n");
+        rt_kprintf("       list_lock_stats -r     reset the statistics\n");
+        return -RT_EINVAL;
+    }
+
+    entries = (struct ipc_stats_entry *)rt_malloc(num * sizeof(struct ipc_stats_entry));
+    if (entries == RT_NULL)
+    {
+        rt_kprintf("no memory for statistics\n");
+        return -RT_ENOMEM;
+    }
+
+#ifdef RT_USING_SEMAPHORE
+    count = ipc_stats_collect(RT_Object_Class_Semaphore, entries, count, num, reset);
+#endif
+#ifdef RT_USING_MUTEX
+    count = ipc_stats_collect(RT_Object_Class_Mutex, entries, count, num, reset);
+#endif
+    if (reset)
+    {
+        rt_free(entries);
+        return 0;
+    }
+
+    resolution = rt_ipc_stats_clock_getres();
+    rt_kprintf("%-*.s type        take  contended   wait(us)    avg(us)    max(us)   hold(us) contender\n",
+               RT_NAME_MAX, "lock");
+    for (index = 0; index < RT_NAME_MAX; index ++) rt_kprintf("-");
+    rt_kprintf(" ----- ---------- ---------- ---------- ---------- ---------- ---------- ---------\n");
+    for (index = 0; index < count; index ++)
+    {
+        struct rt_ipc_stats *stats = &(entries[index].stats);
+
+        rt_kprintf("%-*.*s %-5s %10d %10d", RT_NAME_MAX, RT_NAME_MAX, entries[index].name,
+                   entries[index].type == RT_Object_Class_Mutex ? "mutex" : "sem",
+                   stats->take, stats->contended);
+        ipc_stats_show_time(stats->wait_total, resolution);
+        ipc_stats_show_time(stats->contended ? stats->wait_total / stats->contended : 0, resolution);
+        ipc_stats_show_time(stats->wait_max, resolution);
+        if (entries[index].type == RT_Object_Class_Mutex)
+            ipc_stats_show_time(stats->hold_max, resolution);
+        else
+            rt_kprintf(" %10s", "-");
+        rt_kprintf(" %.*s\n", RT_NAME_MAX, stats->contender);
+    }
+
+    rt_free(entries);
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_lock_stats, show the top semaphores and mutexes by total waiting time. Usage: list_lock_stats [num|-r]);
+#endif /* RT_USING_FINSH */
+#endif /* RT_USING_IPC_STATS */
@@ -14,6 +14,12 @@
 #include <rthw.h>
 #include <rtthread.h>
 
+#ifdef RT_USING_IRQ_LATENCY
+/* the functions are redirected by macros for measurement */
+#undef rt_interrupt_enter
+#undef rt_interrupt_leave
+#endif
+
 #ifdef RT_USING_HOOK
 
 static void (*rt_interrupt_enter_hook)(void);
@@ -70,6 +76,9 @@ void rt_interrupt_enter(void)
                                 rt_interrupt_nest));
 
     level = rt_hw_interrupt_disable();
+#ifdef RT_USING_CPU_USAGE
+    rt_cpu_usage_account();
+#endif
     rt_interrupt_nest ++;
     RT_OBJECT_HOOK_CALL(rt_interrupt_enter_hook,());
     rt_hw_interrupt_enable(level);
@@ -90,7 +99,15 @@ void rt_interrupt_leave(void)
     RT_DEBUG_LOG(RT_DEBUG_IRQ, ("irq leave, irq nest:%d\n",
                                 rt_interrupt_nest));
 
+#ifdef RT_USING_SOFTIRQ
+    /* run the pending softirqs at the exit of the outermost interrupt */
+    rt_softirq_leave();
+#endif
+
     level = rt_hw_interrupt_disable();
+#ifdef RT_USING_CPU_USAGE
+    rt_cpu_usage_account();
+#endif
     rt_interrupt_nest --;
     RT_OBJECT_HOOK_CALL(rt_interrupt_leave_hook,());
     rt_hw_interrupt_enable(level);
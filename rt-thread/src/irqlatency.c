@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    restart the section disabled from enabled status
+ * 2026-10-17     RT-Thread    add rt_irq_latency_get_func, drop the open section in ISR
+ */
+
+/*
+ * Measurement of interrupt-disabled sections and interrupt service routines.
+ *
+ * The rt_hw_interrupt_disable/enable and rt_interrupt_enter/leave invoked in
+ * C code are redirected to the functions below by the macros in rthw.h and
+ * rtthread.h, with the function name and line of the call site. The time is
+ * taken by the CPU time counter of components/drivers/cputime. For each call
+ * site, the minimal, average and maximal time, and a histogram in the power
+ * of 2 of time are kept.
+ *
+ * An interrupt-disabled section is from the outermost disabling to the
+ * matched enabling, and it's accounted to the call site of disabling. The
+ * time of ISR includes the time of the ISRs nested in it.
+ *
+ * The thread may be switched out in a disabled section, and the next thread
+ * ends the section by its own enabling, or starts with interrupt enabled by
+ * the port directly, which leaves the section open. So the disabling which
+ * returns the status of the outermost one, that's interrupt was enabled
+ * before, always starts a new section out of ISR. The section left open is
+ * dropped on the entry of ISR as well.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h> /* for clock_cpu_getops */
+
+/* the instrumented functions invoke the original ones */
+#undef rt_hw_interrupt_disable
+#undef rt_hw_interrupt_enable
+#undef rt_interrupt_enter
+#undef rt_interrupt_leave
+
+#ifndef RT_IRQ_LATENCY_SITE_NUM
+#define RT_IRQ_LATENCY_SITE_NUM     32
+#endif
+
+#define IRQ_LATENCY_HIST_NUM        32
+#define IRQ_LATENCY_ISR_NEST        8
+
+#define IRQ_LATENCY_TYPE_DISABLE    0
+#define IRQ_LATENCY_TYPE_ISR        1
+
+struct irq_latency_site
+{
+    const char *func;                           /**< the function name of call site */
+    rt_uint16_t line;                           /**< the line of call site, 0 for ISR */
+    rt_uint16_t type;
+
+    rt_uint32_t count;
+    rt_uint32_t min;
+    rt_uint32_t max;
+    rt_uint64_t total;
+
+    rt_uint32_t hist[IRQ_LATENCY_HIST_NUM];     /**< hist[n]: time in [2^n, 2^(n+1)) */
+};
+
+struct irq_latency_stamp
+{
+    const char *func;
+    rt_uint16_t line;
+    rt_uint32_t stamp;
+};
+
+extern volatile rt_uint8_t rt_interrupt_nest;
+
+static struct irq_latency_site _sites[RT_IRQ_LATENCY_SITE_NUM];
+static rt_uint32_t _site_lost;
+
+/* the outermost interrupt-disabled section */
+static rt_uint32_t _disable_nest;
+static rt_base_t _disable_level;
+static struct irq_latency_stamp _disable_stamp;
+
+/* the ISRs which are running */
+static struct irq_latency_stamp _isr_stamp[IRQ_LATENCY_ISR_NEST];
+
+/* the CPU time, it doesn't set errno before the clock is set */
+rt_inline rt_uint32_t irq_latency_time(void)
+{
+    const struct rt_clock_cputime_ops *ops = clock_cpu_getops();
+
+    return ops != RT_NULL ? ops->cputime_gettime() : 0;
+}
+
+/* the index of the highest bit set, 0 for 0 and 1 */
+rt_inline int irq_latency_log2(rt_uint32_t value)
+{
+    int index = 0;
+
+    while (value >>= 1)
+        index ++;
+
+    return index;
+}
+
+/* account the time to the call site, it's invoked with interrupt disabled */
+static void irq_latency_account(struct irq_latency_stamp *stamp, rt_uint16_t type, rt_uint32_t time)
+{
+    struct irq_latency_site *site;
+    rt_uint32_t index, probe;
+
+    index = (((rt_ubase_t)stamp->func >> 2) + stamp->line) % RT_IRQ_LATENCY_SITE_NUM;
+    for (probe = 0; probe < RT_IRQ_LATENCY_SITE_NUM; probe ++)
+    {
+        site = &_sites[index];
+        if (site->func == RT_NULL)
+        {
+            site->func = stamp->func;
+            site->line = stamp->line;
+            site->type = type;
+            site->min  = time;
+            break;
+        }
+        if (site->func == stamp->func && site->line == stamp->line && site->type == type)
+            break;
+
+        index = (index + 1) % RT_IRQ_LATENCY_SITE_NUM;
+    }
+
+    if (probe == RT_IRQ_LATENCY_SITE_NUM)
+    {
+        /* no room for new call site */
+        _site_lost ++;
+        return;
+    }
+
+    site->count ++;
+    site->total += time;
+    if (time < site->min) site->min = time;
+    if (time > site->max) site->max = time;
+    site->hist[irq_latency_log2(time)] ++;
+}
+
+/**
+ * This function will disable interrupt and start the measurement of the
+ * interrupt-disabled section. It's invoked by rt_hw_interrupt_disable().
+ *
+ * @param func the function name of call site
+ * @param line the line of call site
+ *
+ * @return the interrupt status before disabling
+ */
+rt_base_t rt_irq_latency_disable(const char *func, int line)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    /* no thread is switched out in ISR, the nested disabling in ISR may return
+       the same status as the outermost one */
+    if (_disable_nest == 0 || (level == _disable_level && rt_interrupt_nest == 0))
+    {
+        /* the section left open is dropped */
+        _disable_nest  = 0;
+        _disable_level = level;
+        _disable_stamp.func  = func;
+        _disable_stamp.line  = (rt_uint16_t)line;
+        _disable_stamp.stamp = irq_latency_time();
+    }
+    _disable_nest ++;
+
+    return level;
+}
+RTM_EXPORT(rt_irq_latency_disable);
+
+/**
+ * This function will end the measurement of the interrupt-disabled section
+ * and restore the interrupt status. It's invoked by rt_hw_interrupt_enable().
+ *
+ * @param level the interrupt status before disabling
+ */
+void rt_irq_latency_enable(rt_base_t level)
+{
+    rt_uint32_t time;
+
+    /* the section may be entered before measurement, such as in assembly */
+    if (_disable_nest > 0 && -- _disable_nest == 0)
+    {
+        time = irq_latency_time() - _disable_stamp.stamp;
+        irq_latency_account(&_disable_stamp, IRQ_LATENCY_TYPE_DISABLE, time);
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_irq_latency_enable);
+
+/**
+ * This function will enter interrupt and start the measurement of ISR. It's
+ * invoked by rt_interrupt_enter().
+ *
+ * @param func the function name of ISR
+ */
+void rt_irq_latency_isr_enter(const char *func)
+{
+    rt_base_t level;
+    rt_uint8_t nest;
+
+    rt_interrupt_enter();
+
+    level = rt_hw_interrupt_disable();
+    /* the interrupt is taken only when it's enabled, the section still open is
+       left by the thread switched out in it, so the sections in ISR start anew */
+    _disable_nest = 0;
+    nest = rt_interrupt_nest;
+    if (nest > 0 && nest <= IRQ_LATENCY_ISR_NEST)
+    {
+        _isr_stamp[nest - 1].func  = func;
+        _isr_stamp[nest - 1].line  = 0;
+        _isr_stamp[nest - 1].stamp = irq_latency_time();
+    }
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_irq_latency_isr_enter);
+
+/**
+ * This function will end the measurement of ISR and leave interrupt. It's
+ * invoked by rt_interrupt_leave().
+ */
+void rt_irq_latency_isr_leave(void)
+{
+    rt_base_t level;
+    rt_uint8_t nest;
+    rt_uint32_t time;
+
+    level = rt_hw_interrupt_disable();
+    nest = rt_interrupt_nest;
+    if (nest > 0 && nest <= IRQ_LATENCY_ISR_NEST && _isr_stamp[nest - 1].func != RT_NULL)
+    {
+        time = irq_latency_time() - _isr_stamp[nest - 1].stamp;
+        irq_latency_account(&_isr_stamp[nest - 1], IRQ_LATENCY_TYPE_ISR, time);
+        _isr_stamp[nest - 1].func = RT_NULL;
+    }
+    rt_hw_interrupt_enable(level);
+
+    rt_interrupt_leave();
+}
+RTM_EXPORT(rt_irq_latency_isr_leave);
+
+/**
+ * This function will clear the statistics of all call sites.
+ */
+void rt_irq_latency_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(_sites, 0, sizeof(_sites));
+    _site_lost = 0;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_irq_latency_reset);
+
+/**
+ * This function will get the statistics of interrupt-disabled sections or
+ * ISRs of all call sites.
+ *
+ * @param isr RT_TRUE for ISRs, RT_FALSE for interrupt-disabled sections
+ * @param max the maximal time in CPU time tick, RT_NULL for ignore
+ *
+ * @return the number of sections measured
+ */
+rt_uint32_t rt_irq_latency_get(rt_bool_t isr, rt_uint32_t *max)
+{
+    rt_base_t level;
+    rt_uint32_t count = 0, time = 0;
+    int index;
+
+    level = rt_hw_interrupt_disable();
+    for (index = 0; index < RT_IRQ_LATENCY_SITE_NUM; index ++)
+    {
+        if (_sites[index].count == 0 ||
+                _sites[index].type != (isr ? IRQ_LATENCY_TYPE_ISR : IRQ_LATENCY_TYPE_DISABLE))
+            continue;
+
+        count += _sites[index].count;
+        if (_sites[index].max > time)
+            time = _sites[index].max;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (max) *max = time;
+
+    return count;
+}
+RTM_EXPORT(rt_irq_latency_get);
+
+/**
+ * This function will get the statistics of interrupt-disabled sections of
+ * the call sites in a function.
+ *
+ * @param func the function name of call sites
+ * @param max the maximal time in CPU time tick, RT_NULL for ignore
+ *
+ * @return the number of sections measured
+ */
+rt_uint32_t rt_irq_latency_get_func(const char *func, rt_uint32_t *max)
+{
+    rt_base_t level;
+    rt_uint32_t count = 0, time = 0;
+    int index;
+
+    level = rt_hw_interrupt_disable();
+    for (index = 0; index < RT_IRQ_LATENCY_SITE_NUM; index ++)
+    {
+        if (_sites[index].count == 0 || _sites[index].type != IRQ_LATENCY_TYPE_DISABLE ||
+                rt_strcmp(_sites[index].func, func) != 0)
+            continue;
+
+        count += _sites[index].count;
+        if (_sites[index].max > time)
+            time = _sites[index].max;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (max) *max = time;
+
+    return count;
+}
+RTM_EXPORT(rt_irq_latency_get_func);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+#include <stdlib.h>
+
+static void irq_latency_show_time(rt_uint32_t time, float resolution)
+{
+    rt_uint32_t ns = (rt_uint32_t)(time * resolution);
+
+    rt_kprintf(" %6d.%03d", ns / 1000, ns % 1000);
+}
+
+static int irqlatency(int argc, char **argv)
+{
+    struct irq_latency_site *sites;
+    struct irq_latency_site site;
+    rt_base_t level;
+    rt_uint32_t lost;
+    float resolution;
+    int num = 10, count, index, prev, hist;
+
+    if (argc > 1 && rt_strcmp(argv[1], "-r") == 0)
+    {
+        rt_irq_latency_reset();
+        return 0;
+    }
+    if (argc > 1) num = atoi(argv[1]);
+    if (num <= 0)
+    {
+        rt_kprintf("Usage: irqlatency [num]  show the top call sites\n");
+        rt_kprintf("       irqlatency -r     reset the statistics\n");
+        return -RT_EINVAL;
+    }
+
+    sites = (struct irq_latency_site *)rt_malloc(sizeof(_sites));
+    if (sites == RT_NULL)
+    {
+        rt_kprintf("no memory for statistics\n");
+        return -RT_ENOMEM;
+    }
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(sites, _sites, sizeof(_sites));
+    lost = _site_lost;
+    rt_hw_interrupt_enable(level);
+
+    /* sort by the maximal time */
+    count = 0;
+    for (index = 0; index < RT_IRQ_LATENCY_SITE_NUM; index ++)
+    {
+        if (sites[index].count == 0)
+            continue;
+
+        site = sites[index];
+        for (prev = count - 1; prev >= 0 && sites[prev].max < site.max; prev --)
+            sites[prev + 1] = sites[prev];
+        sites[prev + 1] = site;
+        count ++;
+    }
+    if (num > count) num = count;
+
+    resolution = clock_cpu_getres();
+    rt_kprintf("type    count      min(us)    avg(us)    max(us) call site\n");
+    rt_kprintf("---- ---------- ---------- ---------- ---------- ---------\n");
+    for (index = 0; index < num; index ++)
+    {
+        rt_kprintf("%s %10d", sites[index].type == IRQ_LATENCY_TYPE_ISR ? "isr " : "irq-", sites[index].count);
+        irq_latency_show_time(sites[index].min, resolution);
+        irq_latency_show_time((rt_uint32_t)(sites[index].total / sites[index].count), resolution);
+        irq_latency_show_time(sites[index].max, resolution);
+        if (sites[index].line)
+            rt_kprintf(" %s:%d\n", sites[index].func, sites[index].line);
+        else
+            rt_kprintf(" %s\n", sites[index].func);
+
+        /* histogram in the power of 2 of CPU time tick */
+        rt_kprintf("     log2:");
+        for (hist = 0; hist < IRQ_LATENCY_HIST_NUM; hist ++)
+        {
+            if (sites[index].hist[hist])
+                rt_kprintf(" %d:%d", hist, sites[index].hist[hist]);
+        }
+        rt_kprintf("\n");
+    }
+    if (lost)
+        rt_kprintf("%d measurements are lost for no room of call site\n", lost);
+
+    rt_free(sites);
+
+    return 0;
+}
+MSH_CMD_EXPORT(irqlatency, show the top interrupt-disabled sections and ISRs. Usage: irqlatency [num|-r]);
+#endif /* RT_USING_FINSH */
@@ -56,6 +56,17 @@
 #define RT_MEM_STATS
 
 #if defined (RT_USING_HEAP) && defined (RT_USING_SMALL_MEM)
+#ifdef RT_USING_MEMCACHE
+/* the heap works as the backend of the per-thread memory cache */
+#define rt_malloc           rt_heap_malloc
+#define rt_realloc          rt_heap_realloc
+#define rt_calloc           rt_heap_calloc
+#define rt_free             rt_heap_free
+/* the heap interfaces are exported in memcache.c */
+#undef  RTM_EXPORT
+#define RTM_EXPORT(symbol)
+#endif
+
 #ifdef RT_USING_HOOK
 static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
 static void (*rt_free_hook)(void *ptr);
@@ -0,0 +1,578 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ * 2026-10-17     RT-Thread    fix the format of class size in memcache command
+ */
+
+/*
+ * Per-thread cache for small memory blocks.
+ *
+ * The small blocks are kept in magazines (an array of blocks) of the thread
+ * for each size class. Most of allocation and release only push or pop the
+ * magazine of current thread, which needs no lock. When the magazine is empty
+ * or full, it's exchanged with the global depot in a short critical section,
+ * and the depot refills from or flushes to the system heap in batch.
+ *
+ * The system heap (mem.c, slab.c, memheap.c or tlsf.c) works as the backend,
+ * which exports rt_heap_malloc/rt_heap_free/rt_heap_realloc.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined (RT_USING_HEAP) && defined (RT_USING_MEMCACHE)
+
+#ifndef RT_MEMCACHE_CLASS_NUM
+#define RT_MEMCACHE_CLASS_NUM       5
+#endif
+
+#ifndef RT_MEMCACHE_MAGAZINE_SIZE
+#define RT_MEMCACHE_MAGAZINE_SIZE   8
+#endif
+
+#ifndef RT_MEMCACHE_DEPOT_SIZE
+#define RT_MEMCACHE_DEPOT_SIZE      4
+#endif
+
+/* the smallest size class is 16 bytes, and each class doubles the previous */
+#define MEMCACHE_MIN_SHIFT          4
+#define MEMCACHE_CLASS_SIZE(cls)    (1UL << (MEMCACHE_MIN_SHIFT + (cls)))
+#define MEMCACHE_MAX_SIZE           MEMCACHE_CLASS_SIZE(RT_MEMCACHE_CLASS_NUM - 1)
+/* the class index of blocks not cached */
+#define MEMCACHE_CLASS_NONE         RT_MEMCACHE_CLASS_NUM
+
+/* each block has a header to record its size class */
+#define MEMCACHE_HDR_SIZE           RT_ALIGN(sizeof(rt_ubase_t), RT_ALIGN_SIZE)
+#define MEMCACHE_HDR(ptr)           ((rt_ubase_t *)((rt_uint8_t *)(ptr) - MEMCACHE_HDR_SIZE))
+#define MEMCACHE_PTR(block)         ((void *)((rt_uint8_t *)(block) + MEMCACHE_HDR_SIZE))
+
+struct rt_mem_magazine
+{
+    struct rt_mem_magazine *next;                       /**< next magazine in depot */
+    rt_uint32_t count;                                  /**< blocks in magazine */
+    void *blocks[RT_MEMCACHE_MAGAZINE_SIZE];
+};
+
+struct rt_mem_cache
+{
+    struct rt_mem_cache *next;                          /**< next cache to be reclaimed */
+    struct rt_mem_magazine *loaded[RT_MEMCACHE_CLASS_NUM];
+
+    rt_uint32_t hit[RT_MEMCACHE_CLASS_NUM];             /**< served by the magazine of thread */
+    rt_uint32_t miss[RT_MEMCACHE_CLASS_NUM];            /**< magazine is empty or full */
+};
+
+struct rt_mem_depot
+{
+    struct rt_mem_magazine *full;
+    struct rt_mem_magazine *empty;
+    rt_uint32_t full_count;
+
+    rt_uint32_t exchange;                               /**< magazines exchanged with threads */
+    rt_uint32_t refill;                                 /**< blocks allocated from heap */
+    rt_uint32_t flush;                                  /**< blocks released to heap */
+};
+
+static struct rt_mem_depot mem_depot[RT_MEMCACHE_CLASS_NUM];
+/* the caches of exited threads, which are reclaimed in idle thread */
+static struct rt_mem_cache *mem_cache_reclaim_list;
+/* the statistics of the reclaimed caches */
+static rt_uint32_t mem_cache_hit[RT_MEMCACHE_CLASS_NUM];
+static rt_uint32_t mem_cache_miss[RT_MEMCACHE_CLASS_NUM];
+
+rt_inline int _mem_cache_class(rt_size_t size)
+{
+    int cls;
+
+    if (size > MEMCACHE_MAX_SIZE)
+        return MEMCACHE_CLASS_NONE;
+
+    for (cls = 0; MEMCACHE_CLASS_SIZE(cls) < size; cls++);
+
+    return cls;
+}
+
+/* get the cache of current thread, it will be created on the first use */
+static struct rt_mem_cache *_mem_cache_self(void)
+{
+    struct rt_thread *thread;
+    struct rt_mem_cache *cache;
+
+    /* there is no thread context in interrupt */
+    if (rt_interrupt_get_nest() != 0)
+        return RT_NULL;
+
+    thread = rt_thread_self();
+    if (thread == RT_NULL)
+        return RT_NULL;
+
+    cache = (struct rt_mem_cache *)thread->mem_cache;
+    if (cache == RT_NULL)
+    {
+        cache = (struct rt_mem_cache *)rt_heap_malloc(sizeof(struct rt_mem_cache));
+        if (cache != RT_NULL)
+        {
+            rt_memset(cache, 0, sizeof(struct rt_mem_cache));
+            thread->mem_cache = cache;
+        }
+    }
+
+    return cache;
+}
+
+static struct rt_mem_magazine *_mem_magazine_alloc(void)
+{
+    struct rt_mem_magazine *mag;
+
+    mag = (struct rt_mem_magazine *)rt_heap_malloc(sizeof(struct rt_mem_magazine));
+    if (mag != RT_NULL)
+    {
+        mag->next  = RT_NULL;
+        mag->count = 0;
+    }
+
+    return mag;
+}
+
+/* release the blocks in magazine to heap, and keep the first count blocks */
+static void _mem_magazine_flush(struct rt_mem_depot *depot,
+                                struct rt_mem_magazine *mag,
+                                rt_uint32_t count)
+{
+    while (mag->count > count)
+    {
+        rt_heap_free(mag->blocks[--mag->count]);
+        depot->flush ++;
+    }
+}
+
+/* put a full magazine into depot, and get an empty one back */
+static struct rt_mem_magazine *_mem_depot_exchange_full(struct rt_mem_depot *depot,
+                                                        struct rt_mem_magazine *mag)
+{
+    register rt_base_t level;
+    struct rt_mem_magazine *empty = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+    if (depot->full_count < RT_MEMCACHE_DEPOT_SIZE)
+    {
+        mag->next = depot->full;
+        depot->full = mag;
+        depot->full_count ++;
+        depot->exchange ++;
+
+        empty = depot->empty;
+        if (empty != RT_NULL)
+            depot->empty = empty->next;
+        rt_hw_interrupt_enable(level);
+
+        if (empty == RT_NULL)
+            empty = _mem_magazine_alloc();
+    }
+    else
+    {
+        rt_hw_interrupt_enable(level);
+
+        /* the depot is full, give back half of the blocks to heap */
+        _mem_magazine_flush(depot, mag, RT_MEMCACHE_MAGAZINE_SIZE / 2);
+        empty = mag;
+    }
+
+    return empty;
+}
+
+/* put an empty magazine into depot, and get a full one back */
+static struct rt_mem_magazine *_mem_depot_exchange_empty(struct rt_mem_depot *depot,
+                                                         struct rt_mem_magazine *mag,
+                                                         int cls)
+{
+    register rt_base_t level;
+    struct rt_mem_magazine *full;
+    rt_ubase_t *block;
+
+    level = rt_hw_interrupt_disable();
+    full = depot->full;
+    if (full != RT_NULL)
+    {
+        depot->full = full->next;
+        depot->full_count --;
+        depot->exchange ++;
+
+        if (mag != RT_NULL)
+        {
+            mag->next = depot->empty;
+            depot->empty = mag;
+        }
+        rt_hw_interrupt_enable(level);
+
+        return full;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (mag == RT_NULL)
+    {
+        mag = _mem_magazine_alloc();
+        if (mag == RT_NULL)
+            return RT_NULL;
+    }
+
+    /* refill half of the magazine from heap */
+    while (mag->count < RT_MEMCACHE_MAGAZINE_SIZE / 2 + 1)
+    {
+        block = (rt_ubase_t *)rt_heap_malloc(MEMCACHE_CLASS_SIZE(cls) + MEMCACHE_HDR_SIZE);
+        if (block == RT_NULL)
+            break;
+
+        *block = cls;
+        mag->blocks[mag->count++] = block;
+        depot->refill ++;
+    }
+
+    return mag;
+}
+
+static void *_mem_cache_alloc(int cls)
+{
+    struct rt_mem_cache *cache;
+    struct rt_mem_magazine *mag;
+
+    cache = _mem_cache_self();
+    if (cache == RT_NULL)
+        return RT_NULL;
+
+    mag = cache->loaded[cls];
+    if (mag != RT_NULL && mag->count > 0)
+    {
+        cache->hit[cls] ++;
+        return MEMCACHE_PTR(mag->blocks[--mag->count]);
+    }
+
+    cache->miss[cls] ++;
+    mag = _mem_depot_exchange_empty(&mem_depot[cls], mag, cls);
+    cache->loaded[cls] = mag;
+    if (mag == RT_NULL || mag->count == 0)
+        return RT_NULL;
+
+    return MEMCACHE_PTR(mag->blocks[--mag->count]);
+}
+
+static rt_bool_t _mem_cache_free(int cls, void *block)
+{
+    struct rt_mem_cache *cache;
+    struct rt_mem_magazine *mag;
+
+    cache = _mem_cache_self();
+    if (cache == RT_NULL)
+        return RT_FALSE;
+
+    mag = cache->loaded[cls];
+    if (mag != RT_NULL && mag->count < RT_MEMCACHE_MAGAZINE_SIZE)
+    {
+        cache->hit[cls] ++;
+        mag->blocks[mag->count++] = block;
+        return RT_TRUE;
+    }
+
+    cache->miss[cls] ++;
+    if (mag == RT_NULL)
+        mag = _mem_magazine_alloc();
+    else
+        mag = _mem_depot_exchange_full(&mem_depot[cls], mag);
+    cache->loaded[cls] = mag;
+    if (mag == RT_NULL)
+        return RT_FALSE;
+
+    mag->blocks[mag->count++] = block;
+
+    return RT_TRUE;
+}
+
+/**
+ * This function will detach the memory cache from a closed thread. The cache
+ * will be reclaimed later in idle thread.
+ *
+ * @param thread the closed thread
+ */
+void rt_mem_cache_thread_release(rt_thread_t thread)
+{
+    register rt_base_t level;
+    struct rt_mem_cache *cache;
+
+    level = rt_hw_interrupt_disable();
+    cache = (struct rt_mem_cache *)thread->mem_cache;
+    thread->mem_cache = RT_NULL;
+    if (cache != RT_NULL)
+    {
+        cache->next = mem_cache_reclaim_list;
+        mem_cache_reclaim_list = cache;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will give back the magazines of closed threads to depot or
+ * heap. It's invoked in idle thread.
+ */
+void rt_mem_cache_reclaim(void)
+{
+    register rt_base_t level;
+    struct rt_mem_cache *cache;
+    struct rt_mem_magazine *mag;
+    int cls;
+
+    while (mem_cache_reclaim_list != RT_NULL)
+    {
+        level = rt_hw_interrupt_disable();
+        cache = mem_cache_reclaim_list;
+        if (cache != RT_NULL)
+            mem_cache_reclaim_list = cache->next;
+        rt_hw_interrupt_enable(level);
+
+        if (cache == RT_NULL)
+            break;
+
+        for (cls = 0; cls < RT_MEMCACHE_CLASS_NUM; cls++)
+        {
+            mem_cache_hit[cls]  += cache->hit[cls];
+            mem_cache_miss[cls] += cache->miss[cls];
+
+            mag = cache->loaded[cls];
+            if (mag == RT_NULL)
+                continue;
+
+            _mem_magazine_flush(&mem_depot[cls], mag, 0);
+            rt_heap_free(mag);
+        }
+
+        rt_heap_free(cache);
+    }
+}
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * Allocate a block of memory with a minimum of 'size' bytes. The small block
+ * is allocated from the cache of current thread firstly.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_malloc(rt_size_t size)
+{
+    rt_ubase_t *block;
+    void *ptr;
+    int cls;
+
+    if (size == 0)
+        return RT_NULL;
+
+    cls = _mem_cache_class(size);
+    if (cls != MEMCACHE_CLASS_NONE)
+    {
+        ptr = _mem_cache_alloc(cls);
+        if (ptr != RT_NULL)
+            return ptr;
+
+        /* allocate the whole class size to let it be cached later */
+        size = MEMCACHE_CLASS_SIZE(cls);
+    }
+
+    block = (rt_ubase_t *)rt_heap_malloc(size + MEMCACHE_HDR_SIZE);
+    if (block == RT_NULL)
+        return RT_NULL;
+
+    *block = cls;
+
+    return MEMCACHE_PTR(block);
+}
+RTM_EXPORT(rt_malloc);
+
+/**
+ * This function will release the previously allocated memory block by
+ * rt_malloc. The small block is put back to the cache of current thread.
+ *
+ * @param rmem the address of memory which will be released
+ */
+void rt_free(void *rmem)
+{
+    rt_ubase_t *block;
+
+    if (rmem == RT_NULL)
+        return;
+
+    block = MEMCACHE_HDR(rmem);
+    RT_ASSERT(*block <= MEMCACHE_CLASS_NONE);
+
+    if (*block != MEMCACHE_CLASS_NONE && _mem_cache_free(*block, block))
+        return;
+
+    rt_heap_free(block);
+}
+RTM_EXPORT(rt_free);
+
+/**
+ * This function will change the previously allocated memory block.
+ *
+ * @param rmem pointer to memory allocated by rt_malloc
+ * @param newsize the required new size
+ *
+ * @return the changed memory block address
+ */
+void *rt_realloc(void *rmem, rt_size_t newsize)
+{
+    rt_ubase_t *block;
+    rt_size_t size;
+    void *nmem;
+
+    if (rmem == RT_NULL)
+        return rt_malloc(newsize);
+
+    if (newsize == 0)
+    {
+        rt_free(rmem);
+        return RT_NULL;
+    }
+
+    block = MEMCACHE_HDR(rmem);
+    RT_ASSERT(*block <= MEMCACHE_CLASS_NONE);
+
+    if (*block == MEMCACHE_CLASS_NONE && newsize > MEMCACHE_MAX_SIZE)
+    {
+        /* both are large blocks, let the heap do it */
+        block = (rt_ubase_t *)rt_heap_realloc(block, newsize + MEMCACHE_HDR_SIZE);
+        if (block == RT_NULL)
+            return RT_NULL;
+
+        return MEMCACHE_PTR(block);
+    }
+
+    if (*block != MEMCACHE_CLASS_NONE)
+    {
+        size = MEMCACHE_CLASS_SIZE(*block);
+        /* it's still in the same size class */
+        if (newsize <= size && _mem_cache_class(newsize) == *block)
+            return rmem;
+    }
+    else
+    {
+        size = MEMCACHE_MAX_SIZE;
+    }
+
+    nmem = rt_malloc(newsize);
+    if (nmem != RT_NULL)
+    {
+        rt_memcpy(nmem, rmem, size < newsize ? size : newsize);
+        rt_free(rmem);
+    }
+
+    return nmem;
+}
+RTM_EXPORT(rt_realloc);
+
+/**
+ * This function will contiguously allocate enough space for count objects
+ * that are size bytes of memory each and returns a pointer to the allocated
+ * memory.
+ *
+ * The allocated memory is filled with bytes of value zero.
+ *
+ * @param count number of objects to allocate
+ * @param size size of the objects to allocate
+ *
+ * @return pointer to allocated memory / NULL pointer if there is an error
+ */
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    void *p;
+
+    /* allocate 'count' objects of size 'size' */
+    p = rt_malloc(count * size);
+
+    /* zero the memory */
+    if (p)
+        rt_memset(p, 0, count * size);
+
+    return p;
+}
+RTM_EXPORT(rt_calloc);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static int memcache(int argc, char **argv)
+{
+    struct rt_object_information *info;
+    struct rt_thread *thread;
+    struct rt_mem_cache *cache;
+    struct rt_list_node *node;
+    rt_uint32_t hit, miss;
+    int cls;
+
+    rt_kprintf("class  hit        miss       exchange   refill     flush      depot\n");
+    rt_kprintf("------ ---------- ---------- ---------- ---------- ---------- -----\n");
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    for (cls = 0; cls < RT_MEMCACHE_CLASS_NUM; cls++)
+    {
+        hit  = mem_cache_hit[cls];
+        miss = mem_cache_miss[cls];
+
+        rt_enter_critical();
+        for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+        {
+            thread = rt_list_entry(node, struct rt_thread, list);
+            cache = (struct rt_mem_cache *)thread->mem_cache;
+            if (cache != RT_NULL)
+            {
+                hit  += cache->hit[cls];
+                miss += cache->miss[cls];
+            }
+        }
+        rt_exit_critical();
+
+        rt_kprintf("%6d %10d %10d %10d %10d %10d %5d\n", (int)MEMCACHE_CLASS_SIZE(cls), hit, miss,
+                   mem_depot[cls].exchange, mem_depot[cls].refill, mem_depot[cls].flush,
+                   mem_depot[cls].full_count);
+    }
+
+    if (argc > 1 && rt_strcmp(argv[1], "-t") == 0)
+    {
+        rt_kprintf("\n%-*.*s class  hit        miss       cached\n", RT_NAME_MAX, RT_NAME_MAX, "thread");
+        rt_enter_critical();
+        for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+        {
+            thread = rt_list_entry(node, struct rt_thread, list);
+            cache = (struct rt_mem_cache *)thread->mem_cache;
+            if (cache == RT_NULL)
+                continue;
+
+            for (cls = 0; cls < RT_MEMCACHE_CLASS_NUM; cls++)
+            {
+                if (cache->hit[cls] == 0 && cache->miss[cls] == 0)
+                    continue;
+
+                rt_kprintf("%-*.*s %6d %10d %10d %6d\n", RT_NAME_MAX, RT_NAME_MAX, thread->name,
+                           (int)MEMCACHE_CLASS_SIZE(cls), cache->hit[cls], cache->miss[cls],
+                           cache->loaded[cls] ? cache->loaded[cls]->count : 0);
+            }
+        }
+        rt_exit_critical();
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(memcache, show memory cache statistics. Usage: memcache [-t]);
+#endif /* end of RT_USING_FINSH */
+
+#endif /* end of RT_USING_HEAP && RT_USING_MEMCACHE */
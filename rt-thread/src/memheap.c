@@ -113,6 +113,12 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
     /* initialize semaphore lock */
     rt_sem_init(&(memheap->lock), name, 1, RT_IPC_FLAG_FIFO);
 
+#ifdef RT_USING_MEMHEAP_CLASS
+    memheap->heap_class  = RT_MEMHEAP_CLASS_DEFAULT;
+    memheap->alloc_count = 0;
+    memheap->fail_count  = 0;
+#endif
+
     RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
                  ("memory heap: start addr 0x%08x, size %d, free list header 0x%08x\n",
                   start_addr, size, &(memheap->free_header)));
@@ -597,6 +603,52 @@ RTM_EXPORT(rt_memheap_free);
 
 #ifdef RT_USING_MEMHEAP_AS_HEAP
 static struct rt_memheap _heap;
+#ifdef RT_USING_MEMCACHE
+/* the heap works as the backend of the per-thread memory cache */
+#define rt_malloc           rt_heap_malloc
+#define rt_realloc          rt_heap_realloc
+#define rt_calloc           rt_heap_calloc
+#define rt_free             rt_heap_free
+/* the heap interfaces are exported in memcache.c */
+#undef  RTM_EXPORT
+#define RTM_EXPORT(symbol)
+#endif
+
+#ifdef RT_USING_HOOK
+static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
+static void (*rt_free_hook)(void *ptr);
+
+/**
+ * @addtogroup Hook
+ */
+
+/**@{*/
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is allocated from heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
+{
+    rt_malloc_hook = hook;
+}
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is released to heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_free_sethook(void (*hook)(void *ptr))
+{
+    rt_free_hook = hook;
+}
+
+/**@}*/
+
+#endif
 
 void rt_system_heap_init(void *begin_addr, void *end_addr)
 {
@@ -604,13 +656,139 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
     rt_memheap_init(&_heap,
                     "heap",
                     begin_addr,
-                    (rt_uint32_t)end_addr - (rt_uint32_t)begin_addr);
+                    (rt_ubase_t)end_addr - (rt_ubase_t)begin_addr);
+}
+
+#ifdef RT_USING_MEMHEAP_CLASS
+/**
+ * This function will set the placement classes of a memory heap, which are
+ * RT_MEMHEAP_CLASS_DEFAULT when it's initialized.
+ *
+ * @param heap the memory heap object
+ * @param heap_class the mask of RT_MEMHEAP_CLASS_FAST, RT_MEMHEAP_CLASS_DMA
+ *        and RT_MEMHEAP_CLASS_BULK
+ *
+ * @return RT_EOK
+ *
+ * @note a memory heap of only RT_MEMHEAP_CLASS_FAST is not used by rt_malloc,
+ * which shall return DMA-capable memory.
+ */
+rt_err_t rt_memheap_set_class(struct rt_memheap *heap, rt_uint8_t heap_class)
+{
+    RT_ASSERT(heap != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+    RT_ASSERT(heap_class != 0);
+
+    heap->heap_class = heap_class;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_memheap_set_class);
+
+/* allocate on a memory heap and account it */
+static void *_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
+{
+    register rt_base_t level;
+    void *ptr;
+
+    ptr = rt_memheap_alloc(heap, size);
+
+    level = rt_hw_interrupt_disable();
+    if (ptr != RT_NULL)
+        heap->alloc_count ++;
+    else
+        heap->fail_count ++;
+    rt_hw_interrupt_enable(level);
+
+    return ptr;
 }
 
+/* whether the memory heap is the exact classes, or has any of the classes */
+rt_inline rt_bool_t _memheap_match(struct rt_memheap *heap, rt_uint8_t heap_class, rt_bool_t exact)
+{
+    if (exact)
+        return heap->heap_class == heap_class;
+
+    return (heap->heap_class & heap_class) ? RT_TRUE : RT_FALSE;
+}
+
+/* allocate on the matched memory heaps, the system heap is the first to try */
+static void *_memheap_alloc_in(rt_uint8_t heap_class, rt_size_t size, rt_bool_t exact)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_memheap *heap;
+    void *ptr;
+
+    if (_memheap_match(&_heap, heap_class, exact))
+    {
+        ptr = _memheap_alloc(&_heap, size);
+        if (ptr != RT_NULL)
+            return ptr;
+    }
+
+    information = rt_object_get_information(RT_Object_Class_MemHeap);
+    RT_ASSERT(information != RT_NULL);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        heap = (struct rt_memheap *)rt_list_entry(node, struct rt_object, list);
+        RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+
+        /* the system heap has been tried */
+        if (heap == &_heap || !_memheap_match(heap, heap_class, exact))
+            continue;
+
+        ptr = _memheap_alloc(heap, size);
+        if (ptr != RT_NULL)
+            return ptr;
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * This function will allocate a block of memory in the memory heaps of a
+ * placement class. The memory heaps of the exact class are tried first, then
+ * the ones shared with other classes. RT_MEMHEAP_CLASS_FAST is a preference,
+ * which falls back to rt_malloc, while RT_MEMHEAP_CLASS_DMA is a requirement.
+ *
+ * @param heap_class the placement class
+ * @param size the size of memory to be allocated
+ *
+ * @return the allocated memory, RT_NULL on failure. It's released by rt_free.
+ */
+void *rt_malloc_in(rt_uint8_t heap_class, rt_size_t size)
+{
+    void *ptr;
+
+    RT_ASSERT(heap_class != 0);
+
+    ptr = _memheap_alloc_in(heap_class, size, RT_TRUE);
+    if (ptr == RT_NULL)
+        ptr = _memheap_alloc_in(heap_class, size, RT_FALSE);
+    if (ptr == RT_NULL && (heap_class & RT_MEMHEAP_CLASS_FAST))
+        ptr = _memheap_alloc_in(RT_MEMHEAP_CLASS_DEFAULT, size, RT_FALSE);
+
+    if (ptr != RT_NULL)
+    {
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
+    }
+
+    return ptr;
+}
+RTM_EXPORT(rt_malloc_in);
+#endif
+
 void *rt_malloc(rt_size_t size)
 {
     void *ptr;
 
+#ifdef RT_USING_MEMHEAP_CLASS
+    /* the fast memory is only allocated by rt_malloc_in */
+    ptr = _memheap_alloc_in(RT_MEMHEAP_CLASS_DEFAULT, size, RT_FALSE);
+#else
     /* try to allocate in system heap */
     ptr = rt_memheap_alloc(&_heap, size);
     if (ptr == RT_NULL)
@@ -642,6 +820,12 @@ void *rt_malloc(rt_size_t size)
                 break;
         }
     }
+#endif
+
+    if (ptr != RT_NULL)
+    {
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
+    }
 
     return ptr;
 }
@@ -649,6 +833,11 @@ RTM_EXPORT(rt_malloc);
 
 void rt_free(void *rmem)
 {
+    if (rmem == RT_NULL)
+        return;
+
+    RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
+
     rt_memheap_free(rmem);
 }
 RTM_EXPORT(rt_free);
@@ -672,7 +861,13 @@ void *rt_realloc(void *rmem, rt_size_t newsize)
                  ((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE);
 
     new_ptr = rt_memheap_realloc(header_ptr->pool_ptr, rmem, newsize);
-    if (new_ptr == RT_NULL && newsize != 0)
+    if (new_ptr != RT_NULL)
+    {
+        /* the block is resized in the same memheap */
+        RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (new_ptr, newsize));
+    }
+    else if (newsize != 0)
     {
         /* allocate memory block from other memheap */
         new_ptr = rt_malloc(newsize);
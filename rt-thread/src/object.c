@@ -105,6 +105,54 @@ static struct rt_object_information rt_object_container[RT_Object_Info_Unknown]
 #endif
 };
 
+#ifdef RT_USING_OBJECT_HASH
+#if (RT_OBJECT_HASH_SIZE & (RT_OBJECT_HASH_SIZE - 1)) != 0
+#error "RT_OBJECT_HASH_SIZE shall be a power of 2"
+#endif
+
+/* the hash of object name, only the first RT_NAME_MAX characters are used */
+rt_inline rt_uint32_t _rt_object_name_hash(const char *name)
+{
+    rt_uint32_t hash = 0;
+    int index;
+
+    for (index = 0; index < RT_NAME_MAX && name[index] != '\0'; index ++)
+        hash = hash * 31 + (rt_uint8_t)name[index];
+
+    return hash & (RT_OBJECT_HASH_SIZE - 1);
+}
+
+/* insert object into the hash index, it's invoked with interrupt disabled */
+static void _rt_object_hash_insert(struct rt_object_information *information,
+                                   struct rt_object *object)
+{
+    rt_slist_insert(&(information->hash_table[_rt_object_name_hash(object->name)]),
+                    &(object->hash_node));
+}
+
+/* remove object from the hash index, it's invoked with interrupt disabled */
+static void _rt_object_hash_remove(struct rt_object_information *information,
+                                   struct rt_object *object)
+{
+    rt_slist_t *bucket, *node;
+    int index;
+
+    bucket = &(information->hash_table[_rt_object_name_hash(object->name)]);
+    for (node = bucket; node->next != RT_NULL; node = node->next)
+    {
+        if (node->next == &(object->hash_node))
+        {
+            node->next = object->hash_node.next;
+            return;
+        }
+    }
+
+    /* the object name is changed after initialization, search all buckets */
+    for (index = 0; index < RT_OBJECT_HASH_SIZE; index ++)
+        rt_slist_remove(&(information->hash_table[index]), &(object->hash_node));
+}
+#endif
+
 #ifdef RT_USING_HOOK
 static void (*rt_object_attach_hook)(struct rt_object *object);
 static void (*rt_object_detach_hook)(struct rt_object *object);
@@ -292,6 +340,9 @@ void rt_object_init(struct rt_object         *object,
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        _rt_object_hash_insert(information, object);
+#endif
     }
 
     /* unlock interrupt */
@@ -307,12 +358,20 @@ void rt_object_init(struct rt_object         *object,
 void rt_object_detach(rt_object_t object)
 {
     register rt_base_t temp;
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object_information *information;
+#endif
 
     /* object check */
     RT_ASSERT(object != RT_NULL);
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
+#ifdef RT_USING_OBJECT_HASH
+    information = rt_object_get_information((enum rt_object_class_type)
+                                            rt_object_get_type(object));
+#endif
+
     /* reset object type */
     object->type = 0;
 
@@ -321,6 +380,10 @@ void rt_object_detach(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    if (information != RT_NULL)
+        _rt_object_hash_remove(information, object);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -387,6 +450,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        _rt_object_hash_insert(information, object);
+#endif
     }
 
     /* unlock interrupt */
@@ -404,6 +470,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
 void rt_object_delete(rt_object_t object)
 {
     register rt_base_t temp;
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object_information *information;
+#endif
 
     /* object check */
     RT_ASSERT(object != RT_NULL);
@@ -411,6 +480,11 @@ void rt_object_delete(rt_object_t object)
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
+#ifdef RT_USING_OBJECT_HASH
+    information = rt_object_get_information((enum rt_object_class_type)
+                                            rt_object_get_type(object));
+#endif
+
     /* reset object type */
     object->type = 0;
 
@@ -419,6 +493,10 @@ void rt_object_delete(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    if (information != RT_NULL)
+        _rt_object_hash_remove(information, object);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -479,7 +557,9 @@ rt_uint8_t rt_object_get_type(rt_object_t object)
 rt_object_t rt_object_find(const char *name, rt_uint8_t type)
 {
     struct rt_object *object = RT_NULL;
+#ifndef RT_USING_OBJECT_HASH
     struct rt_list_node *node = RT_NULL;
+#endif
     struct rt_object_information *information = RT_NULL;
 
     /* parameter check */
@@ -498,6 +578,14 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
         information = rt_object_get_information((enum rt_object_class_type)type);
         RT_ASSERT(information != RT_NULL);
     }
+#ifdef RT_USING_OBJECT_HASH
+    object = rt_object_hash_find(information, name);
+
+    /* leave critical */
+    rt_exit_critical();
+
+    return object;
+#else
     for (node  = information->object_list.next;
             node != &(information->object_list);
             node  = node->next)
@@ -515,7 +603,40 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     /* leave critical */
     rt_exit_critical();
 
+    return RT_NULL;
+#endif
+}
+
+#ifdef RT_USING_OBJECT_HASH
+/**
+ * This function will find specified name object in the name hash index of
+ * object container.
+ *
+ * @param information the object container
+ * @param name the specified name of object.
+ *
+ * @return the found object or RT_NULL if there is no this object
+ * in object container.
+ *
+ * @note the scheduler shall be locked by caller.
+ */
+rt_object_t rt_object_hash_find(struct rt_object_information *information,
+                                const char *name)
+{
+    struct rt_object *object;
+    rt_slist_t *node;
+
+    for (node  = information->hash_table[_rt_object_name_hash(name)].next;
+         node != RT_NULL;
+         node  = node->next)
+    {
+        object = rt_slist_entry(node, struct rt_object, hash_node);
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+            return object;
+    }
+
     return RT_NULL;
 }
+#endif
 
 /**@}*/
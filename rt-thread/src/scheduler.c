@@ -253,6 +253,10 @@ void rt_system_scheduler_start(void)
 #ifdef RT_USING_SMP
     to_thread->oncpu = rt_hw_cpu_id();
 #else
+#ifdef RT_USING_CPU_USAGE
+    /* the time before scheduler starts is not charged to any thread */
+    rt_cpu_usage_account();
+#endif
     rt_current_thread = to_thread;
 #endif /*RT_USING_SMP*/
 
@@ -446,6 +450,9 @@ void rt_schedule(void)
                 /* if the destination thread is not the same as current thread */
                 rt_current_priority = (rt_uint8_t)highest_ready_priority;
                 from_thread         = rt_current_thread;
+#ifdef RT_USING_CPU_USAGE
+                rt_cpu_usage_account();
+#endif
                 rt_current_thread   = to_thread;
 
                 RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (from_thread, to_thread));
@@ -58,6 +58,17 @@
 #define RT_MEM_STATS
 
 #if defined (RT_USING_HEAP) && defined (RT_USING_SLAB)
+#ifdef RT_USING_MEMCACHE
+/* the heap works as the backend of the per-thread memory cache */
+#define rt_malloc           rt_heap_malloc
+#define rt_realloc          rt_heap_realloc
+#define rt_calloc           rt_heap_calloc
+#define rt_free             rt_heap_free
+/* the heap interfaces are exported in memcache.c */
+#undef  RTM_EXPORT
+#define RTM_EXPORT(symbol)
+#endif
+
 /* some statistical variable */
 #ifdef RT_MEM_STATS
 static rt_size_t used_mem, max_mem;
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Softirq, the deferred work of interrupt.
+ *
+ * An ISR raises the pending bit of a softirq, and the handlers of pending
+ * softirqs run in batches at the exit of the outermost interrupt, with the
+ * interrupt status of rt_interrupt_leave. A softirq which is raised again
+ * and again during the exit runs at most `budget` times, then it is deferred
+ * to the softirq thread with the pending softirqs left after the maximal
+ * batches. The softirq raised in thread context runs in the softirq thread.
+ *
+ * The handlers of softirq never run concurrently, and the lower number runs
+ * first in a batch.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifndef RT_SOFTIRQ_NUM
+#define RT_SOFTIRQ_NUM                  8
+#endif
+#ifndef RT_SOFTIRQ_RESTART
+#define RT_SOFTIRQ_RESTART              4
+#endif
+#ifndef RT_SOFTIRQ_THREAD_PRIORITY
+#define RT_SOFTIRQ_THREAD_PRIORITY      1
+#endif
+#ifndef RT_SOFTIRQ_THREAD_STACK_SIZE
+#define RT_SOFTIRQ_THREAD_STACK_SIZE    1024
+#endif
+
+struct rt_softirq_action
+{
+    const char *name;
+    void (*handler)(void *parameter);
+    void *parameter;
+
+    rt_uint16_t budget;                         /**< the maximal runs in a batch */
+    rt_uint16_t runs;                           /**< the runs in current batch */
+    rt_uint32_t count;                          /**< the total runs */
+    rt_uint32_t deferred;                       /**< the times deferred to softirq thread */
+};
+
+extern volatile rt_uint8_t rt_interrupt_nest;
+
+static struct rt_softirq_action _softirq_action[RT_SOFTIRQ_NUM];
+static volatile rt_uint32_t _softirq_pending;
+static rt_uint8_t _softirq_running;
+
+static struct rt_semaphore _softirq_sem;
+static struct rt_thread _softirq_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _softirq_thread_stack[RT_SOFTIRQ_THREAD_STACK_SIZE];
+
+/* wake up the softirq thread, it's invoked with interrupt disabled */
+rt_inline void _softirq_wakeup(void)
+{
+    /* the thread runs all of pending softirqs once it's waked up */
+    if (_softirq_sem.value == 0)
+        rt_sem_release(&_softirq_sem);
+}
+
+/**
+ * This function will run the pending softirqs in batches.
+ *
+ * @param restart the maximal batches
+ *
+ * @return the pending softirqs left to the softirq thread
+ */
+static rt_uint32_t _softirq_run(int restart)
+{
+    struct rt_softirq_action *action;
+    register rt_base_t level;
+    rt_uint32_t pending, deferred;
+    int nr;
+
+    level = rt_hw_interrupt_disable();
+    if (_softirq_running)
+    {
+        /* the softirq thread is running, it will pick up the pending ones */
+        rt_hw_interrupt_enable(level);
+
+        return 0;
+    }
+    _softirq_running = 1;
+
+    deferred = 0;
+    while (restart -- > 0)
+    {
+        pending = _softirq_pending & ~deferred;
+        if (pending == 0)
+            break;
+
+        _softirq_pending &= ~pending;
+        rt_hw_interrupt_enable(level);
+
+        while (pending)
+        {
+            nr = __rt_ffs(pending) - 1;
+            pending &= ~(1UL << nr);
+
+            action = &_softirq_action[nr];
+            if (action->handler != RT_NULL)
+            {
+                action->handler(action->parameter);
+                action->runs ++;
+                action->count ++;
+            }
+        }
+
+        level = rt_hw_interrupt_disable();
+
+        /* defer the softirq which runs out of its budget */
+        pending = _softirq_pending & ~deferred;
+        for (nr = 0; nr < RT_SOFTIRQ_NUM; nr ++)
+        {
+            action = &_softirq_action[nr];
+            if ((pending & (1UL << nr)) && action->runs >= action->budget)
+            {
+                deferred |= 1UL << nr;
+                action->deferred ++;
+            }
+        }
+    }
+
+    for (nr = 0; nr < RT_SOFTIRQ_NUM; nr ++)
+        _softirq_action[nr].runs = 0;
+
+    pending = _softirq_pending;
+    _softirq_running = 0;
+    rt_hw_interrupt_enable(level);
+
+    return pending;
+}
+
+static void _softirq_thread_entry(void *parameter)
+{
+    while (1)
+    {
+        rt_sem_take(&_softirq_sem, RT_WAITING_FOREVER);
+
+        while (_softirq_run(RT_SOFTIRQ_RESTART) != 0);
+    }
+}
+
+/**
+ * This function will register the handler of a softirq.
+ *
+ * @param nr the number of softirq, the lower number runs first
+ * @param name the name of softirq
+ * @param handler the handler of softirq
+ * @param parameter the parameter of handler
+ * @param budget the maximal runs in a batch, then it's deferred to the
+ *        softirq thread. 0 for 1.
+ *
+ * @return RT_EOK on successful, -RT_EBUSY if the softirq has been registered.
+ */
+rt_err_t rt_softirq_register(rt_uint8_t nr, const char *name,
+                             void (*handler)(void *parameter), void *parameter,
+                             rt_uint16_t budget)
+{
+    struct rt_softirq_action *action;
+    register rt_base_t level;
+
+    RT_ASSERT(nr < RT_SOFTIRQ_NUM);
+    RT_ASSERT(handler != RT_NULL);
+
+    action = &_softirq_action[nr];
+
+    level = rt_hw_interrupt_disable();
+    if (action->handler != RT_NULL)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_EBUSY;
+    }
+
+    action->name      = name;
+    action->parameter = parameter;
+    action->budget    = budget ? budget : 1;
+    action->runs      = 0;
+    action->count     = 0;
+    action->deferred  = 0;
+    action->handler   = handler;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_softirq_register);
+
+/**
+ * This function will unregister the handler of a softirq. The handler may be
+ * running if it's invoked in other thread.
+ *
+ * @param nr the number of softirq
+ */
+void rt_softirq_unregister(rt_uint8_t nr)
+{
+    register rt_base_t level;
+
+    RT_ASSERT(nr < RT_SOFTIRQ_NUM);
+
+    level = rt_hw_interrupt_disable();
+    _softirq_pending &= ~(1UL << nr);
+    _softirq_action[nr].handler = RT_NULL;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_softirq_unregister);
+
+/**
+ * This function will raise a softirq. It can be invoked in ISR, and the
+ * handler runs at the exit of interrupt, or in the softirq thread if it's
+ * invoked in thread.
+ *
+ * @param nr the number of softirq
+ */
+void rt_softirq_raise(rt_uint8_t nr)
+{
+    register rt_base_t level;
+
+    RT_ASSERT(nr < RT_SOFTIRQ_NUM);
+
+    level = rt_hw_interrupt_disable();
+    _softirq_pending |= 1UL << nr;
+    if (rt_interrupt_nest == 0)
+        _softirq_wakeup();
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_softirq_raise);
+
+/**
+ * This function will run the pending softirqs at the exit of the outermost
+ * interrupt.
+ *
+ * @note please don't invoke this routine in application, it's invoked by
+ *       rt_interrupt_leave.
+ */
+void rt_softirq_leave(void)
+{
+    register rt_base_t level;
+    rt_uint32_t pending;
+
+    if (rt_interrupt_nest != 1 || _softirq_pending == 0)
+        return;
+
+#ifdef RT_SOFTIRQ_IN_INTERRUPT
+    pending = _softirq_run(RT_SOFTIRQ_RESTART);
+#else
+    pending = _softirq_pending;
+#endif
+
+    if (pending)
+    {
+        level = rt_hw_interrupt_disable();
+        _softirq_wakeup();
+        rt_hw_interrupt_enable(level);
+    }
+}
+
+/**
+ * @ingroup SystemInit
+ *
+ * This function will initialize the softirq thread
+ */
+void rt_system_softirq_init(void)
+{
+    rt_sem_init(&_softirq_sem, "softirq", 0, RT_IPC_FLAG_FIFO);
+
+    rt_thread_init(&_softirq_thread,
+                   "softirq",
+                   _softirq_thread_entry,
+                   RT_NULL,
+                   &_softirq_thread_stack[0],
+                   sizeof(_softirq_thread_stack),
+                   RT_SOFTIRQ_THREAD_PRIORITY,
+                   10);
+
+    rt_thread_startup(&_softirq_thread);
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static int list_softirq(void)
+{
+    struct rt_softirq_action *action;
+    rt_uint32_t pending = _softirq_pending;
+    int nr;
+
+    rt_kprintf(" nr %-*.*s pending budget   count    deferred\n", RT_NAME_MAX, RT_NAME_MAX, "softirq");
+    rt_kprintf(" -- ");
+    for (nr = 0; nr < RT_NAME_MAX; nr ++) rt_kprintf("-");
+    rt_kprintf(" ------- ------ ---------- ----------\n");
+    for (nr = 0; nr < RT_SOFTIRQ_NUM; nr ++)
+    {
+        action = &_softirq_action[nr];
+        if (action->handler == RT_NULL)
+            continue;
+
+        rt_kprintf(" %2d %-*.*s %-7s %6d %10d %10d\n", nr, RT_NAME_MAX, RT_NAME_MAX,
+                   action->name ? action->name : "",
+                   (pending & (1UL << nr)) ? "yes" : "no",
+                   action->budget, action->count, action->deferred);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_softirq, list softirq in system);
+#endif /* RT_USING_FINSH */
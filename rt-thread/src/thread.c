@@ -26,6 +26,7 @@
  *                             bug when thread has not startup.
  * 2018-11-22     Jesven       yield is same to rt_schedule
  *                             add support for tasks bound to cpu
+ * 2026-10-17     RT-Thread    skip the whole periods passed in delay until.
  */
 
 #include <rthw.h>
@@ -96,6 +97,11 @@ void rt_thread_exit(void)
     /* remove it from timer list */
     rt_timer_detach(&thread->thread_timer);
 
+#ifdef RT_USING_MEMCACHE
+    /* give back the cached memory blocks */
+    rt_mem_cache_thread_release(thread);
+#endif
+
     if ((rt_object_is_systemobject((rt_object_t)thread) == RT_TRUE) &&
         thread->cleanup == RT_NULL)
     {
@@ -178,6 +184,18 @@ static rt_err_t _rt_thread_init(struct rt_thread *thread,
     thread->cleanup   = 0;
     thread->user_data = 0;
 
+#ifdef RT_USING_MEMCACHE
+    thread->mem_cache = RT_NULL;
+#endif
+
+#ifdef RT_USING_CPU_USAGE
+    thread->cpu_time  = 0;
+#endif
+
+#ifdef RT_USING_PERIODIC_THREAD
+    rt_memset(&(thread->periodic), 0, sizeof(thread->periodic));
+#endif
+
     /* init thread timer */
     rt_timer_init(&(thread->thread_timer),
                   thread->name,
@@ -346,6 +364,11 @@ rt_err_t rt_thread_detach(rt_thread_t thread)
     /* release thread timer */
     rt_timer_detach(&(thread->thread_timer));
 
+#ifdef RT_USING_MEMCACHE
+    /* give back the cached memory blocks */
+    rt_mem_cache_thread_release(thread);
+#endif
+
     /* change stat */
     thread->stat = RT_THREAD_CLOSE;
 
@@ -445,6 +468,11 @@ rt_err_t rt_thread_delete(rt_thread_t thread)
     /* release thread timer */
     rt_timer_detach(&(thread->thread_timer));
 
+#ifdef RT_USING_MEMCACHE
+    /* give back the cached memory blocks */
+    rt_mem_cache_thread_release(thread);
+#endif
+
     /* change stat */
     thread->stat = RT_THREAD_CLOSE;
 
@@ -477,6 +505,29 @@ rt_err_t rt_thread_yield(void)
 }
 RTM_EXPORT(rt_thread_yield);
 
+/*
+ * suspend current thread for some ticks, it's invoked with interrupt
+ * disabled and the interrupt is restored to level.
+ */
+static void _rt_thread_sleep_locked(struct rt_thread *thread, rt_tick_t tick, rt_base_t level)
+{
+    /* suspend thread */
+    rt_thread_suspend(thread);
+
+    /* reset the timeout of thread timer and start it */
+    rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &tick);
+    rt_timer_start(&(thread->thread_timer));
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    rt_schedule();
+
+    /* clear error number of this thread to RT_EOK */
+    if (thread->error == -RT_ETIMEOUT)
+        thread->error = RT_EOK;
+}
+
 /**
  * This function will let current thread sleep for some ticks.
  *
@@ -497,24 +548,73 @@ rt_err_t rt_thread_sleep(rt_tick_t tick)
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
-    /* suspend thread */
-    rt_thread_suspend(thread);
+    _rt_thread_sleep_locked(thread, tick, temp);
 
-    /* reset the timeout of thread timer and start it */
-    rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &tick);
-    rt_timer_start(&(thread->thread_timer));
+    return RT_EOK;
+}
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(temp);
+/**
+ * This function will let current thread delay until (*tick + inc_tick).
+ * The wake up tick is absolute, so the delay doesn't drift with the time
+ * consumed between two invocations. If the wake up tick has passed, the
+ * thread returns at once, and the whole periods of inc_tick passed are
+ * skipped, so the following wake up ticks stay in phase. The periods skipped
+ * are counted as missed jobs of a periodic thread.
+ *
+ * @param tick the tick of last wake up, it's updated to the tick of this
+ *        wake up
+ * @param inc_tick the increment tick
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_thread_delay_until(rt_tick_t *tick, rt_tick_t inc_tick)
+{
+    register rt_base_t level;
+    struct rt_thread *thread;
+    rt_tick_t cur_tick;
 
-    rt_schedule();
+    RT_ASSERT(tick != RT_NULL);
 
-    /* clear error number of this thread to RT_EOK */
-    if (thread->error == -RT_ETIMEOUT)
-        thread->error = RT_EOK;
+    /* set to current thread */
+    thread = rt_thread_self();
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(rt_object_get_type((rt_object_t)thread) == RT_Object_Class_Thread);
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    cur_tick = rt_tick_get();
+    if (cur_tick - *tick < inc_tick)
+    {
+        rt_tick_t left_tick;
+
+        left_tick = *tick + inc_tick - cur_tick;
+        *tick += inc_tick;
+
+        _rt_thread_sleep_locked(thread, left_tick, level);
+    }
+    else
+    {
+        rt_tick_t skipped = 0;
+
+        /* the wake up tick has passed, skip the whole periods passed */
+        *tick += inc_tick;
+        if (inc_tick != 0)
+        {
+            skipped = (cur_tick - *tick) / inc_tick;
+            *tick += skipped * inc_tick;
+        }
+#ifdef RT_USING_PERIODIC_THREAD
+        thread->periodic.missed += skipped;
+#endif
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+    }
 
     return RT_EOK;
 }
+RTM_EXPORT(rt_thread_delay_until);
 
 /**
  * This function will let current thread delay for some ticks.
@@ -546,6 +646,199 @@ rt_err_t rt_thread_mdelay(rt_int32_t ms)
 }
 RTM_EXPORT(rt_thread_mdelay);
 
+#ifdef RT_USING_PERIODIC_THREAD
+/**
+ * This function will make a thread periodic. The first job is released at
+ * the invocation, and the following jobs are released at the absolute ticks
+ * of one period after another, which are waited by rt_thread_wait_period.
+ * The statistics of thread are reset.
+ *
+ * @param thread the thread to be periodic
+ * @param period the period in tick, 0 to make the thread non-periodic
+ * @param deadline the relative deadline in tick, 0 for the period
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_thread_set_periodic(rt_thread_t thread, rt_tick_t period, rt_tick_t deadline)
+{
+    struct rt_thread_periodic *periodic;
+    register rt_base_t level;
+
+    /* thread check */
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(rt_object_get_type((rt_object_t)thread) == RT_Object_Class_Thread);
+
+    periodic = &(thread->periodic);
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(periodic, 0, sizeof(struct rt_thread_periodic));
+    if (period != 0)
+    {
+        periodic->period   = period;
+        periodic->deadline = deadline ? deadline : period;
+        periodic->release  = rt_tick_get();
+    }
+    rt_hw_interrupt_enable(level);
+
+#ifdef RT_USING_CPU_USAGE
+    periodic->exec_start = rt_thread_cpu_time(thread);
+#endif
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_thread_set_periodic);
+
+/**
+ * This function will complete the current job of a periodic thread, and let
+ * it delay until the release of next job.
+ *
+ * The response time of the job is accounted from its release tick, and the
+ * job misses its deadline if the response time is longer than the deadline.
+ * If the next release has passed, the thread returns at once as a late
+ * release, and the whole periods passed are skipped as missed jobs.
+ *
+ * @return RT_EOK on OK, -RT_ERROR if current thread isn't periodic
+ */
+rt_err_t rt_thread_wait_period(void)
+{
+    struct rt_thread_periodic *periodic;
+    register rt_base_t level;
+    struct rt_thread *thread;
+    rt_tick_t cur_tick, next_tick, response;
+
+    /* set to current thread */
+    thread = rt_thread_self();
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(rt_object_get_type((rt_object_t)thread) == RT_Object_Class_Thread);
+
+    periodic = &(thread->periodic);
+    if (periodic->period == 0)
+        return -RT_ERROR;
+
+#ifdef RT_USING_CPU_USAGE
+    {
+        rt_uint64_t exec;
+
+        exec = rt_thread_cpu_time(thread) - periodic->exec_start;
+        if (exec > periodic->wcet)
+            periodic->wcet = exec > RT_UINT32_MAX ? RT_UINT32_MAX : (rt_uint32_t)exec;
+    }
+#endif
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    cur_tick = rt_tick_get();
+    response = cur_tick - periodic->release;
+
+    periodic->jobs ++;
+    if (response > periodic->wcrt)
+        periodic->wcrt = response;
+    if (response > periodic->deadline)
+        periodic->missed ++;
+
+    next_tick = periodic->release + periodic->period;
+    if (cur_tick - periodic->release < periodic->period)
+    {
+        periodic->release = next_tick;
+
+        _rt_thread_sleep_locked(thread, next_tick - cur_tick, level);
+    }
+    else
+    {
+        rt_tick_t skipped;
+
+        if (cur_tick != next_tick)
+            periodic->late ++;
+
+        /* skip the whole periods passed, release the latest one */
+        skipped = (cur_tick - next_tick) / periodic->period;
+        periodic->missed += skipped;
+        periodic->release = next_tick + skipped * periodic->period;
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+    }
+
+#ifdef RT_USING_CPU_USAGE
+    periodic->exec_start = rt_thread_cpu_time(thread);
+#endif
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_thread_wait_period);
+
+/**
+ * This function will assign the priorities of periodic threads in
+ * rate-monotonic order, the shorter period gets the higher priority, and the
+ * threads with the same period get the same priority.
+ *
+ * @param highest the priority of the periodic threads with the shortest period
+ *
+ * @return the number of periodic threads assigned
+ *
+ * @note the priority is clamped above the idle thread, and the priority
+ * inherited from a mutex is overridden.
+ */
+int rt_thread_periodic_assign_priority(rt_uint8_t highest)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_thread *thread;
+    rt_tick_t last, period;
+    rt_uint8_t priority;
+    int count;
+
+    RT_ASSERT(highest < RT_THREAD_PRIORITY_MAX - 1);
+
+    information = rt_object_get_information(RT_Object_Class_Thread);
+    RT_ASSERT(information != RT_NULL);
+
+    count    = 0;
+    last     = 0;
+    priority = highest;
+
+    rt_enter_critical();
+    while (1)
+    {
+        /* find the shortest period after last one */
+        period = 0;
+        for (node  = information->object_list.next;
+             node != &(information->object_list);
+             node  = node->next)
+        {
+            thread = rt_list_entry(node, struct rt_thread, list);
+            if (thread->periodic.period > last &&
+                (period == 0 || thread->periodic.period < period))
+                period = thread->periodic.period;
+        }
+        if (period == 0)
+            break;
+
+        for (node  = information->object_list.next;
+             node != &(information->object_list);
+             node  = node->next)
+        {
+            thread = rt_list_entry(node, struct rt_thread, list);
+            if (thread->periodic.period == period)
+            {
+                thread->init_priority = priority;
+                rt_thread_control(thread, RT_THREAD_CTRL_CHANGE_PRIORITY, &priority);
+                count ++;
+            }
+        }
+
+        last = period;
+        if (priority < RT_THREAD_PRIORITY_MAX - 2)
+            priority ++;
+    }
+    rt_exit_critical();
+
+    return count;
+}
+RTM_EXPORT(rt_thread_periodic_assign_priority);
+#endif /* RT_USING_PERIODIC_THREAD */
+
 /**
  * This function will control thread behaviors according to control command.
  *
@@ -784,7 +1077,9 @@ rt_thread_t rt_thread_find(char *name)
 {
     struct rt_object_information *information;
     struct rt_object *object;
+#ifndef RT_USING_OBJECT_HASH
     struct rt_list_node *node;
+#endif
 
     /* enter critical */
     if (rt_thread_self() != RT_NULL)
@@ -793,6 +1088,15 @@ rt_thread_t rt_thread_find(char *name)
     /* try to find device object */
     information = rt_object_get_information(RT_Object_Class_Thread);
     RT_ASSERT(information != RT_NULL);
+#ifdef RT_USING_OBJECT_HASH
+    object = rt_object_hash_find(information, name);
+
+    /* leave critical */
+    if (rt_thread_self() != RT_NULL)
+        rt_exit_critical();
+
+    return (rt_thread_t)object;
+#else
     for (node  = information->object_list.next;
          node != &(information->object_list);
          node  = node->next)
@@ -814,6 +1118,7 @@ rt_thread_t rt_thread_find(char *name)
 
     /* not found */
     return RT_NULL;
+#endif
 }
 RTM_EXPORT(rt_thread_find);
 
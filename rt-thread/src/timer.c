@@ -21,8 +21,39 @@
 #include <rtthread.h>
 #include <rthw.h>
 
+#ifdef RT_USING_TIMER_WHEEL
+#ifndef RT_TIMER_WHEEL_BITS
+#define RT_TIMER_WHEEL_BITS            4
+#endif
+
+#if (RT_TIMER_WHEEL_BITS > 5) || (32 % RT_TIMER_WHEEL_BITS)
+#error "RT_TIMER_WHEEL_BITS must be a divisor of 32 and less than 6"
+#endif
+
+#define RT_TIMER_WHEEL_SIZE            (1UL << RT_TIMER_WHEEL_BITS)
+#define RT_TIMER_WHEEL_MASK            (RT_TIMER_WHEEL_SIZE - 1)
+#define RT_TIMER_WHEEL_FULL            (0xFFFFFFFFUL >> (32 - RT_TIMER_WHEEL_SIZE))
+#define RT_TIMER_WHEEL_LEVEL           (32 / RT_TIMER_WHEEL_BITS)
+
+/*
+ * Hierarchical timing wheel. The level 0 has one slot per tick, each slot of
+ * level n covers RT_TIMER_WHEEL_SIZE slots of level n - 1. The timers in a
+ * higher level slot are cascaded into the lower levels when the wheel reaches
+ * the beginning of that slot.
+ */
+struct rt_timer_wheel
+{
+    rt_tick_t   cur_tick;                           /* the next tick to be processed */
+    rt_uint32_t bitmap[RT_TIMER_WHEEL_LEVEL];       /* slots may be not empty */
+    rt_list_t   slot[RT_TIMER_WHEEL_LEVEL][RT_TIMER_WHEEL_SIZE];
+};
+
+/* hard timer wheel */
+static struct rt_timer_wheel rt_timer_wheel;
+#else
 /* hard timer list */
 static rt_list_t rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif
 
 #ifdef RT_USING_TIMER_SOFT
 #ifndef RT_TIMER_THREAD_STACK_SIZE
@@ -33,8 +64,13 @@ static rt_list_t rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 #define RT_TIMER_THREAD_PRIO           0
 #endif
 
+#ifdef RT_USING_TIMER_WHEEL
+/* soft timer wheel */
+static struct rt_timer_wheel rt_soft_timer_wheel;
+#else
 /* soft timer list */
 static rt_list_t rt_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif
 static struct rt_thread timer_thread;
 ALIGN(RT_ALIGN_SIZE)
 static rt_uint8_t timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
@@ -104,6 +140,7 @@ static void _rt_timer_init(rt_timer_t timer,
     }
 }
 
+#ifndef RT_USING_TIMER_WHEEL
 /* the fist timer always in the last row */
 static rt_tick_t rt_timer_list_next_timeout(rt_list_t timer_list[])
 {
@@ -117,6 +154,7 @@ static rt_tick_t rt_timer_list_next_timeout(rt_list_t timer_list[])
 
     return timer->timeout_tick;
 }
+#endif
 
 rt_inline void _rt_timer_remove(rt_timer_t timer)
 {
@@ -128,7 +166,203 @@ rt_inline void _rt_timer_remove(rt_timer_t timer)
     }
 }
 
-#if RT_DEBUG_TIMER
+#ifdef RT_USING_TIMER_WHEEL
+static void _rt_timer_wheel_init(struct rt_timer_wheel *wheel)
+{
+    int level, index;
+
+    wheel->cur_tick = rt_tick_get();
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL; level++)
+    {
+        wheel->bitmap[level] = 0;
+        for (index = 0; index < RT_TIMER_WHEEL_SIZE; index++)
+        {
+            rt_list_init(&(wheel->slot[level][index]));
+        }
+    }
+}
+
+/* move all nodes of the src list to the tail of the dst list */
+rt_inline void _rt_timer_wheel_splice(rt_list_t *src, rt_list_t *dst)
+{
+    if (!rt_list_isempty(src))
+    {
+        src->next->prev = dst->prev;
+        dst->prev->next = src->next;
+        src->prev->next = dst;
+        dst->prev = src->prev;
+
+        rt_list_init(src);
+    }
+}
+
+/* the interrupt shall be disabled when invoking this function */
+static void _rt_timer_wheel_insert(struct rt_timer_wheel *wheel, rt_timer_t timer)
+{
+    rt_tick_t tick, delta;
+    int level, index;
+
+    tick  = timer->timeout_tick;
+    delta = tick - wheel->cur_tick;
+    if (delta >= RT_TICK_MAX / 2)
+    {
+        /* the timeout tick is passed, it will be handled on the next tick */
+        tick  = wheel->cur_tick;
+        delta = 0;
+    }
+
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL - 1; level++)
+    {
+        if ((delta >> (RT_TIMER_WHEEL_BITS * (level + 1))) == 0)
+            break;
+    }
+
+    index = (tick >> (RT_TIMER_WHEEL_BITS * level)) & RT_TIMER_WHEEL_MASK;
+    /* keep the timers with the same timeout tick in inserting order */
+    rt_list_insert_before(&(wheel->slot[level][index]), &(timer->row[0]));
+    wheel->bitmap[level] |= 1UL << index;
+}
+
+/*
+ * get the next tick which has timeout timers or has timers to be cascaded.
+ * The bitmap is cleaned up lazily here, so the interrupt shall be disabled
+ * when invoking this function.
+ */
+static rt_bool_t _rt_timer_wheel_next(struct rt_timer_wheel *wheel, rt_tick_t *next_tick)
+{
+    int level, index, start, offset;
+    rt_uint32_t bitmap, shift;
+    rt_tick_t base, tick, min_delta = RT_TICK_MAX;
+    rt_bool_t found = RT_FALSE;
+
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL; level++)
+    {
+        shift = RT_TIMER_WHEEL_BITS * level;
+        base  = wheel->cur_tick >> shift;
+        /* the current slot has been cascaded if the wheel is inside of it */
+        start = (wheel->cur_tick & ((1UL << shift) - 1)) ? 1 : 0;
+
+        while (wheel->bitmap[level])
+        {
+            index  = (base + start) & RT_TIMER_WHEEL_MASK;
+            bitmap = wheel->bitmap[level];
+            if (index)
+            {
+                bitmap = ((bitmap >> index) | (bitmap << (RT_TIMER_WHEEL_SIZE - index)))
+                         & RT_TIMER_WHEEL_FULL;
+            }
+            offset = __rt_ffs(bitmap) - 1;
+            index  = (index + offset) & RT_TIMER_WHEEL_MASK;
+
+            if (rt_list_isempty(&(wheel->slot[level][index])))
+            {
+                /* all timers of this slot have been removed */
+                wheel->bitmap[level] &= ~(1UL << index);
+                continue;
+            }
+
+            tick = (base + start + offset) << shift;
+            if (tick - wheel->cur_tick < min_delta)
+            {
+                min_delta  = tick - wheel->cur_tick;
+                *next_tick = tick;
+                found = RT_TRUE;
+            }
+            break;
+        }
+    }
+
+    return found;
+}
+
+/*
+ * process the current tick of wheel: cascade the timers in higher levels and
+ * move the timeout timers to the expired list.
+ */
+static void _rt_timer_wheel_step(struct rt_timer_wheel *wheel, rt_list_t *expired)
+{
+    rt_list_t cascade;
+    rt_tick_t tick;
+    rt_uint32_t shift;
+    int level, index;
+
+    tick = wheel->cur_tick;
+    for (level = 1; level < RT_TIMER_WHEEL_LEVEL; level++)
+    {
+        shift = RT_TIMER_WHEEL_BITS * level;
+        if (tick & ((1UL << shift) - 1))
+            break;
+
+        index = (tick >> shift) & RT_TIMER_WHEEL_MASK;
+        rt_list_init(&cascade);
+        _rt_timer_wheel_splice(&(wheel->slot[level][index]), &cascade);
+        wheel->bitmap[level] &= ~(1UL << index);
+
+        while (!rt_list_isempty(&cascade))
+        {
+            struct rt_timer *t;
+
+            t = rt_list_entry(cascade.next, struct rt_timer, row[0]);
+            rt_list_remove(&(t->row[0]));
+            _rt_timer_wheel_insert(wheel, t);
+        }
+    }
+
+    index = tick & RT_TIMER_WHEEL_MASK;
+    _rt_timer_wheel_splice(&(wheel->slot[0][index]), expired);
+    wheel->bitmap[0] &= ~(1UL << index);
+
+    /* the timers started in timeout function will be put after this tick */
+    wheel->cur_tick = tick + 1;
+}
+
+/*
+ * move the wheel forward to the next tick which has work to do, but not
+ * beyond the current tick. The interrupt shall be disabled when invoking
+ * this function.
+ *
+ * @return RT_TRUE if one tick has been processed and the wheel may have more
+ *         work to do.
+ */
+static rt_bool_t _rt_timer_wheel_advance(struct rt_timer_wheel *wheel,
+                                         rt_tick_t current_tick,
+                                         rt_list_t *expired)
+{
+    rt_tick_t next_tick;
+
+    if ((current_tick - wheel->cur_tick) >= RT_TICK_MAX / 2)
+        return RT_FALSE;
+
+    if (!_rt_timer_wheel_next(wheel, &next_tick) ||
+        (current_tick - next_tick) >= RT_TICK_MAX / 2)
+    {
+        /* no timer in the ticks before current tick */
+        wheel->cur_tick = current_tick + 1;
+        return RT_FALSE;
+    }
+
+    /* skip the empty ticks */
+    wheel->cur_tick = next_tick;
+    _rt_timer_wheel_step(wheel, expired);
+
+    return RT_TRUE;
+}
+
+static rt_tick_t _rt_timer_wheel_next_timeout(struct rt_timer_wheel *wheel)
+{
+    register rt_base_t level;
+    rt_tick_t next_tick;
+
+    level = rt_hw_interrupt_disable();
+    if (!_rt_timer_wheel_next(wheel, &next_tick))
+        next_tick = RT_TICK_MAX;
+    rt_hw_interrupt_enable(level);
+
+    return next_tick;
+}
+#endif
+
+#if RT_DEBUG_TIMER && !defined(RT_USING_TIMER_WHEEL)
 static int rt_timer_count_height(struct rt_timer *timer)
 {
     int i, cnt = 0;
@@ -295,12 +529,16 @@ RTM_EXPORT(rt_timer_delete);
  */
 rt_err_t rt_timer_start(rt_timer_t timer)
 {
+#ifndef RT_USING_TIMER_WHEEL
     unsigned int row_lvl;
     rt_list_t *timer_list;
-    register rt_base_t level;
     rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
     unsigned int tst_nr;
     static unsigned int random_nr;
+#else
+    struct rt_timer_wheel *timer_wheel;
+#endif
+    register rt_base_t level;
 
     /* timer check */
     RT_ASSERT(timer != RT_NULL);
@@ -326,6 +564,22 @@ rt_err_t rt_timer_start(rt_timer_t timer)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_TIMER_WHEEL
+#ifdef RT_USING_TIMER_SOFT
+    if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
+    {
+        /* insert timer to soft timer wheel */
+        timer_wheel = &rt_soft_timer_wheel;
+    }
+    else
+#endif
+    {
+        /* insert timer to system timer wheel */
+        timer_wheel = &rt_timer_wheel;
+    }
+
+    _rt_timer_wheel_insert(timer_wheel, timer);
+#else
 #ifdef RT_USING_TIMER_SOFT
     if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
     {
@@ -389,6 +643,7 @@ rt_err_t rt_timer_start(rt_timer_t timer)
          * bits. */
         tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
     }
+#endif
 
     timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
 
@@ -496,6 +751,9 @@ void rt_timer_check(void)
     struct rt_timer *t;
     rt_tick_t current_tick;
     register rt_base_t level;
+#ifdef RT_USING_TIMER_WHEEL
+    rt_list_t expired;
+#endif
 
     RT_DEBUG_LOG(RT_DEBUG_TIMER, ("timer check enter\n"));
 
@@ -504,6 +762,43 @@ void rt_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_TIMER_WHEEL
+    rt_list_init(&expired);
+    while (_rt_timer_wheel_advance(&rt_timer_wheel, current_tick, &expired))
+    {
+        while (!rt_list_isempty(&expired))
+        {
+            t = rt_list_entry(expired.next, struct rt_timer, row[0]);
+
+            RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+
+            /* remove timer from expired list firstly */
+            _rt_timer_remove(t);
+
+            /* call timeout function */
+            t->timeout_func(t->parameter);
+
+            /* re-get tick */
+            current_tick = rt_tick_get();
+
+            RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
+            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+
+            if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+                (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+            {
+                /* start it */
+                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+                rt_timer_start(t);
+            }
+            else
+            {
+                /* stop timer */
+                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            }
+        }
+    }
+#else
     while (!rt_list_isempty(&rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
     {
         t = rt_list_entry(rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
@@ -545,6 +840,7 @@ void rt_timer_check(void)
         else
             break;
     }
+#endif
 
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
@@ -559,7 +855,11 @@ void rt_timer_check(void)
  */
 rt_tick_t rt_timer_next_timeout_tick(void)
 {
+#ifdef RT_USING_TIMER_WHEEL
+    return _rt_timer_wheel_next_timeout(&rt_timer_wheel);
+#else
     return rt_timer_list_next_timeout(rt_timer_list);
+#endif
 }
 
 #ifdef RT_USING_TIMER_SOFT
@@ -570,8 +870,13 @@ rt_tick_t rt_timer_next_timeout_tick(void)
 void rt_soft_timer_check(void)
 {
     rt_tick_t current_tick;
-    rt_list_t *n;
     struct rt_timer *t;
+#ifdef RT_USING_TIMER_WHEEL
+    register rt_base_t level;
+    rt_list_t expired;
+#else
+    rt_list_t *n;
+#endif
 
     RT_DEBUG_LOG(RT_DEBUG_TIMER, ("software timer check enter\n"));
 
@@ -580,6 +885,54 @@ void rt_soft_timer_check(void)
     /* lock scheduler */
     rt_enter_critical();
 
+#ifdef RT_USING_TIMER_WHEEL
+    rt_list_init(&expired);
+
+    /* the soft timer can be started in interrupt, so protect the wheel */
+    level = rt_hw_interrupt_disable();
+    while (_rt_timer_wheel_advance(&rt_soft_timer_wheel, current_tick, &expired))
+    {
+        while (!rt_list_isempty(&expired))
+        {
+            t = rt_list_entry(expired.next, struct rt_timer, row[0]);
+
+            RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+
+            /* remove timer from expired list firstly */
+            _rt_timer_remove(t);
+
+            rt_hw_interrupt_enable(level);
+            /* not lock scheduler when performing timeout function */
+            rt_exit_critical();
+            /* call timeout function */
+            t->timeout_func(t->parameter);
+
+            /* re-get tick */
+            current_tick = rt_tick_get();
+
+            RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
+            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+
+            /* lock scheduler */
+            rt_enter_critical();
+            level = rt_hw_interrupt_disable();
+
+            if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+                (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+            {
+                /* start it */
+                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+                rt_timer_start(t);
+            }
+            else
+            {
+                /* stop timer */
+                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            }
+        }
+    }
+    rt_hw_interrupt_enable(level);
+#else
     for (n = rt_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next;
          n != &(rt_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]);)
     {
@@ -628,6 +981,7 @@ void rt_soft_timer_check(void)
         }
         else break; /* not check anymore */
     }
+#endif
 
     /* unlock scheduler */
     rt_exit_critical();
@@ -643,7 +997,11 @@ static void rt_thread_timer_entry(void *parameter)
     while (1)
     {
         /* get the next timeout tick */
+#ifdef RT_USING_TIMER_WHEEL
+        next_timeout = _rt_timer_wheel_next_timeout(&rt_soft_timer_wheel);
+#else
         next_timeout = rt_timer_list_next_timeout(rt_soft_timer_list);
+#endif
         if (next_timeout == RT_TICK_MAX)
         {
             /* no software timer exist, suspend self. */
@@ -678,12 +1036,16 @@ static void rt_thread_timer_entry(void *parameter)
  */
 void rt_system_timer_init(void)
 {
+#ifdef RT_USING_TIMER_WHEEL
+    _rt_timer_wheel_init(&rt_timer_wheel);
+#else
     int i;
 
     for (i = 0; i < sizeof(rt_timer_list) / sizeof(rt_timer_list[0]); i++)
     {
         rt_list_init(rt_timer_list + i);
     }
+#endif
 }
 
 /**
@@ -694,6 +1056,9 @@ void rt_system_timer_init(void)
 void rt_system_timer_thread_init(void)
 {
 #ifdef RT_USING_TIMER_SOFT
+#ifdef RT_USING_TIMER_WHEEL
+    _rt_timer_wheel_init(&rt_soft_timer_wheel);
+#else
     int i;
 
     for (i = 0;
@@ -702,6 +1067,7 @@ void rt_system_timer_thread_init(void)
     {
         rt_list_init(rt_soft_timer_list + i);
     }
+#endif
 
     /* start software timer thread */
     rt_thread_init(&timer_thread,
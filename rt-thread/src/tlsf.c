@@ -0,0 +1,653 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Two-Level Segregated Fit memory allocator.
+ *
+ * The free blocks are kept in segregated lists indexed by a first level
+ * (power of two) and a second level (linear subdivision of the first level)
+ * size class. Two levels of bitmaps are used to find a suitable free list, so
+ * both of allocation and release take constant time which is not related to
+ * the number of free blocks in heap.
+ *
+ * The algorithm is described in: M. Masmano, I. Ripoll, A. Crespo, and
+ * J. Real, "TLSF: a new dynamic memory allocator for real-time systems".
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#define RT_MEM_STATS
+
+#if defined (RT_USING_HEAP) && defined (RT_USING_TLSF)
+
+#ifdef RT_USING_MEMCACHE
+/* the heap works as the backend of the per-thread memory cache */
+#define rt_malloc           rt_heap_malloc
+#define rt_realloc          rt_heap_realloc
+#define rt_calloc           rt_heap_calloc
+#define rt_free             rt_heap_free
+/* the heap interfaces are exported in memcache.c */
+#undef  RTM_EXPORT
+#define RTM_EXPORT(symbol)
+#endif
+
+/* the log2 of second level free lists count for each first level */
+#ifndef RT_TLSF_SL_INDEX_LOG2
+#define RT_TLSF_SL_INDEX_LOG2   4
+#endif
+
+/* the log2 of the maximal block size can be managed */
+#ifndef RT_TLSF_FL_INDEX_MAX
+#define RT_TLSF_FL_INDEX_MAX    24
+#endif
+
+#define TLSF_SL_INDEX_COUNT     (1UL << RT_TLSF_SL_INDEX_LOG2)
+/* the blocks smaller than TLSF_SMALL_BLOCK_SIZE are put into the first level 0 */
+#define TLSF_FL_INDEX_SHIFT     (RT_TLSF_SL_INDEX_LOG2 + 3)
+#define TLSF_FL_INDEX_COUNT     (RT_TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 2)
+#define TLSF_SMALL_BLOCK_SIZE   (1UL << TLSF_FL_INDEX_SHIFT)
+
+#if (TLSF_FL_INDEX_COUNT > 31) || (RT_TLSF_SL_INDEX_LOG2 > 5)
+#error "the TLSF first level or second level index is too large"
+#endif
+
+#if RT_ALIGN_SIZE > (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT)
+#error "RT_ALIGN_SIZE is too large for the TLSF second level index"
+#endif
+
+#ifdef RT_USING_HOOK
+static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
+static void (*rt_free_hook)(void *ptr);
+
+/**
+ * @addtogroup Hook
+ */
+
+/**@{*/
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is allocated from heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
+{
+    rt_malloc_hook = hook;
+}
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is released to heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_free_sethook(void (*hook)(void *ptr))
+{
+    rt_free_hook = hook;
+}
+
+/**@}*/
+
+#endif
+
+#define TLSF_BLOCK_FREE         0x01UL
+#define TLSF_BLOCK_SIZE_MASK    (~(rt_size_t)(RT_ALIGN_SIZE - 1))
+
+struct tlsf_block
+{
+    /* block size including header, the lowest bit is the free flag */
+    rt_size_t size;
+    /* the previous block in physical address */
+    struct tlsf_block *prev_phys;
+
+    /* the free list node, only valid when the block is free */
+    struct tlsf_block *next_free;
+    struct tlsf_block *prev_free;
+};
+
+#define TLSF_BLOCK_HEADER_SIZE  RT_ALIGN(2 * sizeof(void *), RT_ALIGN_SIZE)
+#define TLSF_BLOCK_SIZE_MIN     RT_ALIGN(sizeof(struct tlsf_block), RT_ALIGN_SIZE)
+
+#define tlsf_block_size(block)  ((block)->size & TLSF_BLOCK_SIZE_MASK)
+#define tlsf_block_is_free(block)   ((block)->size & TLSF_BLOCK_FREE)
+#define tlsf_block_next(block)  \
+    ((struct tlsf_block *)((rt_uint8_t *)(block) + tlsf_block_size(block)))
+#define tlsf_block_to_ptr(block)    \
+    ((void *)((rt_uint8_t *)(block) + TLSF_BLOCK_HEADER_SIZE))
+#define tlsf_block_from_ptr(ptr)    \
+    ((struct tlsf_block *)((rt_uint8_t *)(ptr) - TLSF_BLOCK_HEADER_SIZE))
+
+static rt_uint32_t fl_bitmap;
+static rt_uint32_t sl_bitmap[TLSF_FL_INDEX_COUNT];
+static struct tlsf_block *free_blocks[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+static rt_uint8_t *heap_ptr;
+/* the last block, always used */
+static struct tlsf_block *heap_end;
+
+static struct rt_semaphore heap_sem;
+static rt_size_t mem_size_aligned;
+
+#ifdef RT_MEM_STATS
+static rt_size_t used_mem, max_mem;
+#endif
+
+/* find the last (most significant) bit set, the word shall not be zero */
+rt_inline int tlsf_fls(rt_size_t word)
+{
+    int bit = 0;
+
+#ifdef ARCH_CPU_64BIT
+    if (word & 0xffffffff00000000UL) { word >>= 32; bit += 32; }
+#endif
+    if (word & 0xffff0000) { word >>= 16; bit += 16; }
+    if (word & 0xff00) { word >>= 8; bit += 8; }
+    if (word & 0xf0) { word >>= 4; bit += 4; }
+    if (word & 0xc) { word >>= 2; bit += 2; }
+    if (word & 0x2) { bit += 1; }
+
+    return bit;
+}
+
+/* get the free list index of a block size */
+static void tlsf_mapping_insert(rt_size_t size, int *fl, int *sl)
+{
+    int f, s;
+
+    if (size < TLSF_SMALL_BLOCK_SIZE)
+    {
+        f = 0;
+        s = size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+    }
+    else
+    {
+        f = tlsf_fls(size);
+        s = (size >> (f - RT_TLSF_SL_INDEX_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+        f -= TLSF_FL_INDEX_SHIFT - 1;
+    }
+
+    *fl = f;
+    *sl = s;
+}
+
+/* get the free list index from which all blocks are large enough */
+static void tlsf_mapping_search(rt_size_t size, int *fl, int *sl)
+{
+    if (size >= TLSF_SMALL_BLOCK_SIZE)
+    {
+        size += (1UL << (tlsf_fls(size) - RT_TLSF_SL_INDEX_LOG2)) - 1;
+    }
+    else
+    {
+        size = RT_ALIGN(size, TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+    }
+
+    tlsf_mapping_insert(size, fl, sl);
+}
+
+static struct tlsf_block *tlsf_search_suitable_block(int *fl, int *sl)
+{
+    rt_uint32_t sl_map, fl_map;
+
+    if (*fl >= TLSF_FL_INDEX_COUNT)
+        return RT_NULL;
+
+    /* search in the same first level firstly */
+    sl_map = sl_bitmap[*fl] & (~0UL << *sl);
+    if (!sl_map)
+    {
+        /* then search in a larger first level */
+        fl_map = fl_bitmap & (~0UL << (*fl + 1));
+        if (!fl_map)
+            return RT_NULL;
+
+        *fl = __rt_ffs(fl_map) - 1;
+        sl_map = sl_bitmap[*fl];
+    }
+    *sl = __rt_ffs(sl_map) - 1;
+
+    return free_blocks[*fl][*sl];
+}
+
+static void tlsf_insert_free_block(struct tlsf_block *block)
+{
+    int fl, sl;
+    struct tlsf_block *head;
+
+    tlsf_mapping_insert(tlsf_block_size(block), &fl, &sl);
+    RT_ASSERT(fl < TLSF_FL_INDEX_COUNT);
+
+    head = free_blocks[fl][sl];
+    block->next_free = head;
+    block->prev_free = RT_NULL;
+    if (head != RT_NULL)
+        head->prev_free = block;
+    free_blocks[fl][sl] = block;
+
+    fl_bitmap |= 1UL << fl;
+    sl_bitmap[fl] |= 1UL << sl;
+}
+
+static void tlsf_remove_free_block(struct tlsf_block *block)
+{
+    int fl, sl;
+
+    tlsf_mapping_insert(tlsf_block_size(block), &fl, &sl);
+
+    if (block->prev_free != RT_NULL)
+        block->prev_free->next_free = block->next_free;
+    else
+        free_blocks[fl][sl] = block->next_free;
+    if (block->next_free != RT_NULL)
+        block->next_free->prev_free = block->prev_free;
+
+    if (free_blocks[fl][sl] == RT_NULL)
+    {
+        sl_bitmap[fl] &= ~(1UL << sl);
+        if (sl_bitmap[fl] == 0)
+            fl_bitmap &= ~(1UL << fl);
+    }
+}
+
+/* split the tail of block as a new free block if it's large enough */
+static void tlsf_split_block(struct tlsf_block *block, rt_size_t size)
+{
+    struct tlsf_block *remain, *next;
+    rt_size_t block_size;
+
+    block_size = tlsf_block_size(block);
+    if (block_size - size < TLSF_BLOCK_SIZE_MIN)
+        return;
+
+    remain = (struct tlsf_block *)((rt_uint8_t *)block + size);
+    remain->size = (block_size - size) | TLSF_BLOCK_FREE;
+    remain->prev_phys = block;
+    block->size = size | (block->size & TLSF_BLOCK_FREE);
+
+    next = tlsf_block_next(remain);
+    next->prev_phys = remain;
+    /* never leave two adjacent free blocks */
+    if (tlsf_block_is_free(next))
+    {
+        tlsf_remove_free_block(next);
+        remain->size += tlsf_block_size(next);
+        tlsf_block_next(remain)->prev_phys = remain;
+    }
+
+    tlsf_insert_free_block(remain);
+}
+
+/* merge the free block with its free neighbours */
+static struct tlsf_block *tlsf_merge_block(struct tlsf_block *block)
+{
+    struct tlsf_block *prev, *next;
+
+    next = tlsf_block_next(block);
+    if (tlsf_block_is_free(next))
+    {
+        tlsf_remove_free_block(next);
+        block->size += tlsf_block_size(next);
+        tlsf_block_next(block)->prev_phys = block;
+    }
+
+    prev = block->prev_phys;
+    if (prev != RT_NULL && tlsf_block_is_free(prev))
+    {
+        tlsf_remove_free_block(prev);
+        prev->size += tlsf_block_size(block);
+        tlsf_block_next(prev)->prev_phys = prev;
+        block = prev;
+    }
+
+    return block;
+}
+
+/* get the block size for the request size */
+rt_inline rt_size_t tlsf_adjust_size(rt_size_t size)
+{
+    size = RT_ALIGN(size, RT_ALIGN_SIZE) + TLSF_BLOCK_HEADER_SIZE;
+    if (size < TLSF_BLOCK_SIZE_MIN)
+        size = TLSF_BLOCK_SIZE_MIN;
+
+    return size;
+}
+
+/**
+ * @ingroup SystemInit
+ *
+ * This function will initialize system heap memory.
+ *
+ * @param begin_addr the beginning address of system heap memory.
+ * @param end_addr the end address of system heap memory.
+ */
+void rt_system_heap_init(void *begin_addr, void *end_addr)
+{
+    struct tlsf_block *block;
+    rt_ubase_t begin_align = RT_ALIGN((rt_ubase_t)begin_addr, RT_ALIGN_SIZE);
+    rt_ubase_t end_align   = RT_ALIGN_DOWN((rt_ubase_t)end_addr, RT_ALIGN_SIZE);
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* alignment addr */
+    if ((end_align > (TLSF_BLOCK_HEADER_SIZE + TLSF_BLOCK_SIZE_MIN)) &&
+        ((end_align - TLSF_BLOCK_HEADER_SIZE - TLSF_BLOCK_SIZE_MIN) >= begin_align))
+    {
+        /* calculate the aligned memory size */
+        mem_size_aligned = end_align - begin_align - TLSF_BLOCK_HEADER_SIZE;
+    }
+    else
+    {
+        rt_kprintf("mem init, error begin address 0x%x, and end address 0x%x\n",
+                   (rt_ubase_t)begin_addr, (rt_ubase_t)end_addr);
+
+        return;
+    }
+
+    if (mem_size_aligned >= (1UL << RT_TLSF_FL_INDEX_MAX) * 2)
+    {
+        rt_kprintf("mem init, heap size %d is larger than TLSF can manage\n",
+                   mem_size_aligned);
+        mem_size_aligned = RT_ALIGN_DOWN((1UL << RT_TLSF_FL_INDEX_MAX) * 2 - 1, RT_ALIGN_SIZE);
+    }
+
+    /* point to begin address of heap */
+    heap_ptr = (rt_uint8_t *)begin_align;
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("mem init, heap begin address 0x%x, size %d\n",
+                                (rt_ubase_t)heap_ptr, mem_size_aligned));
+
+    /* initialize the only free block */
+    block = (struct tlsf_block *)heap_ptr;
+    block->size = mem_size_aligned | TLSF_BLOCK_FREE;
+    block->prev_phys = RT_NULL;
+
+    /* initialize the end of the heap, which has no payload */
+    heap_end = tlsf_block_next(block);
+    heap_end->size = 0;
+    heap_end->prev_phys = block;
+
+    rt_sem_init(&heap_sem, "heap", 1, RT_IPC_FLAG_FIFO);
+
+    tlsf_insert_free_block(block);
+}
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_malloc(rt_size_t size)
+{
+    struct tlsf_block *block;
+    int fl, sl;
+
+    if (size == 0)
+        return RT_NULL;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    if (size > mem_size_aligned)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("no memory\n"));
+
+        return RT_NULL;
+    }
+
+    size = tlsf_adjust_size(size);
+    tlsf_mapping_search(size, &fl, &sl);
+
+    /* take memory semaphore */
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    block = tlsf_search_suitable_block(&fl, &sl);
+    if (block == RT_NULL)
+    {
+        rt_sem_release(&heap_sem);
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("no memory\n"));
+
+        return RT_NULL;
+    }
+
+    RT_ASSERT(tlsf_block_size(block) >= size);
+
+    tlsf_remove_free_block(block);
+    tlsf_split_block(block, size);
+    block->size &= ~TLSF_BLOCK_FREE;
+
+#ifdef RT_MEM_STATS
+    used_mem += tlsf_block_size(block);
+    if (max_mem < used_mem)
+        max_mem = used_mem;
+#endif
+
+    rt_sem_release(&heap_sem);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM,
+                 ("allocate memory at 0x%x, size: %d\n",
+                  (rt_ubase_t)tlsf_block_to_ptr(block),
+                  (rt_ubase_t)tlsf_block_size(block)));
+
+    RT_OBJECT_HOOK_CALL(rt_malloc_hook,
+                        (tlsf_block_to_ptr(block), size - TLSF_BLOCK_HEADER_SIZE));
+
+    return tlsf_block_to_ptr(block);
+}
+RTM_EXPORT(rt_malloc);
+
+/**
+ * This function will change the previously allocated memory block.
+ *
+ * @param rmem pointer to memory allocated by rt_malloc
+ * @param newsize the required new size
+ *
+ * @return the changed memory block address
+ */
+void *rt_realloc(void *rmem, rt_size_t newsize)
+{
+    struct tlsf_block *block, *next;
+    rt_size_t size, block_size;
+    void *nmem;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    if (newsize > mem_size_aligned)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("realloc: out of memory\n"));
+
+        return RT_NULL;
+    }
+    else if (newsize == 0)
+    {
+        rt_free(rmem);
+        return RT_NULL;
+    }
+
+    /* allocate a new memory block */
+    if (rmem == RT_NULL)
+        return rt_malloc(newsize);
+
+    if ((rt_uint8_t *)rmem < heap_ptr ||
+        (rt_uint8_t *)rmem >= (rt_uint8_t *)heap_end)
+    {
+        /* illegal memory */
+        return rmem;
+    }
+
+    block = tlsf_block_from_ptr(rmem);
+    size  = tlsf_adjust_size(newsize);
+
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    RT_ASSERT(!tlsf_block_is_free(block));
+
+    block_size = tlsf_block_size(block);
+    next = tlsf_block_next(block);
+    if (size > block_size && tlsf_block_is_free(next) &&
+        block_size + tlsf_block_size(next) >= size)
+    {
+        /* expand into the next free block */
+        tlsf_remove_free_block(next);
+        block->size += tlsf_block_size(next);
+        tlsf_block_next(block)->prev_phys = block;
+    }
+
+    if (tlsf_block_size(block) >= size)
+    {
+        /* shrink or expanded in place, give back the unused tail */
+        tlsf_split_block(block, size);
+
+#ifdef RT_MEM_STATS
+        used_mem = used_mem - block_size + tlsf_block_size(block);
+        if (max_mem < used_mem)
+            max_mem = used_mem;
+#endif
+        rt_sem_release(&heap_sem);
+
+        return rmem;
+    }
+    rt_sem_release(&heap_sem);
+
+    /* move to a new memory block */
+    nmem = rt_malloc(newsize);
+    if (nmem != RT_NULL) /* check memory */
+    {
+        rt_memcpy(nmem, rmem, block_size - TLSF_BLOCK_HEADER_SIZE);
+        rt_free(rmem);
+    }
+
+    return nmem;
+}
+RTM_EXPORT(rt_realloc);
+
+/**
+ * This function will contiguously allocate enough space for count objects
+ * that are size bytes of memory each and returns a pointer to the allocated
+ * memory.
+ *
+ * The allocated memory is filled with bytes of value zero.
+ *
+ * @param count number of objects to allocate
+ * @param size size of the objects to allocate
+ *
+ * @return pointer to allocated memory / NULL pointer if there is an error
+ */
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    void *p;
+
+    /* allocate 'count' objects of size 'size' */
+    p = rt_malloc(count * size);
+
+    /* zero the memory */
+    if (p)
+        rt_memset(p, 0, count * size);
+
+    return p;
+}
+RTM_EXPORT(rt_calloc);
+
+/**
+ * This function will release the previously allocated memory block by
+ * rt_malloc. The released memory block is taken back to system heap.
+ *
+ * @param rmem the address of memory which will be released
+ */
+void rt_free(void *rmem)
+{
+    struct tlsf_block *block;
+
+    if (rmem == RT_NULL)
+        return;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    RT_ASSERT((((rt_ubase_t)rmem) & (RT_ALIGN_SIZE - 1)) == 0);
+    RT_ASSERT((rt_uint8_t *)rmem >= heap_ptr &&
+              (rt_uint8_t *)rmem < (rt_uint8_t *)heap_end);
+
+    RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
+
+    if ((rt_uint8_t *)rmem < heap_ptr ||
+        (rt_uint8_t *)rmem >= (rt_uint8_t *)heap_end)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("illegal memory\n"));
+
+        return;
+    }
+
+    block = tlsf_block_from_ptr(rmem);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM,
+                 ("release memory 0x%x, size: %d\n",
+                  (rt_ubase_t)rmem, (rt_ubase_t)tlsf_block_size(block)));
+
+    /* protect the heap from concurrent access */
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    if (tlsf_block_is_free(block) || tlsf_block_next(block)->prev_phys != block)
+    {
+        rt_kprintf("to free a bad data block:\n");
+        rt_kprintf("mem: 0x%08x, size: 0x%08x\n", block, block->size);
+    }
+    RT_ASSERT(!tlsf_block_is_free(block));
+    RT_ASSERT(tlsf_block_next(block)->prev_phys == block);
+
+#ifdef RT_MEM_STATS
+    used_mem -= tlsf_block_size(block);
+#endif
+
+    block->size |= TLSF_BLOCK_FREE;
+    block = tlsf_merge_block(block);
+    tlsf_insert_free_block(block);
+
+    rt_sem_release(&heap_sem);
+}
+RTM_EXPORT(rt_free);
+
+#ifdef RT_MEM_STATS
+void rt_memory_info(rt_uint32_t *total,
+                    rt_uint32_t *used,
+                    rt_uint32_t *max_used)
+{
+    if (total != RT_NULL)
+        *total = mem_size_aligned;
+    if (used  != RT_NULL)
+        *used = used_mem;
+    if (max_used != RT_NULL)
+        *max_used = max_mem;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+void list_mem(void)
+{
+    rt_kprintf("total memory: %d\n", mem_size_aligned);
+    rt_kprintf("used memory : %d\n", used_mem);
+    rt_kprintf("maximum allocated memory: %d\n", max_mem);
+}
+FINSH_FUNCTION_EXPORT(list_mem, list memory usage information)
+#endif /* end of RT_USING_FINSH */
+
+#endif
+
+/**@}*/
+
+#endif /* end of RT_USING_HEAP && RT_USING_TLSF */
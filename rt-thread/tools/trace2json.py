@@ -0,0 +1,261 @@
+#!/usr/bin/env python
+#
+# File      : trace2json.py
+# This file is part of RT-Thread RTOS
+# COPYRIGHT (C) 2006 - 2018, RT-Thread Development Team
+#
+#  This program is free software; you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation; either version 2 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License along
+#  with this program; if not, write to the Free Software Foundation, Inc.,
+#  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-17     RT-Thread    first version
+# 2026-10-17     RT-Thread    fix the object classes and the padding of names
+# 2026-10-17     RT-Thread    read the pointers of the size in header
+#
+# Convert the records of trace recorder (components/utilities/trace) to the
+# Chrome trace JSON, which can be opened by chrome://tracing or Perfetto UI.
+#
+# The input is the binary data exported by trace_export(), or the console log
+# which contains the output of `trace dump`.
+
+import sys
+import struct
+import json
+import argparse
+
+TRACE_MAGIC = 0x52545452
+
+EVENT_SWITCH        = 1
+EVENT_IRQ_ENTER     = 2
+EVENT_IRQ_LEAVE     = 3
+EVENT_OBJ_TRYTAKE   = 4
+EVENT_OBJ_TAKE      = 5
+EVENT_OBJ_PUT       = 6
+EVENT_SUSPEND       = 7
+EVENT_RESUME        = 8
+EVENT_TIMER_ENTER   = 9
+EVENT_TIMER_EXIT    = 10
+EVENT_MALLOC        = 11
+EVENT_FREE          = 12
+EVENT_USER          = 13
+
+# enum rt_object_class_type in rtdef.h
+OBJECT_CLASSES = {
+    1: 'thread', 2: 'sem', 3: 'mutex', 4: 'event', 5: 'mailbox',
+    6: 'mq', 7: 'memheap', 8: 'mempool', 9: 'device', 10: 'timer', 11: 'module'
+}
+
+# the pseudo thread identifiers of tracks
+TID_ISR     = 1
+TID_TIMER   = 2
+TID_HEAP    = 3
+
+HEADER_FORMAT = 'IHHIIIHHI'
+
+# the format of pointer by its size
+POINTER_FORMATS = {4: 'I', 8: 'Q'}
+
+def parse_log(text):
+    '''Get the binary data between the markers of `trace dump` in console log.'''
+    lines = []
+    inside = False
+    for line in text.splitlines():
+        line = line.strip()
+        if line.endswith('-----BEGIN TRACE-----'):
+            lines = []
+            inside = True
+        elif line.endswith('-----END TRACE-----'):
+            inside = False
+        elif inside:
+            lines.append(line)
+
+    if not lines:
+        raise ValueError('no trace dump found')
+
+    return bytearray.fromhex(''.join(lines))
+
+def parse_dump(data):
+    data = bytes(data)
+    for order in ('<', '>'):
+        header = struct.unpack_from(order + HEADER_FORMAT, data, 0)
+        if header[0] == TRACE_MAGIC:
+            break
+    else:
+        raise ValueError('bad magic of trace data')
+
+    magic, version, event_size, frequency, event_num, name_num, name_size, ptr_size, lost = header
+    if version < 2:
+        # the pointers are truncated to 32 bits, and name_size is 32 bits
+        if order == '<':
+            name_size |= ptr_size << 16
+        else:
+            name_size = (name_size << 16) | ptr_size
+        ptr_size = 4
+    if ptr_size not in POINTER_FORMATS:
+        raise ValueError('bad pointer size of trace data: %d' % ptr_size)
+    offset = struct.calcsize(HEADER_FORMAT)
+
+    pointer = POINTER_FORMATS[ptr_size]
+    event_format = order + 'IBBH' + pointer + pointer
+    events = []
+    for index in range(event_num):
+        events.append(struct.unpack_from(event_format, data, offset))
+        offset += event_size
+
+    # struct trace_name is padded to the alignment of its pointer field
+    name_offset = ptr_size + 4
+    name_record_size = (name_offset + name_size + ptr_size - 1) & ~(ptr_size - 1)
+
+    names = {}
+    for index in range(name_num):
+        obj, obj_type = struct.unpack_from(order + pointer + 'B', data, offset)
+        name = data[offset + name_offset:offset + name_offset + name_size].split(b'\0')[0].decode('ascii', 'replace')
+        names[obj] = (OBJECT_CLASSES.get(obj_type, 'object'), name)
+        offset += name_record_size
+
+    return frequency, lost, events, names
+
+class Converter(object):
+    def __init__(self, frequency, names):
+        self.frequency = frequency
+        self.names = names
+        self.output = []
+        self.threads = {}
+        self.running = {}       # cpu -> (thread, start)
+        self.irq_start = {}     # cpu -> start
+        self.timers = {}        # (cpu, timer) -> start
+
+    def name(self, obj):
+        if obj in self.names:
+            return self.names[obj][1]
+        return '0x%08x' % obj
+
+    def thread(self, cpu, thread):
+        if thread not in self.threads:
+            self.threads[thread] = True
+            self.output.append({'ph': 'M', 'name': 'thread_name', 'pid': cpu,
+                                'tid': thread, 'args': {'name': self.name(thread)}})
+        return thread
+
+    def slice(self, cpu, tid, name, start, end, args=None):
+        event = {'ph': 'X', 'name': name, 'pid': cpu, 'tid': tid,
+                 'ts': start, 'dur': end - start}
+        if args:
+            event['args'] = args
+        self.output.append(event)
+
+    def instant(self, cpu, tid, name, ts, args=None):
+        event = {'ph': 'i', 's': 't', 'name': name, 'pid': cpu, 'tid': tid, 'ts': ts}
+        if args:
+            event['args'] = args
+        self.output.append(event)
+
+    def current(self, cpu):
+        if cpu in self.running:
+            return self.running[cpu][0]
+        return None
+
+    def convert(self, events):
+        timestamp = None
+        ts = 0
+        cpus = set()
+
+        for stamp, type, cpu, data, arg0, arg1 in events:
+            # the timestamp is 32 bits counter, unwrap it
+            if timestamp is None:
+                timestamp = stamp
+            ts += ((stamp - timestamp) & 0xffffffff) * 1000000.0 / self.frequency
+            timestamp = stamp
+
+            if cpu not in cpus:
+                cpus.add(cpu)
+                self.output.append({'ph': 'M', 'name': 'process_name', 'pid': cpu,
+                                    'args': {'name': 'CPU%d' % cpu}})
+                for tid, name in ((TID_ISR, '(isr)'), (TID_TIMER, '(timer)'), (TID_HEAP, '(heap)')):
+                    self.output.append({'ph': 'M', 'name': 'thread_name', 'pid': cpu,
+                                        'tid': tid, 'args': {'name': name}})
+
+            if type == EVENT_SWITCH:
+                if cpu in self.running:
+                    thread, start = self.running[cpu]
+                    self.slice(cpu, self.thread(cpu, thread), self.name(thread), start, ts)
+                elif arg0:
+                    # the thread has been running before the first switch
+                    self.slice(cpu, self.thread(cpu, arg0), self.name(arg0), 0, ts)
+                self.running[cpu] = (arg1, ts)
+            elif type == EVENT_IRQ_ENTER:
+                if data == 1:
+                    self.irq_start[cpu] = ts
+            elif type == EVENT_IRQ_LEAVE:
+                if data == 0 and cpu in self.irq_start:
+                    self.slice(cpu, TID_ISR, 'isr', self.irq_start.pop(cpu), ts)
+            elif type in (EVENT_OBJ_TRYTAKE, EVENT_OBJ_TAKE, EVENT_OBJ_PUT):
+                action = {EVENT_OBJ_TRYTAKE: 'trytake', EVENT_OBJ_TAKE: 'take',
+                          EVENT_OBJ_PUT: 'put'}[type]
+                self.instant(cpu, self.thread(cpu, arg1),
+                             '%s %s %s' % (action, OBJECT_CLASSES.get(data, 'object'), self.name(arg0)),
+                             ts, {'object': '0x%08x' % arg0})
+            elif type in (EVENT_SUSPEND, EVENT_RESUME):
+                action = 'suspend' if type == EVENT_SUSPEND else 'resume'
+                self.instant(cpu, self.thread(cpu, arg0), action, ts, {'by': self.name(arg1)})
+            elif type == EVENT_TIMER_ENTER:
+                self.timers[(cpu, arg0)] = ts
+            elif type == EVENT_TIMER_EXIT:
+                if (cpu, arg0) in self.timers:
+                    self.slice(cpu, TID_TIMER, self.name(arg0), self.timers.pop((cpu, arg0)), ts,
+                               {'function': '0x%08x' % arg1})
+            elif type == EVENT_MALLOC:
+                thread = self.current(cpu)
+                self.instant(cpu, TID_HEAP, 'malloc %d' % arg1, ts,
+                             {'ptr': '0x%08x' % arg0, 'thread': self.name(thread) if thread else None})
+            elif type == EVENT_FREE:
+                thread = self.current(cpu)
+                self.instant(cpu, TID_HEAP, 'free', ts,
+                             {'ptr': '0x%08x' % arg0, 'thread': self.name(thread) if thread else None})
+            elif type == EVENT_USER:
+                self.instant(cpu, self.thread(cpu, arg1), 'user %d' % data, ts,
+                             {'value': arg0})
+
+        # close the running threads at the end of trace
+        for cpu, (thread, start) in self.running.items():
+            self.slice(cpu, self.thread(cpu, thread), self.name(thread), start, ts)
+
+        return self.output
+
+def main():
+    parser = argparse.ArgumentParser(description='convert RT-Thread trace to Chrome trace JSON')
+    parser.add_argument('input', type=str, help='binary trace data or console log of `trace dump`')
+    parser.add_argument('output', type=str, nargs='?', help='output JSON file, default to stdout')
+    args = parser.parse_args()
+
+    data = open(args.input, 'rb').read()
+    if struct.unpack_from('<I', data, 0)[0] != TRACE_MAGIC and \
+       struct.unpack_from('>I', data, 0)[0] != TRACE_MAGIC:
+        data = parse_log(data.decode('ascii', 'replace'))
+
+    frequency, lost, events, names = parse_dump(data)
+    sys.stderr.write('%d events, %d objects, %d lost, %d Hz\n' %
+                     (len(events), len(names), lost, frequency))
+
+    output = Converter(frequency, names).convert(events)
+    text = json.dumps({'traceEvents': output, 'displayTimeUnit': 'ns'}, indent=1)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+if __name__ == '__main__':
+    main()